@@ -0,0 +1,67 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+// converts the nineA_baseline cluster tables to the binary form NineATable maps, see NineATable.hh
+//  nineA_make_binary_tables -nineA:cluster_path <same as -rif_dock:nineA_cluster_path>
+
+#include <basic/options/option_macros.hh>
+#include <devel/init.hh>
+
+#include <riflib/scaffold/NineATable.hh>
+
+#include <iostream>
+
+
+OPT_1GRP_KEY( String      , nineA, cluster_path )
+OPT_1GRP_KEY( Boolean     , nineA, check )
+
+	void REGISTER_OPTIONS() {
+		using namespace basic::options;
+		using namespace basic::options::OptionKeys;
+		NEW_OPT( nineA::cluster_path, "directory holding the kcenters_stats_al1.dat* tables", "" );
+		NEW_OPT( nineA::check, "reopen each binary table and compare it to the text one", true );
+	}
+
+
+int main(int argc, char *argv[])
+{
+	using namespace basic::options;
+	using namespace ::devel::scheme;
+
+	REGISTER_OPTIONS();
+	devel::init(argc,argv);
+
+	std::string const path = option[ OptionKeys::nineA::cluster_path ]();
+	if ( path == "" ) utility_exit_with_message( "nineA_make_binary_tables: -nineA:cluster_path is required" );
+
+	for ( std::string const & name : CLUSTER_DATA_NAMES ) {
+		std::string const fname = path + "/kcenters_stats_al1.dat" + name;
+
+		NineATable text;
+		text.read_text( fname );
+		if ( ! text.write_binary( fname ) ) {
+			utility_exit_with_message( "nineA_make_binary_tables: failed to write binary tables for " + fname );
+		}
+		std::cout << "wrote " << text.size() << " clusters to " << NineATable::rows_fname( fname ) << std::endl;
+
+		if ( ! option[ OptionKeys::nineA::check ]() ) continue;
+
+		NineATable binary;
+		runtime_assert_msg( binary.open_binary( fname ), "can't reopen binary tables for " + fname );
+		runtime_assert( binary.size() == text.size() );
+		for ( uint64_t clust = 1; clust <= text.size(); clust++ ) {
+			StatRow a = text.stat_row( clust ), b = binary.stat_row( clust );
+			runtime_assert_msg( a.int_fields == b.int_fields && a.float_fields == b.float_fields && a.filename == b.filename,
+				"binary table differs from text at cluster " + utility::to_string( clust ) + " of " + fname );
+			runtime_assert( text.children_of( clust ) == binary.children_of( clust ) );
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <riflib/RifBatchScorer.hh>
+
+using ::devel::scheme::RifBatchScorer;
+using ::devel::scheme::RifBatchScorerOpts;
+
+namespace py = pybind11;
+
+typedef py::array_t< double , py::array::c_style | py::array::forcecast > DoubleArray;
+typedef py::array_t< int32_t, py::array::c_style | py::array::forcecast > IntArray;
+
+// numpy arrays in and out, the scoring itself runs in RifBatchScorer without the GIL
+
+static void check_shape( py::buffer_info const & info, std::vector<size_t> const & tail, std::string const & what ) {
+	bool ok = (size_t)info.ndim == tail.size() + 1;
+	for( size_t i = 0; ok && i < tail.size(); ++i ) ok = (size_t)info.shape[i+1] == tail[i];
+	if( !ok ) throw std::runtime_error( what + " has the wrong shape" );
+}
+
+static void set_scaffold( RifBatchScorer & self, DoubleArray frames, DoubleArray atom_xyz, IntArray atom_types ) {
+	py::buffer_info f = frames.request(), x = atom_xyz.request(), t = atom_types.request();
+	check_shape( f, {4,4}, "frames" );
+	check_shape( x, {3}, "atom_xyz" );
+	check_shape( t, {}, "atom_types" );
+	if( x.shape[0] != t.shape[0] ) throw std::runtime_error( "atom_xyz and atom_types differ in length" );
+	self.set_scaffold( (double const*)f.ptr, f.shape[0], (double const*)x.ptr, (int32_t const*)t.ptr, x.shape[0] );
+}
+
+static py::dict score( RifBatchScorer const & self, DoubleArray xforms, bool rotamer_hits ) {
+	py::buffer_info x = xforms.request();
+	check_shape( x, {4,4}, "xforms" );
+	size_t const n = x.shape[0], nres = self.nres();
+
+	py::array_t<float> rif_score( std::vector<size_t>{ n } );
+	py::array_t<float> clash_score( std::vector<size_t>{ n } );
+	py::array_t<int32_t> hit_rot( rotamer_hits ? std::vector<size_t>{ n, nres } : std::vector<size_t>{ 0, 0 } );
+	py::array_t<float> hit_score( rotamer_hits ? std::vector<size_t>{ n, nres } : std::vector<size_t>{ 0, 0 } );
+
+	double const * xforms_ptr = (double const*)x.ptr;
+	float * rif_ptr = (float*)rif_score.request().ptr;
+	float * clash_ptr = (float*)clash_score.request().ptr;
+	int32_t * hit_rot_ptr = rotamer_hits ? (int32_t*)hit_rot.request().ptr : nullptr;
+	float * hit_score_ptr = rotamer_hits ? (float*)hit_score.request().ptr : nullptr;
+	{
+		py::gil_scoped_release release;
+		self.score( xforms_ptr, n, rif_ptr, clash_ptr, hit_rot_ptr, hit_score_ptr );
+	}
+
+	py::dict out;
+	out["rif_score"] = rif_score;
+	out["clash_score"] = clash_score;
+	if( rotamer_hits ){
+		out["hit_rot"] = hit_rot;
+		out["hit_score"] = hit_score;
+	}
+	return out;
+}
+
+static py::array_t<double> bb_frames_from_n_ca_c( DoubleArray n, DoubleArray ca, DoubleArray c ) {
+	py::buffer_info bn = n.request(), bca = ca.request(), bc = c.request();
+	check_shape( bn, {3}, "n" );
+	check_shape( bca, {3}, "ca" );
+	check_shape( bc, {3}, "c" );
+	if( bn.shape[0] != bca.shape[0] || bn.shape[0] != bc.shape[0] ) throw std::runtime_error( "n, ca and c differ in length" );
+	py::array_t<double> out( std::vector<size_t>{ (size_t)bn.shape[0], 4, 4 } );
+	RifBatchScorer::bb_frames_from_n_ca_c( (double const*)bn.ptr, (double const*)bca.ptr, (double const*)bc.ptr,
+	                                        bn.shape[0], (double*)out.request().ptr );
+	return out;
+}
+
+PYBIND11_PLUGIN(_pysetta_rif) {
+	py::module m("_pysetta_rif", "batch RIF scoring");
+
+	py::class_< RifBatchScorerOpts >(m, "RifBatchScorerOpts")
+		.def( py::init<>() )
+		.def_readwrite( "rif_type", &RifBatchScorerOpts::rif_type )
+		.def_readwrite( "rif_file", &RifBatchScorerOpts::rif_file )
+		.def_readwrite( "target_pdb", &RifBatchScorerOpts::target_pdb )
+		.def_readwrite( "target_res_fname", &RifBatchScorerOpts::target_res_fname )
+		.def_readwrite( "target_rf_cache", &RifBatchScorerOpts::target_rf_cache )
+		.def_readwrite( "target_rf_resl", &RifBatchScorerOpts::target_rf_resl )
+		.def_readwrite( "target_rf_oversample", &RifBatchScorerOpts::target_rf_oversample )
+		.def_readwrite( "max_rf_bounding_ratio", &RifBatchScorerOpts::max_rf_bounding_ratio )
+		.def_readwrite( "rif_occupancy_filter_bits", &RifBatchScorerOpts::rif_occupancy_filter_bits )
+	;
+
+	py::class_< RifBatchScorer, std::shared_ptr<RifBatchScorer> >(m, "RifBatchScorer")
+		.def( py::init<RifBatchScorerOpts const &>() )
+		.def( "set_scaffold", &set_scaffold, "frames (nres,4,4), atom_xyz (natoms,3), atom_types (natoms,)",
+			py::arg("frames"), py::arg("atom_xyz"), py::arg("atom_types") )
+		.def( "score", &score, "score (n,4,4) scaffold to target transforms, returns a dict of numpy arrays",
+			py::arg("xforms"), py::arg("rotamer_hits") = false )
+		.def( "nres", &RifBatchScorer::nres )
+		.def( "natoms", &RifBatchScorer::natoms )
+		.def( "rif_cart_resl", &RifBatchScorer::rif_cart_resl )
+		.def( "rif_ang_resl", &RifBatchScorer::rif_ang_resl )
+	;
+
+	m.def( "bb_frames_from_n_ca_c", &bb_frames_from_n_ca_c, "backbone frames (nres,4,4) as used by the RIF from (nres,3) coordinates",
+		py::arg("n"), py::arg("ca"), py::arg("c") );
+
+	return m.ptr();
+}
@@ -0,0 +1 @@
+from _pysetta_rif import *
@@ -9,3 +9,17 @@ p = Pose()
 p.dump_pdb("test.pdb")
 p = pose_from_file("/work/sheffler/1ffw_native.pdb")
 p.dump_pdb("test2.pdb")
+
+# batch rif scoring, frames and atoms are in the scaffold frame, see pysetta/_pysetta_rif.cc
+import numpy as np
+from pysetta import rif
+opts = rif.RifBatchScorerOpts()
+opts.rif_type = "RotScore64"
+opts.rif_file = "rif_64_test_sca0.7_noKR.rif.gz_resl1.0.rif.gz"
+opts.target_pdb = "test_target.pdb"
+opts.target_rf_cache = "test_target_rf_cache"
+scorer = rif.RifBatchScorer( opts )
+n, ca, c = np.random.rand(10,3), np.random.rand(10,3), np.random.rand(10,3)
+scorer.set_scaffold( rif.bb_frames_from_n_ca_c( n, ca, c ), ca, np.full( 10, 19, dtype=np.int32 ) )
+scores = scorer.score( np.tile( np.eye(4), (1000,1,1) ), rotamer_hits=True )
+print( scores["rif_score"].min(), scores["clash_score"].min(), scores["hit_rot"].shape )
@@ -46,6 +46,7 @@
 	// #include <scheme/actor/BackboneActor.hh>
 	// #include <scheme/actor/VoxelActor.hh>
 	#include <scheme/kinematics/Director.hh>
+	#include <scheme/util/PerfReport.hh>
 	// #include <scheme/kinematics/SceneBase.hh>
 	// #include <scheme/nest/pmap/OriTransMap.hh>
 	// #include <scheme/numeric/rand_xform.hh>
@@ -67,6 +68,7 @@
 
 	#include <chrono>
 	#include <random>
+	#include <map>
 
 
 /// Brian
@@ -81,6 +83,7 @@
 
 // Task system
 	#include <riflib/task/TaskProtocol.hh>
+	#include <riflib/task/Checkpoint.hh>
 	#include <riflib/rifdock_tasks/HSearchTasks.hh>
 	#include <riflib/rifdock_tasks/SetFaModeTasks.hh>
 	#include <riflib/rifdock_tasks/HackPackTasks.hh>
@@ -91,6 +94,7 @@
 	#include <riflib/rifdock_tasks/SeedingPositionTasks.hh>
 	#include <riflib/rifdock_tasks/MorphTasks.hh>
 	#include <riflib/rifdock_tasks/SasaTasks.hh>
+	#include <riflib/rifdock_tasks/ShardTasks.hh>
 
 	#include <riflib/seeding_util.hh>
 
@@ -118,6 +122,14 @@ int main(int argc, char *argv[]) {
 	opt.init_from_cli();
 	utility::file::create_directory_recursive( opt.outdir );
 
+	shared_ptr< ::scheme::util::PerfReport > perf_report;
+	if( opt.perf_report.size() ){
+		perf_report = make_shared< ::scheme::util::PerfReport >();
+		perf_report->set_meta( "app", "rif_dock_test" );
+		perf_report->set_meta( "nthreads", devel::scheme::omp_max_threads() );
+		perf_report->set_meta( "nscaffolds", opt.scaffold_fnames.size() );
+	}
+
 
 
 	#ifdef USE_OPENMP
@@ -642,6 +654,8 @@ int main(int argc, char *argv[]) {
 	std::vector<shared_ptr<RifBase> > rif_ptrs;
 	std::vector<bool> rif_using_rot;
 	{
+		double const read_wall_start = ::scheme::util::PerfReport::wall_seconds();
+		double const read_cpu_start = ::scheme::util::PerfReport::process_cpu_seconds();
 		std::vector<std::string> rif_descriptions( opt.rif_files.size() );
 		rif_ptrs.resize( opt.rif_files.size() );
 		std::exception_ptr exception = nullptr;
@@ -660,6 +674,7 @@ int main(int argc, char *argv[]) {
 				}
 				rif_ptr = rif_factory->create_rif_from_file( rif_file, rif_dscr );
 				runtime_assert_msg( rif_ptrs[i_readmap] , "rif creation from file failed! " + rif_file );
+				if ( opt.rif_occupancy_filter_bits > 0 ) rif_ptr->build_occupancy_filter( opt.rif_occupancy_filter_bits );
 				if( opt.VERBOSE ){
 					#ifdef USE_OPENMP
 					#pragma omp critical
@@ -692,6 +707,10 @@ int main(int argc, char *argv[]) {
 			}
 		}
 		if( exception ) std::rethrow_exception(exception);
+		if( perf_report ){
+			perf_report->add_time( "read_rifs", -1, ::scheme::util::PerfReport::wall_seconds() - read_wall_start,
+				::scheme::util::PerfReport::process_cpu_seconds() - read_cpu_start, omp_max_threads() );
+		}
 
 		if ( opt.only_load_highest_resl ) {
 			for ( int i = 0; i < resl_load_map.size() - 1; i++) {
@@ -706,6 +725,9 @@ int main(int argc, char *argv[]) {
 			std::cout << "load factor: " << rif_ptrs.back()->load_factor() << std::endl;
 			std::cout << "size of value-type: " << rif_ptrs.back()->sizeof_value_type() << std::endl;
 			std::cout << "mem_use: " << ::devel::scheme::KMGT( rif_ptrs.back()->mem_use() ) << std::endl;
+			if ( opt.rif_occupancy_filter_bits > 0 ) {
+				std::cout << "occupancy filter mem_use: " << ::devel::scheme::KMGT( rif_ptrs.back()->occupancy_filter_mem_use() ) << std::endl;
+			}
 			std::cout << "===================================================================================" << std::endl;
 
 			rif_using_rot[ rot_index.ala_rot() ] = true; // always include ala
@@ -879,6 +901,51 @@ int main(int argc, char *argv[]) {
 		for ( auto const & pair : xform_pairs ) xform_positions.push_back( pair.second );
 	}
 
+	// anything that changes the results changes the command line, so checkpoints are keyed on it
+	uint64_t const checkpoint_options_key = TaskCheckpoint::options_key( argc, argv );
+
+	// -rif_dock:merge_shards, the shard hsearch results grouped by the scaffold they came from
+	std::map<std::string, shared_ptr<std::vector<SearchPoint>>> merged_shard_results;
+	std::map<std::string, int64_t> merged_shard_search_effort;
+	std::map<std::string, std::vector<std::string>> merged_shard_fnames; // by shard_index
+	for ( std::string const & fname : opt.merge_shards ) {
+		std::string scaffold_key;
+		int shard_index = 0, num_shards = 0;
+		int64_t search_effort = 0;
+		std::vector<SearchPoint> results;
+		if ( ! read_shard_results( fname, scaffold_key, shard_index, num_shards, search_effort, results ) ) {
+			utility_exit_with_message( "Could not read shard results file: " + fname );
+		}
+		std::vector<std::string> & shard_fnames = merged_shard_fnames[scaffold_key];
+		if ( shard_fnames.empty() && num_shards > 0 ) shard_fnames.resize( num_shards );
+		if ( num_shards != shard_fnames.size() || shard_index < 0 || shard_index >= num_shards ) {
+			utility_exit_with_message( "Shard results file " + fname + " is shard " + str(shard_index) + " of " + str(num_shards)
+			                           + " but other files for " + scaffold_key + " are from a run with " + str(shard_fnames.size()) + " shards" );
+		}
+		if ( shard_fnames[shard_index].size() ) {
+			utility_exit_with_message( "Shard " + str(shard_index) + " of " + scaffold_key + " given twice: "
+			                           + shard_fnames[shard_index] + " and " + fname );
+		}
+		shard_fnames[shard_index] = fname;
+		shared_ptr<std::vector<SearchPoint>> & merged = merged_shard_results[scaffold_key];
+		if ( ! merged ) merged = make_shared<std::vector<SearchPoint>>();
+		merged->insert( merged->end(), results.begin(), results.end() );
+		merged_shard_search_effort[scaffold_key] += search_effort;
+		std::cout << "Loaded " << results.size() << " results for " << scaffold_key << " from " << fname << std::endl;
+	}
+	for ( auto const & shard_fnames : merged_shard_fnames ) {
+		for ( int ishard = 0; ishard < shard_fnames.second.size(); ishard++ ) {
+			if ( shard_fnames.second[ishard].empty() ) {
+				utility_exit_with_message( "Missing shard " + str(ishard) + " of " + str(shard_fnames.second.size())
+				                           + " for " + shard_fnames.first + " in -rif_dock:merge_shards" );
+			}
+		}
+	}
+	// the tail of the protocol expects them in score order, as HSearchFinishTask leaves them
+	for ( auto & merged : merged_shard_results ) {
+		__gnu_parallel::sort( merged.second->begin(), merged.second->end() );
+	}
+
 	for( int iscaff = 0; iscaff < opt.scaffold_fnames.size(); ++iscaff )
 	{
 		std::string scaff_fname = opt.scaffold_fnames.at(iscaff);
@@ -887,9 +954,11 @@ int main(int argc, char *argv[]) {
 		try {
 
 			ProtocolData pd;
+			pd.perf_report = perf_report;
 
 			runtime_assert( rot_index_p );
 			std::string scafftag = utility::file_basename( utility::file::file_basename( scaff_fname ) );
+			std::string scaffold_key = str(iscaff) + "_" + scafftag;
 
 			std::cout << "/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////" << std::endl;
 			std::cout << "/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////" << std::endl;
@@ -897,6 +966,25 @@ int main(int argc, char *argv[]) {
 			std::cout << "/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////" << std::endl;
 			std::cout << "/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////" << std::endl;
 
+			if ( opt.merge_shards.size() && ! merged_shard_results.count( scaffold_key ) ) {
+				std::cout << "no shard results for scaffold " << scaffold_key << ", skipping" << std::endl;
+				continue;
+			}
+
+			shared_ptr<TaskCheckpoint> checkpoint;
+			if ( opt.checkpoint_dir.size() && opt.merge_shards.empty() ) {
+				std::string checkpoint_tag = scaffold_key;
+				if ( opt.num_shards > 1 ) checkpoint_tag += boost::str( boost::format( "_shard%iof%i" ) % opt.shard_index % opt.num_shards );
+				checkpoint = make_shared<TaskCheckpoint>( opt.checkpoint_dir, checkpoint_tag, opt.checkpoint_interval, checkpoint_options_key );
+				if ( checkpoint->is_done( pd ) ) {
+					std::cout << "scaffold " << scafftag << " already finished according to " << opt.checkpoint_dir << ", skipping" << std::endl;
+					time_rif += pd.time_rif;
+					time_pck += pd.time_pck;
+					time_ros += pd.time_ros;
+					continue;
+				}
+			}
+
 
 			bool needs_scaffold_director = false;
 
@@ -961,6 +1049,7 @@ int main(int argc, char *argv[]) {
             	rso_config.hydrophobic_ddg_cut = opt.hydrophobic_ddg_cut;
 
             	rso_config.ignore_rifres_if_worse_than = opt.ignore_rifres_if_worse_than;
+            	rso_config.hsearch_clash_cutoff = opt.hsearch_clash_cutoff;
 
 
             if ( opt.require_satisfaction > 0 && rif_ptrs.back()->has_sat_data_slots() ) {
@@ -1079,6 +1168,18 @@ int main(int argc, char *argv[]) {
 			
             rso_config.sat_bonus = opt.sat_score_bonus;
             rso_config.sat_bonus_override = opt.sat_score_override;
+
+            if ( perf_report ) {
+                for ( int i = 0; i < rif_ptrs.size(); i++ ) {
+                    rso_config.rif_probe_counters.push_back( make_shared< ::scheme::util::ThreadCounters >( omp_max_threads_1() ) );
+                }
+            }
+            if ( opt.hsearch_reuse_parent_hits ) {
+                rso_config.residue_hints = make_shared< HSearchResidueHints >( omp_max_threads_1() );
+            }
+            if ( opt.hsearch_score_bound && ! opt.hack_pack_during_hsearch ) {
+                rso_config.score_bound = make_shared< HSearchScoreBound >( omp_max_threads_1() );
+            }
 				
 
 			ScenePtr scene_prototype;
@@ -1153,7 +1254,13 @@ int main(int argc, char *argv[]) {
 				std::cout << "cart grid lb " << lb << std::endl;
 				std::cout << "(ub-lb/nc) = " << ((ub-lb)/nc.template cast<float>()) << std::endl;
 				std::cout << "cartcen to corner (cart. covering radius): " << sqrt(3.0)*cart_grid/2.0 << std::endl;
-				nest_director = make_shared<RifDockNestDirector>( rot_resl_deg0, lb, ub, nc, 1 );
+				::scheme::nest::pmap::OriMapType ori_map_type = ::scheme::nest::pmap::OriMapType::Tetracontoctachoron;
+				if ( opt.nest_ori_map == "120cell" ) {
+					ori_map_type = ::scheme::nest::pmap::OriMapType::Hecatonicosachoron;
+				} else if ( opt.nest_ori_map != "48cell" ) {
+					utility_exit_with_message( "-rif_dock:nest_ori_map must be 48cell or 120cell, not " + opt.nest_ori_map );
+				}
+				nest_director = make_shared<RifDockNestDirector>( rot_resl_deg0, lb, ub, nc, ori_map_type, 1 );
 				std::cout << "NestDirector:" << endl << *nest_director << endl;
 				std::cout << "nest size0:    " << nest_director->size(0, RifDockIndex()).nest_index << std::endl;
 				std::cout << "size of search space: ~" << float(nest_director->size(0, RifDockIndex()).nest_index)*1024.0*1024.0*1024.0 << " grid points" << std::endl;
@@ -1264,9 +1371,6 @@ int main(int argc, char *argv[]) {
 				}
 				if ( opt.test_hackpack ) {
 					scaffold_provider->setup_twobody_tables( ScaffoldIndex() );
-					if ( unsat_manager ) {
-						scaffold_provider->setup_twobody_tables_per_thread( ScaffoldIndex() );
-					}
 
 
 					SearchPointWithRots result;
@@ -1366,13 +1470,18 @@ int main(int argc, char *argv[]) {
 			std::vector<shared_ptr<Task>> task_list;
 
 
-			if (opt.scaff_search_mode == "morph" ) {
+			if (opt.scaff_search_mode == "morph") {
     			task_list.push_back(make_shared<TestMakeChildrenTask>( ));
 			}
 
-			if ( opt.xform_fname.length() > 0) {
+			// shards stop after the hsearch, -merge_shards picks up from there
+			// RifDockOpt rejects sharding together with rifine and the morph modes
+			bool const rifine = opt.xform_fname.length() > 0;
+			bool const shard_only = opt.num_shards > 1 && opt.merge_shards.empty();
+
+			if ( rifine ) {
 				create_rifine_task( task_list, rdd );
-			} else {
+			} else if ( opt.merge_shards.empty() ) {
 				if ( opt.scaff_search_mode == "morph_dive_pop" ) {
 					create_dive_pop_hsearch_task( task_list, rdd); 
 				} else {
@@ -1380,10 +1489,14 @@ int main(int argc, char *argv[]) {
 
 					task_list.push_back(make_shared<DiversifyBySeedingPositionsTask>()); // this is a no-op if there are no seeding positions
 					task_list.push_back(make_shared<DiversifyByNestTask>( 0 ));
+					if ( opt.num_shards > 1 ) {
+						task_list.push_back(make_shared<ShardSearchSpaceTask>( opt.shard_index, opt.num_shards ));
+					}
 
 					task_list.push_back(make_shared<HSearchInit>( ));
 					for ( int i = 0; i <= final_resl; i++ ) {
-						task_list.push_back(make_shared<HSearchScoreAtReslTask>( i, i, opt.tether_to_input_position_cut ));
+						task_list.push_back(make_shared<HSearchScoreAtReslTask>( i, i, opt.tether_to_input_position_cut,
+						                                                          i < final_resl ? opt.beam_size / opt.DIMPOW2 : 0 ));
 
 						if (opt.hack_pack_during_hsearch) {
 							task_list.push_back(make_shared<SortByScoreTask>( ));
@@ -1401,12 +1514,20 @@ int main(int argc, char *argv[]) {
 							task_list.push_back(make_shared<HSearchScaleToReslTask>( i, i+1, opt.DIMPOW2, opt.global_score_cut )); 
 						} 
 					}
+					if ( opt.refine_n_best > 0 ) {
+						task_list.push_back(make_shared<HSearchRefineNeighborsTask>( final_resl, final_resl, opt.refine_n_best, opt.refine_rounds,
+						                                                                    opt.global_score_cut, opt.tether_to_input_position_cut ));
+					}
 					task_list.push_back(make_shared<HSearchFinishTask>( opt.global_score_cut )); 
 				}
 
 				if ( opt.sasa_cut > 0 ) {
 					task_list.push_back(make_shared<FilterBySasaTask>( opt.sasa_cut ));
 				}
+			}
+
+			// merged shard results start here, already hsearched and in score order
+			if ( ! rifine && ! shard_only ) {
 
 				task_list.push_back(make_shared<SetFaModeTask>( true ));
 
@@ -1461,16 +1582,33 @@ int main(int argc, char *argv[]) {
 
 
 			TaskProtocol protocol( task_list );
+			protocol.set_checkpoint( checkpoint );
 
 
 			shared_ptr<std::vector<SearchPoint>> starting_point = make_shared<std::vector<SearchPoint>>( );
 			starting_point->push_back(SearchPoint(RifDockIndex()));
 
 			ThreePointVectors input;
-			input.search_points = starting_point;
+			if ( opt.merge_shards.size() ) {
+				input.search_points = merged_shard_results.at( scaffold_key );
+				pd.total_search_effort = merged_shard_search_effort.at( scaffold_key );
+			} else {
+				input.search_points = starting_point;
+			}
 			std::cout << "RUN!" << std::endl;
 			ThreePointVectors results = protocol.run( input, rdd, pd );
 
+			if ( shard_only ) {
+				std::string shard_fname = shard_results_fname( opt.outdir, scaffold_key, opt.shard_index, opt.num_shards );
+				std::vector<SearchPoint> no_results;
+				if ( ! write_shard_results( shard_fname, scaffold_key, opt.shard_index, opt.num_shards, pd.total_search_effort,
+				                            results.search_points ? *results.search_points : no_results ) ) {
+					utility_exit_with_message( "Could not write shard results file: " + shard_fname );
+				}
+				std::cout << "wrote shard results to " << shard_fname << std::endl;
+			}
+			if ( checkpoint ) checkpoint->mark_done( pd );
+
 			time_rif += pd.time_rif;
 			time_pck += pd.time_pck;
 			time_ros += pd.time_ros;
@@ -1500,6 +1638,17 @@ int main(int argc, char *argv[]) {
 
 	dokout.close();
 
+	if( perf_report ){
+		perf_report->set_meta( "time_rif", time_rif );
+		perf_report->set_meta( "time_pck", time_pck );
+		perf_report->set_meta( "time_ros", time_ros );
+		if( perf_report->write( opt.perf_report ) ){
+			std::cout << "wrote performance report to " << opt.perf_report << std::endl;
+		} else {
+			std::cout << "WARNING: could not write performance report to " << opt.perf_report << std::endl;
+		}
+	}
+
 
 
 
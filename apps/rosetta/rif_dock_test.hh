@@ -36,6 +36,13 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 	OPT_1GRP_KEY(  String      , rif_dock, target_acceptors )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, only_load_highest_resl )
     OPT_1GRP_KEY(  Boolean     , rif_dock, dont_load_any_resl )
+    OPT_1GRP_KEY(  Real        , rif_dock, rif_occupancy_filter_bits )
+    OPT_1GRP_KEY(  String      , rif_dock, perf_report )
+    OPT_1GRP_KEY(  String      , rif_dock, checkpoint_dir )
+    OPT_1GRP_KEY(  Real        , rif_dock, checkpoint_interval )
+    OPT_1GRP_KEY(  Integer     , rif_dock, shard_index )
+    OPT_1GRP_KEY(  Integer     , rif_dock, num_shards )
+    OPT_1GRP_KEY(  StringVector, rif_dock, merge_shards )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, use_rosetta_grid_energies )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, soft_rosetta_grid_energies )
 
@@ -47,6 +54,7 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
     OPT_1GRP_KEY(  Boolean     , rif_dock, multiply_beam_by_scaffolds )
 	OPT_1GRP_KEY(  Real        , rif_dock, search_diameter )
 	OPT_1GRP_KEY(  Real        , rif_dock, hsearch_scale_factor )
+	OPT_1GRP_KEY(  String      , rif_dock, nest_ori_map )
 
 	OPT_1GRP_KEY(  Real        , rif_dock, max_rf_bounding_ratio )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, make_bounding_plot_data )
@@ -57,6 +65,9 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
     OPT_1GRP_KEY(  Boolean     , rif_dock, outputlite )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, parallelwrite )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, outputsilent )
+	OPT_1GRP_KEY(  Boolean     , rif_dock, output_async )
+	OPT_1GRP_KEY(  Integer     , rif_dock, output_gz_level )
+	OPT_1GRP_KEY(  Integer     , rif_dock, output_queue_MB )
 	OPT_1GRP_KEY(  Integer     , rif_dock, n_pdb_out )
     OPT_1GRP_KEY(  Integer     , rif_dock, n_pdb_out_global )
 
@@ -89,6 +100,8 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 	OPT_1GRP_KEY(  Real        , rif_dock, min_hb_quality_for_satisfaction )
 	OPT_1GRP_KEY(  Real        , rif_dock, long_hbond_fudge_distance )
 	OPT_1GRP_KEY(  Real        , rif_dock, global_score_cut )
+	OPT_1GRP_KEY(  Integer     , rif_dock, refine_n_best )
+	OPT_1GRP_KEY(  Integer     , rif_dock, refine_rounds )
 
 	OPT_1GRP_KEY(  Real        , rif_dock, redundancy_filter_mag )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, filter_seeding_positions_separately )
@@ -106,6 +119,7 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, add_native_scaffold_rots_when_packing )
     OPT_1GRP_KEY(  Boolean     , rif_dock, native_docking )
     OPT_1GRP_KEY(  Real        , rif_dock, ignore_rifres_if_worse_than )
+    OPT_1GRP_KEY(  Real        , rif_dock, hsearch_clash_cutoff )
 
 	OPT_1GRP_KEY(  Boolean     , rif_dock, dump_all_rif_rots )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, dump_all_rif_rots_into_output )
@@ -184,6 +198,11 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, rosetta_min_scaffoldbb )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, rosetta_min_allbb )
 	OPT_1GRP_KEY(  Real        , rif_dock, rosetta_score_cut )
+	OPT_1GRP_KEY(  Boolean     , rif_dock, rosetta_work_stealing )
+	OPT_1GRP_KEY(  Boolean     , rif_dock, hsearch_reuse_parent_hits )
+	OPT_1GRP_KEY(  Boolean     , rif_dock, hsearch_score_bound )
+	OPT_1GRP_KEY(  Boolean     , rif_dock, test_hsearch_score_bound )
+	OPT_1GRP_KEY(  Integer     , rif_dock, rosetta_min_stop_after_n_passing )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, rosetta_hard_min )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, rosetta_score_total )
 	OPT_1GRP_KEY(  Boolean     , rif_dock, rosetta_score_ddg_only )
@@ -240,6 +259,8 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 
     OPT_1GRP_KEY(  Boolean     , rif_dock, include_parent )
     OPT_1GRP_KEY(  Boolean     , rif_dock, use_parent_body_energies )
+    OPT_1GRP_KEY(  Boolean     , rif_dock, morph_incremental_tables )
+    OPT_1GRP_KEY(  Boolean     , rif_dock, test_morph_incremental_tables )
 
     OPT_1GRP_KEY(  Integer     , rif_dock, dive_resl )
     OPT_1GRP_KEY(  Integer     , rif_dock, pop_resl )
@@ -345,6 +366,13 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 			NEW_OPT(  rif_dock::target_acceptors, "", "" );
 			NEW_OPT(  rif_dock::only_load_highest_resl, "Only read in the highest resolution rif", false );
             NEW_OPT(  rif_dock::dont_load_any_resl, "This will certainly crash", false );
+            NEW_OPT(  rif_dock::rif_occupancy_filter_bits, "Bits per RIF key for the bloom filter checked before each RIF lookup. 0 to disable.", 16.0 );
+            NEW_OPT(  rif_dock::perf_report, "Write per-task timings and counters to this file at the end of the run. .csv for csv, otherwise json", "" );
+            NEW_OPT(  rif_dock::checkpoint_dir, "Save the search state here between tasks and resume from it when rerun with the same options. Finished scaffolds are skipped on rerun. A checkpoint written with any other flags (or @flags file contents), apart from the checkpoint ones, is ignored.", "" );
+            NEW_OPT(  rif_dock::checkpoint_interval, "Minimum seconds between two checkpoint writes for one scaffold", 300.0 );
+            NEW_OPT(  rif_dock::shard_index, "Which slice of the coarsest search space this process docks, 0 to num_shards-1", 0 );
+            NEW_OPT(  rif_dock::num_shards, "Split the search over this many independent processes. Each stops after the hierarchical search and writes its results to <outdir>/<scaffold>_shard<i>of<n>.rdr, nothing else is output. The beam size applies per shard. Not with -xform_pos or the morph scaff_search_modes", 1 );
+            NEW_OPT(  rif_dock::merge_shards, "Instead of docking, run everything after the hierarchical search (hack pack, rosetta score/min, redundancy filter and output) over the combined .rdr files of a sharded run. Use the same flags as the shards", utility::vector1<std::string>() );
 			NEW_OPT(  rif_dock::use_rosetta_grid_energies, "Use Frank's grid energies for scoring", false );
 			NEW_OPT(  rif_dock::soft_rosetta_grid_energies, "Use soft option for grid energies", false );
 
@@ -363,6 +391,9 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
             NEW_OPT(  rif_dock::outputlite, "Write the output structures as compressed silent files", false );
 	    NEW_OPT(  rif_dock::parallelwrite, "Write the output structures using all available threads", false );
 			NEW_OPT(  rif_dock::outputsilent, "", false );
+			NEW_OPT(  rif_dock::output_async, "Compress and write output structures on a background thread as results are finalized", true );
+			NEW_OPT(  rif_dock::output_gz_level, "gzip level for .gz output written by -output_async, 1 fastest 9 smallest", 6 );
+			NEW_OPT(  rif_dock::output_queue_MB, "Max MB of output waiting for the -output_async writer before producers block", 256 );
 			NEW_OPT(  rif_dock::n_pdb_out, "" , 10 );
             NEW_OPT(  rif_dock::n_pdb_out_global, "Normally n_pdb_out applies to each seeding position, this caps the global", -1);
 
@@ -388,6 +419,8 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 			NEW_OPT(  rif_dock::min_hb_quality_for_satisfaction, "Minimum fraction of total hbond energy required for satisfaction. Scale -1 to 0", -0.6 );
 			NEW_OPT(  rif_dock::long_hbond_fudge_distance, "Any hbond longer than 2A gets moved closer to 2A by this amount for scoring", 0.0 );
 			NEW_OPT(  rif_dock::global_score_cut, "" , 0.0 );
+			NEW_OPT(  rif_dock::refine_n_best, "After the last hsearch stage, also score the NEST neighbors of this many best points. 0 to disable", 0 );
+			NEW_OPT(  rif_dock::refine_rounds, "Rounds of -refine_n_best. After the first, only neighbors that beat the point they came from are expanded", 3 );
 
 			NEW_OPT(  rif_dock::redundancy_filter_mag, "" , 1.0 );
 			NEW_OPT(  rif_dock::filter_seeding_positions_separately, "Redundancy filter each seeding position separately", true );
@@ -402,12 +435,14 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 
 			NEW_OPT(  rif_dock::search_diameter, "", 150.0 );
 			NEW_OPT(  rif_dock::hsearch_scale_factor, "global scaling of rotation/translation search grid", 1.0 );
+			NEW_OPT(  rif_dock::nest_ori_map, "orientation cells of the search NEST: 48cell or 120cell (half 120-cell, finer at nside 1 but more samples at docking resolutions)", "48cell" );
 
 			NEW_OPT(  rif_dock::restrict_to_native_scaffold_res, "aka structure prediction CHEAT. Depricated. Still allows ALA. Use -native_docking", false );
 			NEW_OPT(  rif_dock::bonus_to_native_scaffold_res, "aka favor native CHEAT", -0.3 );
 			NEW_OPT(  rif_dock::add_native_scaffold_rots_when_packing, "CHEAT. See -native_docking (which is separate)", false );
             NEW_OPT(  rif_dock::native_docking, "Best way to do docking with only native AAs. Added by bcov 2021.", false );
             NEW_OPT(  rif_dock::ignore_rifres_if_worse_than, "Don't use bad rif residues", 0 );
+            NEW_OPT(  rif_dock::hsearch_clash_cutoff, "Stop scoring scaffold atoms against the target clash grids once the clash score passes this and reject the sample. Default is off.", 9e9 );
 
 			NEW_OPT(  rif_dock::dump_all_rif_rots, "", false );
 			NEW_OPT(  rif_dock::dump_all_rif_rots_into_output, "dump all rif rots into output", false);
@@ -493,6 +528,11 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 			NEW_OPT(  rif_dock::rosetta_min_allbb  , "",  false );
 			NEW_OPT(  rif_dock::rosetta_min_fix_target, "",  false );
 			NEW_OPT(  rif_dock::rosetta_score_cut  , "", -10.0 );
+			NEW_OPT(  rif_dock::hsearch_reuse_parent_hits, "During the hierarchical search, only probe the rif at residues that had a rif hit in the parent sample. Exact if coarse rifs bound the finer ones", false );
+			NEW_OPT(  rif_dock::hsearch_score_bound, "During the hierarchical search, estimate the beam cut of each resolution from a pilot of the samples and stop probing the rif for samples that can no longer make it. Samples are rescored if the estimate was too strict. The clash and CB terms are bounded by their lowest possible values. Not used for scenes with hbond or sasa actors or with burial or atoms_close_together scoring. Ignored with hack_pack_during_hsearch", false );
+			NEW_OPT(  rif_dock::test_hsearch_score_bound, "Score each resolution that used -hsearch_score_bound again without it and exit if the beam differs", false );
+			NEW_OPT(  rif_dock::rosetta_work_stealing, "Run rosetta score/min most expensive first on per-thread queues with work stealing", true );
+			NEW_OPT(  rif_dock::rosetta_min_stop_after_n_passing, "Stop rosetta min once this many results pass rosetta_score_cut. Results are then done in rif score order. 0 to disable", 0 );
 			NEW_OPT(  rif_dock::rosetta_hard_min  , "", false );
 			NEW_OPT(  rif_dock::rosetta_score_total  , "", false );
 			NEW_OPT(  rif_dock::rosetta_score_ddg_only  , "", false );
@@ -547,6 +587,8 @@ OPT_1GRP_KEY(     StringVector , rif_dock, scaffolds )
 
 			NEW_OPT(  rif_dock::include_parent, "Include parent fragment in diversified scaffolds.", false );
 			NEW_OPT(  rif_dock::use_parent_body_energies, "Don't recalculate 1-/2-body energies for fragment insertions", false );
+			NEW_OPT(  rif_dock::morph_incremental_tables, "Only recalculate 1-/2-body energies of morphs for residues that moved or see ones that did", true );
+			NEW_OPT(  rif_dock::test_morph_incremental_tables, "Also compute the onebody energies of each morph from scratch and exit if they differ from the ones -morph_incremental_tables copied", false );
 
 			NEW_OPT(  rif_dock::dive_resl , "Dive to this depth before diversifying", 5 );
 			NEW_OPT(  rif_dock::pop_resl , "Return to this depth after diversifying", 4 );
@@ -645,6 +687,8 @@ struct RifDockOpt
 	float       tether_to_input_position_cut         ;
 	bool        tether_to_input_position             ;
 	float       global_score_cut                     ;
+	int64_t     refine_n_best                        ;
+	int         refine_rounds                        ;
 	std::string target_pdb                           ;
 	std::string outdir                               ;
 	std::string output_tag                           ;
@@ -672,10 +716,12 @@ struct RifDockOpt
 	bool        add_native_scaffold_rots_when_packing;
     bool        native_docking                       ;
     float       ignore_rifres_if_worse_than          ;
+    float       hsearch_clash_cutoff                 ;
 	bool        restrict_to_native_scaffold_res      ;
 	float       bonus_to_native_scaffold_res         ;
 	float       hack_pack_frac                       ;
 	float       hsearch_scale_factor                 ;
+	std::string nest_ori_map                         ;
 	float       search_diameter                      ;
 	bool        use_scaffold_bounding_grids          ;
     utility::vector1<std::string> scaffold_res_pdbinfo_labels;
@@ -715,6 +761,9 @@ struct RifDockOpt
     bool        outputlite                           ;
     bool 	parallelwrite				 ;	
 	bool        outputsilent                         ;
+	bool        output_async                         ;
+	int         output_gz_level                      ;
+	int         output_queue_MB                      ;
 	bool        pdb_info_pikaa                       ;
     bool        pdb_info_pssm                        ;
 	bool        dump_resfile                         ;
@@ -726,6 +775,13 @@ struct RifDockOpt
 	std::string target_acceptors                     ;
 	bool        only_load_highest_resl               ;
     bool        dont_load_any_resl                   ;
+    float       rif_occupancy_filter_bits            ;
+    std::string perf_report                          ;
+    std::string checkpoint_dir                       ;
+    float       checkpoint_interval                  ;
+    int         shard_index                          ;
+    int         num_shards                           ;
+    std::vector<std::string> merge_shards            ;
 	bool        use_rosetta_grid_energies            ;
 	bool        soft_rosetta_grid_energies           ;
 	bool        downscale_atr_by_hierarchy           ;
@@ -787,6 +843,11 @@ struct RifDockOpt
 	bool        rosetta_min_scaffoldbb               ;
 	bool        rosetta_min_allbb                    ;
 	float       rosetta_score_cut                    ;
+	bool        rosetta_work_stealing                ;
+	bool        hsearch_reuse_parent_hits            ;
+	bool        hsearch_score_bound                  ;
+	bool        test_hsearch_score_bound             ;
+	int         rosetta_min_stop_after_n_passing     ;
 	float       rosetta_hard_min                     ;
 	bool        rosetta_score_total                  ;
 	bool        rosetta_score_ddg_only               ;
@@ -836,6 +897,8 @@ struct RifDockOpt
 
     bool        include_parent                       ;
     bool        use_parent_body_energies             ;
+    bool        morph_incremental_tables             ;
+    bool        test_morph_incremental_tables        ;
 
     int         dive_resl                            ;
     int         pop_resl                             ;
@@ -939,6 +1002,8 @@ struct RifDockOpt
 		tether_to_input_position_cut           = option[rif_dock::tether_to_input_position           ]();
 		tether_to_input_position               = tether_to_input_position_cut > 0.0;
 		global_score_cut                       = option[rif_dock::global_score_cut                   ]();
+		refine_n_best                          = option[rif_dock::refine_n_best                      ]();
+		refine_rounds                          = option[rif_dock::refine_rounds                      ]();
 		outdir                                 = option[rif_dock::outdir                             ]();
 		output_tag                             = option[rif_dock::output_tag                         ]();
 		dokfile_fname                          = outdir + "/" + option[rif_dock::dokfile             ]();
@@ -963,10 +1028,12 @@ struct RifDockOpt
 		add_native_scaffold_rots_when_packing  = option[rif_dock::add_native_scaffold_rots_when_packing ]();
         native_docking                         = option[rif_dock::native_docking                        ]();
         ignore_rifres_if_worse_than            = option[rif_dock::ignore_rifres_if_worse_than           ]();
+        hsearch_clash_cutoff                   = option[rif_dock::hsearch_clash_cutoff                  ]();
 		restrict_to_native_scaffold_res        = option[rif_dock::restrict_to_native_scaffold_res       ]();
 		bonus_to_native_scaffold_res           = option[rif_dock::bonus_to_native_scaffold_res          ]();
 		hack_pack_frac                         = option[rif_dock::hack_pack_frac                        ]();
 		hsearch_scale_factor                   = option[rif_dock::hsearch_scale_factor                  ]();
+		nest_ori_map                           = option[rif_dock::nest_ori_map                          ]();
 		search_diameter                        = option[rif_dock::search_diameter                       ]();
 		use_scaffold_bounding_grids            = option[rif_dock::use_scaffold_bounding_grids           ]();
 		scaffold_res_use_best_guess            = option[rif_dock::scaffold_res_use_best_guess           ]();
@@ -1002,6 +1069,9 @@ struct RifDockOpt
         outputlite                                     = option[rif_dock::outputlite                            ]();
 	parallelwrite                                  = option[rif_dock::parallelwrite                         ]();
 		outputsilent                           = option[rif_dock::outputsilent                          ]();
+		output_async                           = option[rif_dock::output_async                          ]();
+		output_gz_level                        = option[rif_dock::output_gz_level                       ]();
+		output_queue_MB                        = option[rif_dock::output_queue_MB                       ]();
 		pdb_info_pikaa                         = option[rif_dock::pdb_info_pikaa                        ]();
         pdb_info_pssm                          = option[rif_dock::pdb_info_pssm                         ]();
 		dump_resfile                           = option[rif_dock::dump_resfile                          ]();
@@ -1013,6 +1083,15 @@ struct RifDockOpt
 		target_acceptors                       = option[rif_dock::target_acceptors                      ]();		
 		only_load_highest_resl                 = option[rif_dock::only_load_highest_resl                ]();
         dont_load_any_resl                     = option[rif_dock::dont_load_any_resl                    ]();
+        rif_occupancy_filter_bits              = option[rif_dock::rif_occupancy_filter_bits             ]();
+        perf_report                            = option[rif_dock::perf_report                           ]();
+        checkpoint_dir                         = option[rif_dock::checkpoint_dir                        ]();
+        checkpoint_interval                    = option[rif_dock::checkpoint_interval                   ]();
+        shard_index                            = option[rif_dock::shard_index                           ]();
+        num_shards                             = option[rif_dock::num_shards                            ]();
+        for( std::string s : option[rif_dock::merge_shards]() ) merge_shards.push_back(s);
+
+        runtime_assert_msg( num_shards >= 1 && 0 <= shard_index && shard_index < num_shards, "need 0 <= -rif_dock:shard_index < -rif_dock:num_shards" );
 		use_rosetta_grid_energies              = option[rif_dock::use_rosetta_grid_energies             ]();
 		soft_rosetta_grid_energies             = option[rif_dock::soft_rosetta_grid_energies            ]();
 		downscale_atr_by_hierarchy             = option[rif_dock::downscale_atr_by_hierarchy            ]();
@@ -1072,6 +1151,11 @@ struct RifDockOpt
   		rosetta_min_scaffoldbb                 = option[rif_dock::rosetta_min_scaffoldbb                ]();
   		rosetta_min_allbb                      = option[rif_dock::rosetta_min_allbb                     ]();
   		rosetta_score_cut                      = option[rif_dock::rosetta_score_cut                     ]();
+  		rosetta_work_stealing                  = option[rif_dock::rosetta_work_stealing                 ]();
+  		hsearch_reuse_parent_hits              = option[rif_dock::hsearch_reuse_parent_hits             ]();
+  		hsearch_score_bound                    = option[rif_dock::hsearch_score_bound                   ]();
+  		test_hsearch_score_bound               = option[rif_dock::test_hsearch_score_bound              ]();
+  		rosetta_min_stop_after_n_passing       = option[rif_dock::rosetta_min_stop_after_n_passing      ]();
   		rosetta_hard_min                       = option[rif_dock::rosetta_hard_min                      ]();
   		rosetta_score_total                    = option[rif_dock::rosetta_score_total                   ]();
   		rosetta_score_ddg_only                 = option[rif_dock::rosetta_score_ddg_only                ]();
@@ -1115,6 +1199,8 @@ struct RifDockOpt
 
         include_parent                         = option[rif_dock::include_parent                        ]();
         use_parent_body_energies               = option[rif_dock::use_parent_body_energies              ]();
+        morph_incremental_tables               = option[rif_dock::morph_incremental_tables              ]();
+        test_morph_incremental_tables          = option[rif_dock::test_morph_incremental_tables         ]();
 
         dive_resl                              = option[rif_dock::dive_resl                             ]();
         pop_resl                               = option[rif_dock::pop_resl                              ]();
@@ -1241,6 +1327,19 @@ struct RifDockOpt
         }
 
 
+        if ( num_shards > 1 || merge_shards.size() > 0 ) {
+        	// morph children are built during the run and aren't in the .rdr files, and rifine
+        	// doesn't go through the sharded search at all
+        	if ( scaff_search_mode == "morph" || scaff_search_mode == "morph_dive_pop" ) {
+        		std::cout << "ERROR: -num_shards and -merge_shards can't be used with scaff_search_mode " << scaff_search_mode << "." << std::endl;
+        		std::exit(-1);
+        	}
+        	if ( xform_fname.length() > 0 ) {
+        		std::cout << "ERROR: -num_shards and -merge_shards can't be used with -xform_pos." << std::endl;
+        		std::exit(-1);
+        	}
+        }
+
         if ( scaff_search_mode == "nineA_baseline" ) {
         	if ( scaffold_fnames.size() > 0 ) {
         		std::cout << "ERROR: can't use -scaffolds with nineA_baseline." << std::endl;
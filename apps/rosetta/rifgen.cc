@@ -57,6 +57,7 @@ remove some or all modifications to residues, and/or remap res numbers? fix hbon
 	#include <scheme/objective/hash/XformMap.hh>
 	#include <scheme/objective/storage/RotamerScores.hh>
 	#include <scheme/actor/BackboneActor.hh>
+	#include <scheme/util/PerfReport.hh>
 
 	#include <utility/file/file_sys_util.hh>
 	#include <utility/io/izstream.hh>
@@ -83,6 +84,7 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
 	OPT_1GRP_KEY( Real          , rifgen, rif_apo_dump_fraction )
 	OPT_1GRP_KEY( StringVector  , rifgen, data_cache_dir )
 	OPT_1GRP_KEY( Integer       , rifgen, hbgeom_max_cache )
+	OPT_1GRP_KEY( Boolean       , rifgen, hbgeom_cache_mmap )
 	OPT_1GRP_KEY( Real          , rifgen, rosetta_field_resl )
 	OPT_1GRP_KEY( RealVector    , rifgen, search_resolutions )
 	OPT_1GRP_KEY( Real          , rifgen, hash_cart_resl )
@@ -91,6 +93,7 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
 	OPT_1GRP_KEY( Integer       , rifgen, rf_oversample )
 	OPT_1GRP_KEY( Boolean       , rifgen, generate_rf_for_docking )
 	OPT_1GRP_KEY( Real          , rifgen, beam_size_M )
+	OPT_1GRP_KEY( Integer       , rifgen, apo_max_parallel_rotamers )
 	OPT_1GRP_KEY( StringVector  , rifgen, apores )
 	OPT_1GRP_KEY( Real          , rifgen, hash_preallocate_mult )
 	OPT_1GRP_KEY( Real          , rifgen, score_cut_adjust )
@@ -101,6 +104,8 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
 	OPT_1GRP_KEY( Real          , rifgen, hbond_cart_sample_hack_range )
 	OPT_1GRP_KEY( Real          , rifgen, hbond_cart_sample_hack_resl )
 	OPT_1GRP_KEY( Integer       , rifgen, rif_accum_scratch_size_M )
+	OPT_1GRP_KEY( String        , rifgen, rif_accum_spill_dir )
+	OPT_1GRP_KEY( Integer       , rifgen, rif_accum_spill_size_M )
 	OPT_1GRP_KEY( Boolean       , rifgen, make_shitty_rpm_file )
 	OPT_1GRP_KEY( Boolean       , rifgen, test_without_rosetta_fields )
 	OPT_1GRP_KEY( Boolean       , rifgen, downweight_hydrophobics )
@@ -153,6 +158,8 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
   OPT_1GRP_KEY( Real          , rifgen, min_cationpi_score     )
   OPT_1GRP_KEY( Real          , rifgen, cationpi_bonus_weights )
 
+  OPT_1GRP_KEY( String        , rifgen, perf_report )
+
 
 
 	void register_options() {
@@ -173,6 +180,7 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
 		NEW_OPT(  rifgen::rif_apo_dump_fraction            , "" , 0.0001 );
 		NEW_OPT(  rifgen::data_cache_dir                   , "" , utility::vector1<std::string>(1,"./") );
 		NEW_OPT(  rifgen::hbgeom_max_cache                 , "max number of geom files to load at once", -1 );
+		NEW_OPT(  rifgen::hbgeom_cache_mmap                , "mmap .rel_rot_pos.bin hbond geometry caches instead of reading them", true );
 		NEW_OPT(  rifgen::rosetta_field_resl               , "" , 0.5 );
 		NEW_OPT(  rifgen::search_resolutions               , "" , utility::vector1<core::Real>() );
 		NEW_OPT(  rifgen::hash_cart_resl                   , "" , 0.2 );
@@ -181,6 +189,7 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
 		NEW_OPT(  rifgen::rf_oversample                    , "" , 2 );
 		NEW_OPT(  rifgen::generate_rf_for_docking          , "" , true );
 		NEW_OPT(  rifgen::beam_size_M                      , "" , 10.000000 );
+		NEW_OPT(  rifgen::apo_max_parallel_rotamers        , "max rotamers searched at once by the apo generator, each holds up to beam_size_M samples so peak memory grows with this. The threads are split between the rotamers searched at once. <= 0 means one per thread" , 4 );
 		NEW_OPT(  rifgen::score_cut_adjust                   , "" , 1.0 );
 		NEW_OPT(  rifgen::apores                           , "" , utility::vector1<std::string>() );
 		NEW_OPT(  rifgen::hash_preallocate_mult            , "" , 1.0 );
@@ -191,6 +200,8 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
 		NEW_OPT(  rifgen::hbond_cart_sample_hack_range     , "" , 0.375 );
 		NEW_OPT(  rifgen::hbond_cart_sample_hack_resl      , "" , 0.375 );
 		NEW_OPT(  rifgen::rif_accum_scratch_size_M         , "" , 32000 );
+		NEW_OPT(  rifgen::rif_accum_spill_dir              , "local scratch dir, if set the RIF being built is spilled there as sorted runs whenever it exceeds rif_accum_spill_size_M and merged back before saving" , "" );
+		NEW_OPT(  rifgen::rif_accum_spill_size_M           , "RIF memory that triggers a spill to rif_accum_spill_dir" , 16000 );
 		NEW_OPT(  rifgen::make_shitty_rpm_file             , "" , false );
 		NEW_OPT(  rifgen::test_without_rosetta_fields      , "" , false );
 		NEW_OPT(  rifgen::downweight_hydrophobics          , "" , false );
@@ -243,6 +254,8 @@ OPT_1GRP_KEY( StringVector, rifgen, donres )
 
 		NEW_OPT(  rifgen::min_cationpi_score    	, "score used to filter bad cationpi rif residues" , -0.2);
     NEW_OPT(  rifgen::cationpi_bonus_weights	, "final cationpi score is apo_score+weights*cationpi_score capped to -9.0" , 6.0);
+
+		NEW_OPT(  rifgen::perf_report                          , "write per-stage timings and counters to this file at the end of the run. .csv for csv, otherwise json" , "" );
 	}
 
 
@@ -403,6 +416,7 @@ std::shared_ptr<::devel::scheme::RifBase> init_rif_and_generators(
 			hbgenopts.dump_bindentate_hbonds = option[ rifgen::dump_bidentate_hbonds ]();
 			hbgenopts.report_aa_count = option[ rifgen::report_aa_count ]();
 			hbgenopts.hbgeom_max_cache = option[ rifgen::hbgeom_max_cache ]();
+			hbgenopts.hbgeom_cache_mmap = option[ rifgen::hbgeom_cache_mmap ]();
 			hbgenopts.no_bb_hbonds = option[ rifgen::no_bb_hbonds ]();
 
 			rif_generators_out.push_back(
@@ -428,6 +442,7 @@ std::shared_ptr<::devel::scheme::RifBase> init_rif_and_generators(
 			apogenopts.only_place_requirement_res = option[rifgen::only_place_requirement_res]();
 			apogenopts.min_cationpi_score  = option[rifgen::min_cationpi_score]();
 			apogenopts.cationpi_bonus_weights  = option[rifgen::cationpi_bonus_weights]();
+			apogenopts.max_parallel_rotamers  = option[rifgen::apo_max_parallel_rotamers]();
 
 			rif_generators_out.push_back(
 				::scheme::make_shared<devel::scheme::rif::RifGeneratorApoHSearch>(
@@ -521,6 +536,13 @@ int main(int argc, char *argv[]) {
 			using devel::scheme::KMGT;
 
 
+	shared_ptr< ::scheme::util::PerfReport > perf_report;
+	if( option[rifgen::perf_report]().size() ){
+		perf_report = make_shared< ::scheme::util::PerfReport >();
+		perf_report->set_meta( "app", "rifgen" );
+		perf_report->set_meta( "nthreads", omp_max_threads() );
+	}
+
 	std::string rif_type = option[rifgen::rif_type]();
 	std::string target_reslist_file = basic::options::option[basic::options::OptionKeys::rifgen::target_res]();
 	std::cout << "rif_type: " << rif_type << std::endl;
@@ -734,7 +756,9 @@ int main(int argc, char *argv[]) {
 		option[rifgen::hash_cart_resl](),
 		option[rifgen::hash_angle_resl](),
 		512.0f,
-		option[rifgen::rif_accum_scratch_size_M]()
+		option[rifgen::rif_accum_scratch_size_M](),
+		option[rifgen::rif_accum_spill_dir](),
+		option[rifgen::rif_accum_spill_size_M]()
 	);
 
 	if ( option[rifgen::rif_append_mode]() ) {
@@ -895,8 +919,11 @@ int main(int argc, char *argv[]) {
 
 		for( int igen = 0; igen < generators.size(); ++igen )
 		{
+			::scheme::util::PerfReport::ScopedTimer gen_timer( perf_report.get(), "generate_rif_" + str(igen), -1, omp_max_threads() );
+			uint64_t const nmotifs_before = rif_accum->n_motifs_found();
 			//cache the input 
 			generators[igen]->generate_rif( rif_accum, params );
+			if( perf_report ) perf_report->add_count( "generate_rif_" + str(igen), -1, "motifs_found", rif_accum->n_motifs_found() - nmotifs_before );
 		}
 		std::cout << "RifGenerators done" << std::endl;
 
@@ -904,10 +931,18 @@ int main(int argc, char *argv[]) {
 		uint64_t N_motifs_found = rif_accum->n_motifs_found();
 		// N_motifs_found += rif_accum->total_samples();
 		std::cout << "RIFAccumulator building rif...." << std::endl;
-		rif_accum->condense();
-		rif = rif_accum->rif();
-		// rif->set_xmap_ptr( rif_accum.rif_ );
-		rif_accum->clear();
+		{
+			::scheme::util::PerfReport::ScopedTimer condense_timer( perf_report.get(), "condense", -1, omp_max_threads() );
+			rif_accum->condense();
+			rif = rif_accum->rif();
+			// rif->set_xmap_ptr( rif_accum.rif_ );
+			rif_accum->clear();
+		}
+		if( perf_report ){
+			perf_report->add_count( "condense", -1, "motifs_found", N_motifs_found );
+			perf_report->add_count( "condense", -1, "rif_cells", rif->size() );
+			perf_report->add_count( "condense", -1, "rif_mem_use", rif->mem_use() );
+		}
 
 		cout << "RIF: " << " non0 in RIF: " << KMGT(rif->size()) << " N_motifs_found: "
 			  << KMGT(N_motifs_found) << " coverage: " << (double)N_motifs_found/rif->size() << ", mem_use: " << KMGT(rif->mem_use()) << endl;
@@ -916,7 +951,10 @@ int main(int argc, char *argv[]) {
 		     << ", sizeof(value_type) " << rif->sizeof_value_type() << endl;
 
 		cout << "sorting rotamers in each hash entry" << endl;
-		rif->finalize_rif();
+		{
+			::scheme::util::PerfReport::ScopedTimer finalize_timer( perf_report.get(), "finalize_rif", -1, omp_max_threads() );
+			rif->finalize_rif();
+		}
 		// __gnu_parallel::for_each( rif.map_.begin(), rif.map_.end(), call_sort_rotamers<XMap::Map::value_type> );
 		// __gnu_parallel::for_each( rif.map_.begin(), rif.map_.end(), assert_is_sorted  <XMap::Map::value_type> );
 
@@ -979,6 +1017,7 @@ int main(int argc, char *argv[]) {
 
 
 			// make bounding grids
+			::scheme::util::PerfReport::ScopedTimer save_timer( perf_report.get(), "save_rif_and_bounding_grids", -1, omp_max_threads() );
 			#ifdef USE_OPENMP
 			#pragma omp parallel for schedule(dynamic,1)
 			#endif
@@ -1159,6 +1198,15 @@ int main(int argc, char *argv[]) {
 	}
 
 
+	if( perf_report ){
+		std::string const perf_fname = option[rifgen::perf_report]();
+		if( perf_report->write( perf_fname ) ){
+			std::cout << "wrote performance report to " << perf_fname << std::endl;
+		} else {
+			std::cout << "WARNING: could not write performance report to " << perf_fname << std::endl;
+		}
+	}
+
 	std::cout << "rif_hier_DONE" << std::endl;
 	std::sort( bounding_grid_fnames.begin(), bounding_grid_fnames.end() );
 	std::reverse( bounding_grid_fnames.begin(), bounding_grid_fnames.end() );
@@ -0,0 +1,184 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington UW TechTransfer, email: license@u.washington.edu.
+
+#include <riflib/AsyncFileWriter.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <zlib.h>
+
+
+
+namespace devel {
+namespace scheme {
+
+namespace {
+
+bool
+is_gz( std::string const & fname ) {
+	return fname.size() >= 3 && fname.substr( fname.size()-3 ) == ".gz";
+}
+
+// handles are gzFile for .gz, FILE* otherwise
+void *
+open_output( std::string const & fname, bool append, int gz_level ) {
+	if ( is_gz( fname ) ) {
+		std::string mode = std::string( append ? "ab" : "wb" ) + std::to_string( std::max( 0, std::min( 9, gz_level ) ) );
+		return (void*)gzopen( fname.c_str(), mode.c_str() );
+	}
+	return (void*)std::fopen( fname.c_str(), append ? "ab" : "wb" );
+}
+
+bool
+write_output( std::string const & fname, void * handle, std::string const & content ) {
+	if ( content.empty() ) return true;
+	if ( is_gz( fname ) ) {
+		return gzwrite( (gzFile)handle, content.data(), content.size() ) == (int)content.size();
+	}
+	return std::fwrite( content.data(), 1, content.size(), (FILE*)handle ) == content.size();
+}
+
+bool
+close_output( std::string const & fname, void * handle ) {
+	if ( is_gz( fname ) ) return gzclose( (gzFile)handle ) == Z_OK;
+	return std::fclose( (FILE*)handle ) == 0;
+}
+
+}
+
+
+AsyncFileWriter::AsyncFileWriter( size_t max_queued_bytes, int gz_level ) :
+	max_queued_bytes_( max_queued_bytes ),
+	gz_level_( gz_level ),
+	queued_bytes_( 0 ),
+	busy_( false ),
+	done_( false ),
+	close_requested_( false ),
+	bytes_written_( 0 )
+{
+	thread_ = std::thread( &AsyncFileWriter::run, this );
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+	flush();
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		done_ = true;
+	}
+	cv_work_.notify_all();
+	thread_.join();
+}
+
+void
+AsyncFileWriter::write_file( std::string const & fname, std::string && content ) {
+	Job job;
+	job.fname = fname;
+	job.content = std::move( content );
+	job.append = false;
+	push( std::move( job ) );
+}
+
+void
+AsyncFileWriter::append( std::string const & fname, std::string && content ) {
+	Job job;
+	job.fname = fname;
+	job.content = std::move( content );
+	job.append = true;
+	push( std::move( job ) );
+}
+
+void
+AsyncFileWriter::push( Job && job ) {
+	{
+		std::unique_lock<std::mutex> lock( mutex_ );
+		// a single job bigger than the limit is let through once the queue is empty
+		cv_space_.wait( lock, [&]{ return queued_bytes_ == 0 || queued_bytes_ + job.content.size() <= max_queued_bytes_; } );
+		queued_bytes_ += job.content.size();
+		queue_.push_back( std::move( job ) );
+	}
+	cv_work_.notify_one();
+}
+
+std::vector<std::string>
+AsyncFileWriter::flush() {
+	std::unique_lock<std::mutex> lock( mutex_ );
+	close_requested_ = true;
+	cv_work_.notify_one();
+	cv_idle_.wait( lock, [&]{ return queue_.empty() && !busy_ && !close_requested_; } );
+	std::vector<std::string> errors;
+	errors.swap( errors_ );
+	return errors;
+}
+
+void
+AsyncFileWriter::run() {
+	std::unique_lock<std::mutex> lock( mutex_ );
+	while ( true ) {
+		cv_work_.wait( lock, [&]{ return done_ || close_requested_ || !queue_.empty(); } );
+		if ( !queue_.empty() ) {
+			Job job = std::move( queue_.front() );
+			queue_.pop_front();
+			busy_ = true;
+			lock.unlock();
+
+			bool ok = do_write( job );
+
+			lock.lock();
+			busy_ = false;
+			queued_bytes_ -= job.content.size();
+			if ( ok ) bytes_written_ += job.content.size();
+			else errors_.push_back( job.fname );
+			cv_space_.notify_all();
+			continue;
+		}
+		if ( close_requested_ ) {
+			lock.unlock();
+			close_appended();
+			lock.lock();
+			close_requested_ = false;
+			cv_idle_.notify_all();
+			continue;
+		}
+		if ( done_ ) break;
+	}
+}
+
+bool
+AsyncFileWriter::do_write( Job const & job ) {
+	if ( job.append ) {
+		void *& handle = open_appends_[ job.fname ];
+		if ( ! handle ) handle = open_output( job.fname, true, gz_level_ );
+		if ( ! handle ) {
+			open_appends_.erase( job.fname );
+			return false;
+		}
+		return write_output( job.fname, handle, job.content );
+	}
+	void * handle = open_output( job.fname, false, gz_level_ );
+	if ( ! handle ) return false;
+	bool ok = write_output( job.fname, handle, job.content );
+	ok &= close_output( job.fname, handle );
+	return ok;
+}
+
+void
+AsyncFileWriter::close_appended() {
+	std::vector<std::string> failed;
+	for ( auto & pair : open_appends_ ) {
+		if ( ! close_output( pair.first, pair.second ) ) failed.push_back( pair.first );
+	}
+	open_appends_.clear();
+	if ( failed.size() ) {
+		std::lock_guard<std::mutex> lock( mutex_ );
+		errors_.insert( errors_.end(), failed.begin(), failed.end() );
+	}
+}
+
+
+}}
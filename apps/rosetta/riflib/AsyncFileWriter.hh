@@ -0,0 +1,89 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington UW TechTransfer, email: license@u.washington.edu.
+
+#ifndef INCLUDED_riflib_AsyncFileWriter_hh
+#define INCLUDED_riflib_AsyncFileWriter_hh
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+// Background thread that writes finished output to disk so workers don't
+//  block on compression and IO.
+//
+// write_file() writes a whole file, append() adds to a file that stays open
+//  until flush(). Files ending in .gz are gzipped at gz_level (1 fast .. 9 small).
+//
+// The queue is bounded by bytes; producers block while it's over max_queued_bytes,
+//  so memory stays flat no matter how many results are written.
+//
+// Jobs are done in the order they were queued. Failures are collected and
+//  returned by flush() rather than thrown from the writer thread.
+
+class AsyncFileWriter {
+public:
+
+	AsyncFileWriter( size_t max_queued_bytes = 256ull<<20, int gz_level = 6 );
+	~AsyncFileWriter();
+
+	void write_file( std::string const & fname, std::string && content );
+	void append( std::string const & fname, std::string && content );
+
+	// wait until everything queued is on disk, close appended files,
+	//  return and clear the failures so far
+	std::vector<std::string> flush();
+
+	size_t bytes_written() const { return bytes_written_; }
+
+private:
+
+	struct Job {
+		std::string fname;
+		std::string content;
+		bool append;
+	};
+
+	void push( Job && job );
+	void run();
+	bool do_write( Job const & job );
+	void close_appended();
+
+	AsyncFileWriter( AsyncFileWriter const & );
+	AsyncFileWriter & operator=( AsyncFileWriter const & );
+
+	size_t max_queued_bytes_;
+	int gz_level_;
+
+	std::mutex mutex_;
+	std::condition_variable cv_work_, cv_space_, cv_idle_;
+	std::deque<Job> queue_;
+	size_t queued_bytes_;
+	bool busy_, done_, close_requested_;
+	std::vector<std::string> errors_;
+	size_t bytes_written_;
+
+	// only touched by the writer thread
+	std::map<std::string,void*> open_appends_;
+
+	std::thread thread_;
+};
+
+
+}}
+
+#endif
@@ -443,14 +443,26 @@ BurialManager::get_burial_count(
 
 std::vector<float>
 BurialManager::get_burial_weights( EigenXform const & scaff_transform, shared_ptr<BurialVoxelArray> const & scaff_grid) const {
+    std::vector<float> weights;
+    get_burial_weights( scaff_transform, scaff_grid, weights );
+    return weights;
+}
+
+void
+BurialManager::get_burial_weights(
+    EigenXform const & scaff_transform,
+    shared_ptr<BurialVoxelArray> const & scaff_grid,
+    std::vector<float> & weights
+) const {
 
     EigenXform const & scaff_inv_transform = scaff_transform.inverse();
-    std::vector<float> weights( target_burial_points_.size() );
+    const float scaff_scale = opts_.target_burial_cutoff / opts_.scaffold_burial_cutoff;
+    weights.resize( target_burial_points_.size() );
 
 
     for ( int i_pt = 0; i_pt < target_burial_points_.size(); i_pt ++ ) {
 
-        const float burial_count = get_burial_count( target_burial_points_[i_pt], scaff_inv_transform, scaff_grid ) 
+        const float burial_count = burial_lookup( target_burial_points_[i_pt], target_burial_grid_, scaff_inv_transform, scaff_grid, scaff_scale )
                                     - unburial_adjust_[i_pt];
 
         // if (debug_) std::cout << "Burial: iheavy: " << i_pt << " count: " << burial_count << std::endl;
@@ -458,8 +470,6 @@ BurialManager::get_burial_weights( EigenXform const & scaff_transform, shared_pt
         weights[i_pt] = burial;
     }
 
-
-    return weights;
 }
 
 // void
@@ -116,6 +116,15 @@ struct BurialManager {
     std::vector<float>
     get_burial_weights( EigenXform const & scaff_transform, shared_ptr<BurialVoxelArray> const & scaff_grid) const;
 
+    // Same, but into a caller owned buffer so the packing loop doesn't allocate.
+    //  After setup the manager is read-only, threads can share one instance.
+    void
+    get_burial_weights(
+        EigenXform const & scaff_transform,
+        shared_ptr<BurialVoxelArray> const & scaff_grid,
+        std::vector<float> & weights
+    ) const;
+
 
     float
     get_burial_count( 
@@ -39,6 +39,7 @@ namespace scheme {
 struct CBTooCloseManager {
 
     float resl_;
+    float penalty_;
 
     shared_ptr<::scheme::objective::voxel::VoxelArray<3>> voxel_array_;
 
@@ -51,7 +52,7 @@ struct CBTooCloseManager {
         float too_close_dist,
         float penalty,
         size_t max_target_res_atom_idx
-    ) : resl_( resl )
+    ) : resl_( resl ), penalty_( penalty )
     {
         std::cout << "Creating CB too close grid" << std::endl;
         prepare_bounds( target, too_close_dist, max_target_res_atom_idx );
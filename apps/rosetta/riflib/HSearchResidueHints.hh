@@ -0,0 +1,60 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington UW TechTransfer, email: license@u.washington.edu.
+
+#ifndef INCLUDED_riflib_HSearchResidueHints_hh
+#define INCLUDED_riflib_HSearchResidueHints_hh
+
+#include <stdint.h>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+// Per-thread side channel into ScoreBBActorVsRIF for the hierarchical search.
+//
+// record_hits: while set, every scaffold residue whose rif probe returned at least
+//  one rotamer gets its bit set. Used to summarize a parent sample.
+// probe_only: while set, residues whose bit is clear are not probed at all and
+//  contribute 0. Used when scoring the children of that parent.
+//
+// Skipping relies on the coarse rifs bounding the finer ones: a residue with an
+//  empty rif cell at the parent resolution has an empty cell for every child.
+//
+// Masks are one bit per scaffold-local residue (BBActor::index_), words() uint64s long.
+
+struct HSearchResidueHints {
+
+	struct Slot {
+		uint64_t const * probe_only;
+		uint64_t * record_hits;
+		Slot() : probe_only( nullptr ), record_hits( nullptr ) {}
+	} __attribute__((aligned(64)));
+
+	HSearchResidueHints( int nthreads ) : slots_( nthreads < 1 ? 1 : nthreads ) {}
+
+	Slot & slot( int ithread ) { return slots_.at( ithread ); }
+	Slot const & slot( int ithread ) const { return slots_.at( ithread ); }
+
+	void clear() { for ( Slot & s : slots_ ) s = Slot(); }
+
+	static int words( int nres ) { return ( nres + 63 ) / 64; }
+
+	static bool test( uint64_t const * mask, int ires ) { return ( mask[ires>>6] >> (ires&63) ) & 1; }
+	static void set( uint64_t * mask, int ires ) { mask[ires>>6] |= uint64_t(1) << (ires&63); }
+
+private:
+	std::vector<Slot> slots_;
+};
+
+
+}}
+
+#endif
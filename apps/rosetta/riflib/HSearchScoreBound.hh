@@ -0,0 +1,91 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington UW TechTransfer, email: license@u.washington.edu.
+
+#ifndef INCLUDED_riflib_HSearchScoreBound_hh
+#define INCLUDED_riflib_HSearchScoreBound_hh
+
+#include <riflib/types.hh>
+
+#include <algorithm>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+// Side channel into ScoreBBActorVsRIF that lets the hierarchical search give up on
+//  samples that can no longer make the beam.
+//
+// cutoff: while below NO_CUTOFF, ScoreBBActorVsRIF keeps a running sum of its per residue
+//  scores plus the best any of the remaining residues could still add. Once that exceeds
+//  cutoff the rest of the residues aren't probed, the slot's bounded flag is set and the
+//  sample scores 9e9.
+//
+// The best a residue can add is its lowest onebody energy plus the lowest score the rif can
+//  store. The other terms start out at their own floor, for the clash grids the lowest voxel
+//  of each grid times the atoms scored against it, see ScoreBBActorVsRIF::other_terms_floor.
+//  Scenes with terms that have no floor aren't bounded, so a bounded sample really can't make the cut.
+//
+// best_onebody is cached per thread and recomputed whenever the scaffold's onebody table changes.
+
+struct HSearchScoreBound {
+
+	static constexpr float NO_CUTOFF = 9e9;
+
+	struct Slot {
+		bool bounded;
+		shared_ptr< std::vector< std::vector<float> > const > onebody;
+		std::vector<float> best_onebody;
+		Slot() : bounded( false ) {}
+	} __attribute__((aligned(64)));
+
+	HSearchScoreBound( int nthreads ) : cutoff_( NO_CUTOFF ), slots_( nthreads < 1 ? 1 : nthreads ) {}
+
+	Slot & slot( int ithread ) { return slots_.at( ithread ); }
+	Slot const & slot( int ithread ) const { return slots_.at( ithread ); }
+
+	// only change between parallel regions
+	void set_cutoff( float cutoff ) { cutoff_ = cutoff; }
+	float cutoff() const { return cutoff_; }
+	bool active() const { return cutoff_ < NO_CUTOFF; }
+
+	void clear() {
+		cutoff_ = NO_CUTOFF;
+		for ( Slot & s : slots_ ) s.bounded = false;
+	}
+
+	// lowest onebody energy of each residue of this table, cached in the slot
+	static std::vector<float> const &
+	best_onebody( Slot & s, shared_ptr< std::vector< std::vector<float> > const > const & onebody ) {
+		if ( s.onebody != onebody ) {
+			s.onebody = onebody;
+			s.best_onebody.resize( onebody->size() );
+			for ( size_t ires = 0; ires < onebody->size(); ires++ ) {
+				std::vector<float> const & rots = onebody->at(ires);
+				s.best_onebody[ires] = rots.empty() ? 0 : *std::min_element( rots.begin(), rots.end() );
+			}
+		}
+		return s.best_onebody;
+	}
+
+	// ScoreBBActorVsRIF only ever lowers the score by min( 0, onebody + rif score )
+	static float residue_floor( float best_onebody, float rif_floor ) {
+		return std::min( 0.0f, best_onebody + rif_floor );
+	}
+
+private:
+	float cutoff_;
+	std::vector<Slot> slots_;
+};
+
+
+}}
+
+#endif
@@ -13,7 +13,7 @@
 #include <riflib/types.hh>
 #include <riflib/rifdock_typedefs.hh>
 
-#include "scheme/util/SimpleArray.hh"
+#include "scheme/objective/voxel/VoxelLists.hh"
 #include <riflib/RotamerGenerator.hh>
 #include <riflib/ScoreRotamerVsTarget.hh>
 
@@ -59,12 +59,13 @@ struct HydrophobicManager {
     typedef uint16_t Hyd;
     static int const CACHE_MAX_HYD = std::numeric_limits<Hyd>::max();
 
-    typedef ::scheme::util::SimpleArray<3,size_t> Indices;
     typedef Eigen::Vector3f Bounds;
     Bounds lb_,ub_,cs_;
 
+    // Hyds near each voxel, terminated by CACHE_MAX_HYD
+    typedef ::scheme::objective::voxel::VoxelLists<Hyd> HydLists;
+
     const float max_interaction_range_ = 7.0;   // It's actually 6.0, but just to be safe
-    size_t max_hyds_;
 
     const std::set<char> hydrophobic_name1s_ {'A', 'C', 'F', 'I', 'L', 'M', 'P', 'T', 'V', 'W', 'Y'}; 
     std::vector<core::Size> hydrophobic_res_;
@@ -75,25 +76,16 @@ struct HydrophobicManager {
     std::vector<bool> rif_pi_map_;
 
 
-    std::vector<Hyd> voxel_map_;
-
-    // This only actually needs 1. But include a few extra in case it accidentally gets written to
-    std::vector<Hyd> OOB_LIST = {CACHE_MAX_HYD, CACHE_MAX_HYD, CACHE_MAX_HYD, CACHE_MAX_HYD, CACHE_MAX_HYD, CACHE_MAX_HYD};
-
-    Indices shape_;
+    HydLists hyd_lists_;
 
 
     Bounds cat_lb_,cat_ub_,cat_cs_;
     std::vector<core::Size> cation_res_;
-    std::vector<Hyd> cation_voxel_map_;
-    Indices cation_shape_;
-    size_t cation_max_hyds_;
+    HydLists cation_lists_;
 
     Bounds lig_lb_,lig_ub_,lig_cs_;
     std::vector<std::vector<std::pair<core::Size, core::Size>>> lig_res_;
-    std::vector<Hyd> lig_voxel_map_;
-    Indices lig_shape_;
-    size_t lig_max_hyds_;
+    HydLists lig_lists_;
 
 
     shared_ptr< RotamerIndex > rot_index_p;
@@ -120,10 +112,7 @@ struct HydrophobicManager {
         std::vector<std::string> const & ligand_hyd_res,
         bool dump_voxels
     ) : 
-    rot_index_p( rot_index_p_in ),
-    shape_(Indices(0, 0, 0)),
-    cation_shape_(Indices(0, 0, 0)),
-    lig_shape_(Indices(0, 0, 0))
+    rot_index_p( rot_index_p_in )
     {
 
         rif_atype_map_ = get_rif_atype_map();
@@ -133,30 +122,27 @@ struct HydrophobicManager {
 
         identify_hydrophobic_residues( target, target_res );
         prepare_bounds( target );
-        std::vector<std::vector<Hyd>> early_map = first_pass_fill( target );
-        create_and_fill_voxel_map( early_map );
+        fill( target );
 
 
         identify_cation_residues( target, target_res );
         if ( cation_res_.size() > 0 ) {
             cation_prepare_bounds( target );
-            std::vector<std::set<Hyd>> cation_early_map = cation_first_pass_fill( target );
-            cation_create_and_fill_voxel_map( cation_early_map );
+            cation_fill( target );
         }
 
         if ( ligand_hyd_res.size() > 0 ) {
 
             lig_parse_hyd( target, ligand_hyd_res );
             lig_prepare_bounds( target );
-            std::vector<std::vector<Hyd>> lig_early_map = lig_first_pass_fill( target );
-            lig_create_and_fill_voxel_map( lig_early_map );
+            lig_fill( target );
         }
 
 
         if ( dump_voxels ) {
-            dump_filled_voxels("hyd_voxels.pdb", shape_, voxel_map_, max_hyds_, lb_, cs_ );
-            dump_filled_voxels("cation_voxels.pdb", cation_shape_, cation_voxel_map_, cation_max_hyds_, cat_lb_, cat_cs_ );
-            dump_filled_voxels("lig_voxels.pdb", lig_shape_, lig_voxel_map_, lig_max_hyds_, lig_lb_, lig_cs_ );
+            dump_filled_voxels("hyd_voxels.pdb", hyd_lists_ );
+            dump_filled_voxels("cation_voxels.pdb", cation_lists_ );
+            dump_filled_voxels("lig_voxels.pdb", lig_lists_ );
         }
 
 
@@ -246,23 +232,14 @@ struct HydrophobicManager {
         ub_ = ubs;
         cs_ = Eigen::Vector3f( 0.5, 0.5, 0.5 );
 
-        Indices extents = floats_to_index( ub_ );
-        shape_ = extents + Indices(1);
+        hyd_lists_ = HydLists( lb_, ub_, cs_ );
 
     }
 
-    std::vector<std::vector<Hyd>>
-    first_pass_fill( core::pose::Pose const & target ) {
-
-        std::vector<std::vector<Hyd>> early_map;
-
-        size_t elements = shape_[0] * shape_[1] * shape_[2];
-        // std::cout << shape_ << std::endl;
-        // std::cout << floats_to_index( ub_ ) << std::endl;
-        // std::cout << elements << " " << index_to_map_index( floats_to_index( ub_ ) ) << std::endl;
-        runtime_assert( elements - 1 == index_to_map_index( floats_to_index( ub_ ) ) );
+    void
+    fill( core::pose::Pose const & target ) {
 
-        early_map.resize(elements);
+        runtime_assert( hyd_lists_.cell_of( ub_ ) == hyd_lists_.ncells() - 1 );
 
         for ( Hyd ihyd = 0; ihyd < hydrophobic_res_.size(); ihyd++ ) {
             core::conformation::Residue const & res = target.residue(hydrophobic_res_[ihyd]);
@@ -301,12 +278,10 @@ struct HydrophobicManager {
                             if ( squared_dist < low_rad_sq ) {
                                 // do nothing
                             } else if ( squared_dist < med_rad_sq ) {
-                                size_t offset = index_to_map_index( floats_to_index( worker ) );
-                                early_map.at(offset).push_back( ihyd );
-                                // early_map.at(offset).push_back( ihyd );
+                                hyd_lists_.add_at( worker, ihyd );
+                                // hyd_lists_.add_at( worker, ihyd );
                             } else if ( squared_dist < long_rad_sq ) {
-                                size_t offset = index_to_map_index( floats_to_index( worker ) );
-                                early_map.at(offset).push_back( ihyd );
+                                hyd_lists_.add_at( worker, ihyd );
                             } else {
                                 // do nothing
                             }
@@ -315,43 +290,9 @@ struct HydrophobicManager {
                 }
             }
         }
-        return early_map;
-    }
-
-
-
-    void
-    create_and_fill_voxel_map( std::vector<std::vector<Hyd>> const & early_map ) {
-
-        max_hyds_ = 0;
-
-        for ( std::vector<Hyd> these_hyds : early_map ) {
-            max_hyds_ = std::max<size_t>( max_hyds_, these_hyds.size() );
-        }
-
-        std::cout << "Max hydrophobics at one voxel: " << max_hyds_ << std::endl;
-
-        // max_hyds_ is 1 too big. This means that the receiver can always loop until they hit a CACHE_MAX_HYD
-        max_hyds_ += 1;
+        hyd_lists_.build();
 
-        voxel_map_.resize( max_hyds_ * shape_[0] * shape_[1] * shape_[2], CACHE_MAX_HYD );
-
-        // We already asserted the two maps have the same size, so just array fill
-        for ( size_t imap = 0; imap < early_map.size(); imap++ ) {
-
-            std::vector<Hyd> these_hyds = early_map[imap];
-            bool wrote_a_null = false;
-            for ( size_t idx = 0; idx < max_hyds_; idx++ ) {
-                size_t offset = imap * max_hyds_ + idx;
-                if ( idx < these_hyds.size() ) {
-                    voxel_map_.at(offset) = these_hyds.at(idx);
-                } else {
-                    voxel_map_.at(offset) = CACHE_MAX_HYD;
-                    wrote_a_null = true;
-                }
-            }
-            runtime_assert( wrote_a_null );     // Redundancy. Make sure each list is terminated
-        }
+        std::cout << "Max hydrophobics at one voxel: " << hyd_lists_.max_list_size() << std::endl;
     }
 
 ///////////////////////////// CATION PI ////////////////////////////
@@ -398,23 +339,14 @@ struct HydrophobicManager {
         cat_ub_ = ubs;
         cat_cs_ = Eigen::Vector3f( 0.5, 0.5, 0.5 );
 
-        Indices extents = cation_floats_to_index( cat_ub_ );
-        cation_shape_ = extents + Indices(1);
+        cation_lists_ = HydLists( cat_lb_, cat_ub_, cat_cs_ );
 
     }
 
-    std::vector<std::set<Hyd>>
-    cation_first_pass_fill( core::pose::Pose const & target ) {
-
-        std::vector<std::set<Hyd>> early_map;
-
-        size_t elements = cation_shape_[0] * cation_shape_[1] * cation_shape_[2];
-        // std::cout << shape_ << std::endl;
-        // std::cout << floats_to_index( ub_ ) << std::endl;
-        // std::cout << elements << " " << index_to_map_index( floats_to_index( ub_ ) ) << std::endl;
-        runtime_assert( elements - 1 == cation_index_to_map_index( cation_floats_to_index( cat_ub_ ) ) );
+    void
+    cation_fill( core::pose::Pose const & target ) {
 
-        early_map.resize(elements);
+        runtime_assert( cation_lists_.cell_of( cat_ub_ ) == cation_lists_.ncells() - 1 );
 
         for ( Hyd ihyd = 0; ihyd < cation_res_.size(); ihyd++ ) {
             core::conformation::Residue const & res = target.residue(cation_res_[ihyd]);
@@ -486,8 +418,7 @@ struct HydrophobicManager {
                                             cy1_p1_min_p2_norm                       <= radius
                                                     ) {
 
-                            size_t offset = cation_index_to_map_index( cation_floats_to_index( worker ) );
-                            early_map.at(offset).insert( ihyd );
+                            cation_lists_.add_at( worker, ihyd );
 
                         }
                         }
@@ -504,8 +435,7 @@ struct HydrophobicManager {
                                             cy2_p1_min_p2_norm                       <= radius
                                                     ) {
 
-                            size_t offset = cation_index_to_map_index( cation_floats_to_index( worker ) );
-                            early_map.at(offset).insert( ihyd );
+                            cation_lists_.add_at( worker, ihyd );
 
                         }
                         }
@@ -516,49 +446,10 @@ struct HydrophobicManager {
             }
             
         }
-        return early_map;
-    }
-
-
-
-    void
-    cation_create_and_fill_voxel_map( std::vector<std::set<Hyd>> const & early_map ) {
-
-        cation_max_hyds_ = 0;
-
-        for ( std::set<Hyd> these_hyds : early_map ) {
-            cation_max_hyds_ = std::max<size_t>( cation_max_hyds_, these_hyds.size() );
-        }
-
-        std::cout << "Max cations at one voxel: " << cation_max_hyds_ << std::endl;
-
-        // max_hyds_ is 1 too big. This means that the receiver can always loop until they hit a CACHE_MAX_HYD
-        cation_max_hyds_ += 1;
-
-        cation_voxel_map_.resize( cation_max_hyds_ * cation_shape_[0] * cation_shape_[1] * cation_shape_[2], CACHE_MAX_HYD );
-
-        // We already asserted the two maps have the same size, so just array fill
-        for ( size_t imap = 0; imap < early_map.size(); imap++ ) {
-
-            std::set<Hyd> these_hyds_set = early_map[imap];
-            std::vector<Hyd> these_hyds;
-            for ( Hyd hyd : these_hyds_set ) {
-                these_hyds.push_back(hyd);
-            }
+        // an arg can cover a voxel from several samples, only count it once
+        cation_lists_.build( true );
 
-
-            bool wrote_a_null = false;
-            for ( size_t idx = 0; idx < cation_max_hyds_; idx++ ) {
-                size_t offset = imap * cation_max_hyds_ + idx;
-                if ( idx < these_hyds.size() ) {
-                    cation_voxel_map_.at(offset) = these_hyds.at(idx);
-                } else {
-                    cation_voxel_map_.at(offset) = CACHE_MAX_HYD;
-                    wrote_a_null = true;
-                }
-            }
-            runtime_assert( wrote_a_null );     // Redundancy. Make sure each list is terminated
-        }
+        std::cout << "Max cations at one voxel: " << cation_lists_.max_list_size() << std::endl;
     }
 
 
@@ -645,23 +536,14 @@ struct HydrophobicManager {
         lig_ub_ = ubs;
         lig_cs_ = Eigen::Vector3f( 0.5, 0.5, 0.5 );
 
-        Indices extents = lig_floats_to_index( lig_ub_ );
-        lig_shape_ = extents + Indices(1);
+        lig_lists_ = HydLists( lig_lb_, lig_ub_, lig_cs_ );
 
     }
 
-    std::vector<std::vector<Hyd>>
-    lig_first_pass_fill( core::pose::Pose const & target ) {
-
-        std::vector<std::vector<Hyd>> early_map;
-
-        size_t elements = lig_shape_[0] * lig_shape_[1] * lig_shape_[2];
-        // std::cout << shape_ << std::endl;
-        // std::cout << floats_to_index( ub_ ) << std::endl;
-        // std::cout << elements << " " << index_to_map_index( floats_to_index( ub_ ) ) << std::endl;
-        runtime_assert( elements - 1 == lig_index_to_map_index( lig_floats_to_index( lig_ub_ ) ) );
+    void
+    lig_fill( core::pose::Pose const & target ) {
 
-        early_map.resize(elements);
+        runtime_assert( lig_lists_.cell_of( lig_ub_ ) == lig_lists_.ncells() - 1 );
 
         
         for ( Hyd ihyd = 0; ihyd < lig_res_.size(); ihyd++ ) {
@@ -703,12 +585,10 @@ struct HydrophobicManager {
                             if ( squared_dist < low_rad_sq ) {
                                 // do nothing
                             } else if ( squared_dist < med_rad_sq ) {
-                                size_t offset = lig_index_to_map_index( lig_floats_to_index( worker ) );
-                                early_map.at(offset).push_back( ihyd );
+                                lig_lists_.add_at( worker, ihyd );
                                 // early_map.at(offset).push_back( ihyd );
                             } else if ( squared_dist < long_rad_sq ) {
-                                size_t offset = lig_index_to_map_index( lig_floats_to_index( worker ) );
-                                early_map.at(offset).push_back( ihyd );
+                                lig_lists_.add_at( worker, ihyd );
                             } else {
                                 // do nothing
                             }
@@ -717,44 +597,9 @@ struct HydrophobicManager {
                 }
             }
         }
-        return early_map;
-    }
-
-
-
-    void
-    lig_create_and_fill_voxel_map( std::vector<std::vector<Hyd>> const & early_map ) {
-
-        lig_max_hyds_ = 0;
+        lig_lists_.build();
 
-        for ( std::vector<Hyd> these_hyds : early_map ) {
-            lig_max_hyds_ = std::max<size_t>( lig_max_hyds_, these_hyds.size() );
-        }
-
-        std::cout << "Max ligand hydrophobics at one voxel: " << lig_max_hyds_ << std::endl;
-
-        // max_hyds_ is 1 too big. This means that the receiver can always loop until they hit a CACHE_MAX_HYD
-        lig_max_hyds_ += 1;
-
-        lig_voxel_map_.resize( lig_max_hyds_ * lig_shape_[0] * lig_shape_[1] * lig_shape_[2], CACHE_MAX_HYD );
-
-        // We already asserted the two maps have the same size, so just array fill
-        for ( size_t imap = 0; imap < early_map.size(); imap++ ) {
-
-            std::vector<Hyd> these_hyds = early_map[imap];
-
-            bool wrote_a_null = false;
-            for ( size_t idx = 0; idx < lig_max_hyds_; idx++ ) {
-                size_t offset = imap * lig_max_hyds_ + idx;
-                if ( idx < these_hyds.size() ) {
-                    lig_voxel_map_.at(offset) = these_hyds.at(idx);
-                } else {
-                    lig_voxel_map_.at(offset) = CACHE_MAX_HYD;
-                    wrote_a_null = true;
-                }
-            }
-            runtime_assert( wrote_a_null );     // Redundancy. Make sure each list is terminated
-        }
+        std::cout << "Max ligand hydrophobics at one voxel: " << lig_lists_.max_list_size() << std::endl;
     }
 
 
@@ -782,7 +627,7 @@ struct HydrophobicManager {
             if ( ! rif_hydrophobic_map_.at(atom.type()) ) continue;
             typename Atom::Position pos = bbpos * atom.position();
 
-            std::vector<Hyd>::const_iterator hyds_iter = this->at( pos );
+            Hyd const * hyds_iter = this->at( pos );
 
             Hyd this_hyd = 0;
             while ( (this_hyd = *(hyds_iter++)) != CACHE_MAX_HYD ) {
@@ -790,7 +635,7 @@ struct HydrophobicManager {
             }
 
             if ( lig_res_.size() > 0 ) {
-                std::vector<Hyd>::const_iterator lig_hyds_iter = this->lig_at( pos );
+                Hyd const * lig_hyds_iter = this->lig_at( pos );
 
                 Hyd lig_this_hyd = 0;
                 while ( (lig_this_hyd = *(lig_hyds_iter++)) != CACHE_MAX_HYD ) {
@@ -850,7 +695,7 @@ struct HydrophobicManager {
                 typename Atom::Position pos = bbpos * atom.position();
 
                 // STANDARD
-                std::vector<Hyd>::const_iterator hyds_iter = this->at( pos );
+                Hyd const * hyds_iter = this->at( pos );
 
                 Hyd this_hyd = 0;
                 while ( (this_hyd = *(hyds_iter++)) != CACHE_MAX_HYD ) {
@@ -865,7 +710,7 @@ struct HydrophobicManager {
 
                 // LIGAND
                 if ( lig_res_.size() > 0 ) {
-                    std::vector<Hyd>::const_iterator lig_hyds_iter = this->lig_at( pos );
+                    Hyd const * lig_hyds_iter = this->lig_at( pos );
 
                     Hyd lig_this_hyd = 0;
                     while ( (lig_this_hyd = *(lig_hyds_iter++)) != CACHE_MAX_HYD ) {
@@ -969,7 +814,7 @@ struct HydrophobicManager {
 
                     typename Atom::Position pos = bbpos * atom.position();
 
-                    std::vector<Hyd>::const_iterator hyds_iter = this->cat_at( pos );
+                    Hyd const * hyds_iter = this->cat_at( pos );
 
                     Hyd this_hyd = 0;
                     while ( (this_hyd = *(hyds_iter++)) != CACHE_MAX_HYD ) {
@@ -1042,147 +887,37 @@ struct HydrophobicManager {
 
 
 
-    template<class Floats> Indices floats_to_index(Floats const & f) const {
-        Indices ind;
-        for(int i = 0; i < 3; ++i){
-            float tmp = ((f[i]-lb_[i])/cs_[i]);
-            ind[i] = tmp;
-        }
-        return ind;
-    }
-
-    size_t index_to_map_index( Indices const & ind ) const {
-
-        size_t accum = ind[0];
-        accum = accum * shape_[1] + ind[1];
-        accum = accum * shape_[2] + ind[2];
-
-        return accum;
-
-    }
-
-    size_t index_to_offset( Indices const & ind ) const {
-
-        return index_to_map_index( ind ) * max_hyds_;
-
-    }
-
-
-
-
-    template<class Floats> Indices cation_floats_to_index(Floats const & f) const {
-        Indices ind;
-        for(int i = 0; i < 3; ++i){
-            float tmp = ((f[i]-cat_lb_[i])/cat_cs_[i]);
-            ind[i] = tmp;
-        }
-        return ind;
-    }
-
-    size_t cation_index_to_map_index( Indices const & ind ) const {
-
-        size_t accum = ind[0];
-        accum = accum * cation_shape_[1] + ind[1];
-        accum = accum * cation_shape_[2] + ind[2];
-
-        return accum;
-
-    }
-
-    size_t cation_index_to_offset( Indices const & ind ) const {
-
-        return cation_index_to_map_index( ind ) * cation_max_hyds_;
-
-    }
-
-
-    template<class Floats> Indices lig_floats_to_index(Floats const & f) const {
-        Indices ind;
-        for(int i = 0; i < 3; ++i){
-            float tmp = ((f[i]-lig_lb_[i])/lig_cs_[i]);
-            ind[i] = tmp;
-        }
-        return ind;
-    }
-
-    size_t lig_index_to_map_index( Indices const & ind ) const {
-
-        size_t accum = ind[0];
-        accum = accum * lig_shape_[1] + ind[1];
-        accum = accum * lig_shape_[2] + ind[2];
-
-        return accum;
-
-    }
-
-    size_t lig_index_to_offset( Indices const & ind ) const {
-
-        return lig_index_to_map_index( ind ) * lig_max_hyds_;
-
-    }
-    // template<class Floats>
-    // std::vector<Hyd>::const_iterator
-    // operator[](Floats const & floats) const { 
-    //     Indices ind = floats_to_index(floats);
-    //     return voxel_map_.cbegin() + index_to_offset(ind);
-    // }
-
-    // template<class Floats>
-    // std::vector<Hyd>::iterator
-    // operator[](Floats const & floats){
-    //     Indices ind = floats_to_index(floats);
-    //     return voxel_map_.begin() + index_to_offset(ind);
-    // }
-
-    std::vector<Hyd>::const_iterator 
+    Hyd const *
     at( float f, float g, float h ) const {
-        Indices idx = floats_to_index( Bounds( f, g, h ) );
-        if( idx[0] < shape_[0] && idx[1] < shape_[1] && idx[2] < shape_[2] )
-            return voxel_map_.cbegin() + index_to_offset(idx);
-        else return OOB_LIST.cbegin();
+        return hyd_lists_.at( f, g, h );
     }
 
     template<class V>
-    std::vector<Hyd>::const_iterator
+    Hyd const *
     at( V const & v ) const {
-        Indices idx = floats_to_index( Bounds( v[0], v[1], v[2] ) );
-        if( idx[0] < shape_[0] && idx[1] < shape_[1] && idx[2] < shape_[2] )
-            return voxel_map_.cbegin() + index_to_offset(idx);
-        else return OOB_LIST.cbegin();
+        return hyd_lists_.at( v );
     }
 
-    std::vector<Hyd>::const_iterator 
+    Hyd const *
     cat_at( float f, float g, float h ) const {
-        Indices idx = cation_floats_to_index( Bounds( f, g, h ) );
-        if( idx[0] < cation_shape_[0] && idx[1] < cation_shape_[1] && idx[2] < cation_shape_[2] )
-            return cation_voxel_map_.cbegin() + cation_index_to_offset(idx);
-        else return OOB_LIST.cbegin();
+        return cation_lists_.at( f, g, h );
     }
 
     template<class V>
-    std::vector<Hyd>::const_iterator
+    Hyd const *
     cat_at( V const & v ) const {
-        Indices idx = cation_floats_to_index( Bounds( v[0], v[1], v[2] ) );
-        if( idx[0] < cation_shape_[0] && idx[1] < cation_shape_[1] && idx[2] < cation_shape_[2] )
-            return cation_voxel_map_.cbegin() + cation_index_to_offset(idx);
-        else return OOB_LIST.cbegin();
+        return cation_lists_.at( v );
     }
 
-    std::vector<Hyd>::const_iterator 
+    Hyd const *
     lig_at( float f, float g, float h ) const {
-        Indices idx = lig_floats_to_index( Bounds( f, g, h ) );
-        if( idx[0] < lig_shape_[0] && idx[1] < lig_shape_[1] && idx[2] < lig_shape_[2] )
-            return lig_voxel_map_.cbegin() + lig_index_to_offset(idx);
-        else return OOB_LIST.cbegin();
+        return lig_lists_.at( f, g, h );
     }
 
     template<class V>
-    std::vector<Hyd>::const_iterator
+    Hyd const *
     lig_at( V const & v ) const {
-        Indices idx = lig_floats_to_index( Bounds( v[0], v[1], v[2] ) );
-        if( idx[0] < lig_shape_[0] && idx[1] < lig_shape_[1] && idx[2] < lig_shape_[2] )
-            return lig_voxel_map_.cbegin() + lig_index_to_offset(idx);
-        else return OOB_LIST.cbegin();
+        return lig_lists_.at( v );
     }
 
 
@@ -1190,25 +925,20 @@ struct HydrophobicManager {
 
 
     void
-    dump_filled_voxels( std::string const & fname, Indices const & shape, std::vector<Hyd> const & map,
-                int max_hyds, Bounds const & lb, Bounds const & cs ) {
+    dump_filled_voxels( std::string const & fname, HydLists const & lists ) {
 
         core::Size iatom = 1;
 
         std::ofstream out( fname );
 
+        HydLists::Indices const & shape = lists.shape();
         for ( core::Size ix = 0; ix < shape[0]; ix++ ) {
-            float x = (ix + 0.5)*cs[0] + lb[0];
             for ( core::Size iy = 0; iy < shape[1]; iy++ ) {
-                float y = (iy + 0.5)*cs[1] + lb[1];
                 for ( core::Size iz = 0; iz < shape[2]; iz++ ) {
-                    float z = (iz + 0.5)*cs[2] + lb[2];
-
-                    size_t accum = ix;
-                    accum = accum * shape[1] + iy;
-                    accum = accum * shape[2] + iz;
-
-                    if ( map.at( accum * max_hyds) != CACHE_MAX_HYD ) {
+                    HydLists::Indices idx( ix, iy, iz );
+                    if ( lists.list_size( lists.index_to_cell( idx ) ) > 0 ) {
+                        HydLists::Bounds xyz = lists.cell_center( idx );
+                        float x = xyz[0], y = xyz[1], z = xyz[2];
                         char buf[128];
                         snprintf(buf,128,"%s%5i %4s %3s %c%4i    %8.3f%8.3f%8.3f%6.2f%6.2f %11s\n",
                             "HETATM",
@@ -102,6 +102,10 @@ struct RifBase
 
 	virtual void finalize_rif() = 0;
 
+    // cache-resident bloom filter checked before the main map, most rif misses never touch the map
+    virtual void build_occupancy_filter( float bits_per_key ) = 0;
+    virtual size_t occupancy_filter_mem_use() const = 0;
+
     virtual RifBaseKeyRange key_range() const = 0;
     
     // To randomly dump rif residues defined by res names, and "*" means all 20 amino acids.
@@ -0,0 +1,192 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+
+#include <riflib/RifBatchScorer.hh>
+
+#include <riflib/RifFactory.hh>
+#include <riflib/rifdock_typedefs.hh>
+#include <riflib/rosetta_field.hh>
+#include <riflib/util.hh>
+
+#include <core/import_pose/import_pose.hh>
+#include <core/pose/Pose.hh>
+
+#include <exception>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+
+
+namespace devel {
+namespace scheme {
+
+
+namespace {
+
+EigenXform
+xform_from_rowmajor( double const * m ) {
+    EigenXform x = EigenXform::Identity();
+    for ( int i = 0; i < 3; i++ ) {
+        for ( int j = 0; j < 3; j++ ) x.linear()(i,j) = m[4*i+j];
+        x.translation()[i] = m[4*i+3];
+    }
+    return x;
+}
+
+void
+xform_to_rowmajor( EigenXform const & x, double * m ) {
+    for ( int i = 0; i < 3; i++ ) {
+        for ( int j = 0; j < 3; j++ ) m[4*i+j] = x.linear()(i,j);
+        m[4*i+3] = x.translation()[i];
+    }
+    m[12] = m[13] = m[14] = 0;
+    m[15] = 1;
+}
+
+}
+
+
+RifBatchScorer::RifBatchScorer( RifBatchScorerOpts const & opts ) {
+
+    RifFactoryConfig rif_factory_config;
+    rif_factory_config.rif_type = opts.rif_type;
+    shared_ptr<RifFactory> rif_factory = create_rif_factory( rif_factory_config );
+
+    std::string rif_description;
+    rif_ = rif_factory->create_rif_from_file( opts.rif_file, rif_description );
+    runtime_assert_msg( rif_, "rif creation from file failed! " + opts.rif_file );
+    if ( opts.rif_occupancy_filter_bits > 0 ) rif_->build_occupancy_filter( opts.rif_occupancy_filter_bits );
+
+    core::pose::Pose target;
+    core::import_pose::pose_from_file( target, opts.target_pdb );
+    utility::vector1<core::Size> target_res = get_res( opts.target_res_fname, target, /*nocgp*/false );
+
+    RosettaFieldOptions rfopts;
+    rfopts.field_resl = opts.target_rf_resl;
+    rfopts.data_dir = "DUMMY_DATA_DIR_FIXME";
+    rfopts.oversample = opts.target_rf_oversample;
+    rfopts.block_hbond_sites = false;
+    rfopts.max_bounding_ratio = opts.max_rf_bounding_ratio;
+    rfopts.fail_if_no_cached_data = true;
+    rfopts.repulsive_only_boundary = true;
+    rfopts.cache_mismatch_tolerance = 0.01;
+    get_rosetta_fields_specified_cache_prefix(
+        opts.target_rf_cache,
+        opts.target_pdb,
+        target,
+        target_res,
+        rfopts,
+        target_field_by_atype_,
+        false
+    );
+    runtime_assert( target_field_by_atype_.size() >= 21 );
+}
+
+void
+RifBatchScorer::set_scaffold(
+    double const * frames, int64_t nres,
+    double const * atom_xyz, int32_t const * atom_types, int64_t natoms
+) {
+    res_frames_.resize( nres );
+    for ( int64_t ir = 0; ir < nres; ir++ ) {
+        res_frames_[ir] = xform_from_rowmajor( frames + 16*ir );
+    }
+
+    atom_xyz_.resize( natoms );
+    atom_types_.resize( natoms );
+    for ( int64_t ia = 0; ia < natoms; ia++ ) {
+        runtime_assert_msg( 0 < atom_types[ia] && atom_types[ia] < 21, "RifBatchScorer: atom types must be 1-20" );
+        runtime_assert( target_field_by_atype_.at( atom_types[ia] ) );
+        atom_xyz_[ia] = Eigen::Vector3f( atom_xyz[3*ia+0], atom_xyz[3*ia+1], atom_xyz[3*ia+2] );
+        atom_types_[ia] = atom_types[ia];
+    }
+}
+
+void
+RifBatchScorer::score(
+    double const * xforms, int64_t n,
+    float * rif_score,
+    float * clash_score,
+    int32_t * hit_rot,
+    float * hit_score
+) const {
+
+    int64_t const nres = res_frames_.size();
+    int64_t const natoms = atom_xyz_.size();
+
+    std::exception_ptr exception = nullptr;
+    #ifdef USE_OPENMP
+    #pragma omp parallel
+    #endif
+    {
+        std::vector< std::pair< float, int > > rotscores;
+
+        #ifdef USE_OPENMP
+        #pragma omp for schedule(dynamic,64)
+        #endif
+        for ( int64_t i = 0; i < n; i++ ) {
+            if ( exception ) continue;
+            try {
+                EigenXform const x = xform_from_rowmajor( xforms + 16*i );
+
+                float rif = 0;
+                for ( int64_t ir = 0; ir < nres; ir++ ) {
+                    rotscores.clear();
+                    rif_->get_rotamers_for_xform( x * res_frames_[ir], rotscores );
+                    float best = 0;
+                    int best_rot = -1;
+                    for ( std::pair< float, int > const & p : rotscores ) {
+                        if ( p.first < best ) {
+                            best = p.first;
+                            best_rot = p.second;
+                        }
+                    }
+                    rif += best;
+                    if ( hit_rot ) hit_rot[i*nres+ir] = best_rot;
+                    if ( hit_score ) hit_score[i*nres+ir] = best;
+                }
+                rif_score[i] = rif;
+
+                float clash = 0;
+                for ( int64_t ia = 0; ia < natoms; ia++ ) {
+                    clash += target_field_by_atype_[atom_types_[ia]]->at( x * atom_xyz_[ia] );
+                }
+                clash_score[i] = clash;
+
+            } catch( std::exception const & ex ) {
+                #ifdef USE_OPENMP
+                #pragma omp critical
+                #endif
+                exception = std::current_exception();
+            }
+        }
+    }
+    if( exception ) std::rethrow_exception(exception);
+}
+
+void
+RifBatchScorer::bb_frames_from_n_ca_c(
+    double const * n, double const * ca, double const * c, int64_t nres,
+    double * out
+) {
+    for ( int64_t ir = 0; ir < nres; ir++ ) {
+        Eigen::Vector3f vn ( n [3*ir+0], n [3*ir+1], n [3*ir+2] );
+        Eigen::Vector3f vca( ca[3*ir+0], ca[3*ir+1], ca[3*ir+2] );
+        Eigen::Vector3f vc ( c [3*ir+0], c [3*ir+1], c [3*ir+2] );
+        BBActor bb( vn, vca, vc );
+        xform_to_rowmajor( bb.position(), out + 16*ir );
+    }
+}
+
+
+
+}}
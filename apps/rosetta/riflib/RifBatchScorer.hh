@@ -0,0 +1,96 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+#ifndef INCLUDED_riflib_RifBatchScorer_hh
+#define INCLUDED_riflib_RifBatchScorer_hh
+
+#include <riflib/types.hh>
+#include <riflib/RifBase.hh>
+
+#include <string>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+struct RifBatchScorerOpts {
+    std::string rif_type;
+    std::string rif_file;
+    std::string target_pdb;
+    std::string target_res_fname;   // empty: whole target
+    std::string target_rf_cache;    // the -rif_dock:target_rf_cache the fields were generated with
+    float target_rf_resl = 0.25;
+    int target_rf_oversample = 2;
+    float max_rf_bounding_ratio = 4.0;
+    float rif_occupancy_filter_bits = 0;
+};
+
+// Scores many rigid placements of one scaffold against a RIF and the target
+//  steric fields without going through rif_dock_test. Loads everything once, then
+//  score() takes plain arrays so callers (the pysetta bindings) can hand over
+//  numpy buffers directly.
+//
+// A transform moves the scaffold into the target frame. The rif score of a
+//  placement is the sum over scaffold residues of the best raw RIF rotamer score
+//  at that residue's backbone frame, ignoring positive scores. Unlike rif_dock_test
+//  there are no scaffold one-body energies, packing or satisfaction terms.
+//  The clash score is the sum of the target field over the scaffold atoms.
+struct RifBatchScorer {
+
+    RifBatchScorer( RifBatchScorerOpts const & opts );
+
+    // frames: nres row-major 4x4 backbone frames in the scaffold frame, as BBActor::position()
+    // atom_xyz: natoms x 3, atom_types: the rosetta/scheme atom type of each atom (1-20)
+    void
+    set_scaffold(
+        double const * frames, int64_t nres,
+        double const * atom_xyz, int32_t const * atom_types, int64_t natoms
+    );
+
+    // xforms: n row-major 4x4 transforms. rif_score and clash_score have n entries.
+    //  hit_rot and hit_score are n x nres or null; residues without a RIF rotamer get -1 and 0
+    void
+    score(
+        double const * xforms, int64_t n,
+        float * rif_score,
+        float * clash_score,
+        int32_t * hit_rot = nullptr,
+        float * hit_score = nullptr
+    ) const;
+
+    // BBActor frames from backbone coordinates, each argument nres x 3. out is nres x 4 x 4
+    static void
+    bb_frames_from_n_ca_c(
+        double const * n, double const * ca, double const * c, int64_t nres,
+        double * out
+    );
+
+    int64_t nres() const { return res_frames_.size(); }
+    int64_t natoms() const { return atom_xyz_.size(); }
+    float rif_cart_resl() const { return rif_->cart_resl(); }
+    float rif_ang_resl() const { return rif_->ang_resl(); }
+
+private:
+
+    shared_ptr<RifBase> rif_;
+    std::vector< VoxelArrayPtr > target_field_by_atype_;
+
+    std::vector<EigenXform> res_frames_;
+    std::vector<Eigen::Vector3f> atom_xyz_;
+    std::vector<int32_t> atom_types_;
+
+};
+
+
+
+}}
+
+#endif
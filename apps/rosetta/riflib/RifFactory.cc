@@ -218,6 +218,9 @@ public:
 		__gnu_parallel::for_each( xmap_ptr_->map_.begin(), xmap_ptr_->map_.end(), call_sort_rotamers<typename XMap::Map::value_type> );
 	}
 
+	void build_occupancy_filter( float bits_per_key ) override { xmap_ptr_->build_occupancy_filter( bits_per_key ); }
+	size_t occupancy_filter_mem_use() const override { return xmap_ptr_->occupancy_.mem_use(); }
+
 	// void super_print( std::ostream & out, shared_ptr< RotamerIndex > rot_index_p ) const override { xmap_ptr_->super_print( out, rot_index_p  ); }
 	void print( std::ostream & out ) const override { out << (*xmap_ptr_) << std::endl; }
 	std::string value_name() const override { return XMap::Value::name(); }
@@ -1272,11 +1275,11 @@ std::string get_rif_type_from_file( std::string fname )
         std::vector<bool> requirements_satisfied_;
 		std::vector<std::vector<float> > const * rotamer_energies_1b_ = nullptr;
 		std::vector< std::pair<int,int> > const * scaffold_rotamers_ = nullptr;
-		shared_ptr< BurialManager > burial_manager_;
+		shared_ptr< BurialManager const > burial_manager_;
 		shared_ptr< UnsatManager > unsat_manager_;
         float cb_too_close_score_;
         shared_ptr< BurialVoxelArray > scaff_burial_grid_;
-		shared_ptr<::scheme::objective::storage::TwoBodyTable<float> const> reference_twobody_;
+        std::vector<float> burial_weights_;
         //std::vector<std::vector<bool>> allowed_irots_;
         shared_ptr<std::vector<std::vector<bool>>> allowed_irots_;
         shared_ptr<std::vector<bool>> ala_disallowed_;
@@ -1287,6 +1290,13 @@ std::string get_rif_type_from_file( std::string fname )
         std::vector<bool> pdbinfo_req_req_satisfied_; // has this pdbinfo:req been satisfied yet
         std::vector<bool> pdbinfo_req_req_satisfied_bbO_; // has this pdbinfo:req been satisfied yet
         std::vector<bool> pdbinfo_req_req_satisfied_bbN_; // has this pdbinfo:req been satisfied yet
+
+        // see HSearchScoreBound, bound_ is null unless the current sample is being bounded
+        HSearchScoreBound::Slot * bound_ = nullptr;
+        std::vector<float> const * bound_best_onebody_ = nullptr;
+        float bound_rif_floor_ = 0;
+        float bound_sum_ = 0;
+        float bound_floor_left_ = 0;
         
 	};
 
@@ -1304,7 +1314,7 @@ std::string get_rif_type_from_file( std::string fname )
         float hydrophobic_ddg_cut_ = 0;
         float ignore_rifres_if_worse_than = 0;
 		std::vector< shared_ptr< ::scheme::search::HackPack> > packperthread_;
-		std::vector< shared_ptr< BurialManager> > burialperthread_;
+		shared_ptr< BurialManager const > burial_manager_; // read-only, shared by all threads
 		std::vector< shared_ptr< UnsatManager > > unsatperthread_;
         shared_ptr< HydrophobicManager> hydrophobic_manager_;
         shared_ptr< CBTooCloseManager > CB_too_close_manager_;
@@ -1333,6 +1343,10 @@ std::string get_rif_type_from_file( std::string fname )
 	public:
 		VoxelArrayPtr target_proximity_test_grid_ = nullptr;
 		RifScoreRotamerVsTarget rot_tgt_scorer_;
+		shared_ptr< ::scheme::util::ThreadCounters > probe_counters_ = nullptr; // slot RIF_HIT / RIF_MISS
+		static int const RIF_HIT = 0, RIF_MISS = 1;
+		shared_ptr< HSearchResidueHints > residue_hints_ = nullptr; // only used when not packing
+		shared_ptr< HSearchScoreBound > score_bound_ = nullptr; // only used when not packing
 		std::vector<int> always_available_rotamers_;
 
 		ScoreBBActorVsRIF() {}
@@ -1386,8 +1400,8 @@ std::string get_rif_type_from_file( std::string fname )
 			shared_ptr< BurialManager > burial_manager,
 			shared_ptr< UnsatManager > unsat_manager
 		) {
+			burial_manager_ = burial_manager;
 			for( int i  = 0; i < ::devel::scheme::omp_max_threads_1(); ++i ){
-				burialperthread_.push_back( burial_manager->clone() );
 				unsatperthread_.push_back( unsat_manager->clone() );
 			}
 		}
@@ -1410,7 +1424,7 @@ std::string get_rif_type_from_file( std::string fname )
 
 			runtime_assert( rif_ );
 			runtime_assert( scratch.rotamer_energies_1b_ );
-			if( n_sat_groups_ > 0 && burialperthread_.size() == 0 ){
+			if( n_sat_groups_ > 0 && ! burial_manager_ ){
 				scratch.is_satisfied_.resize(n_sat_groups_,false); // = new bool[n_sat_groups_];
 				for( int i = 0; i < n_sat_groups_; ++i ) scratch.is_satisfied_[i] = false;
 				//scratch.is_satisfied_score_.resize(n_sat_groups_,0.0);
@@ -1424,9 +1438,8 @@ std::string get_rif_type_from_file( std::string fname )
 			scratch.has_rifrot_.resize(scratch.rotamer_energies_1b_->size(), false);
 			for ( int i = 0; i < scratch.has_rifrot_.size(); i++ ) scratch.has_rifrot_[i] = false;
 
-			if ( burialperthread_.size() > 0 ) {
-				scratch.burial_manager_ = burialperthread_.at( ::devel::scheme::omp_thread_num() );
-				scratch.burial_manager_->reset();
+			if ( burial_manager_ ) {
+				scratch.burial_manager_ = burial_manager_;
 				scratch.unsat_manager_ = unsatperthread_.at( ::devel::scheme::omp_thread_num() );
 				scratch.unsat_manager_->reset();
 
@@ -1440,6 +1453,22 @@ std::string get_rif_type_from_file( std::string fname )
                 
             }
 
+            // burial and atoms_close_together can lower the score after the fact, don't bound those
+            scratch.bound_ = nullptr;
+            float other_floor = 0;
+            if ( score_bound_ && score_bound_->active() && !packing_ && !burial_manager_ && !atoms_close_together_managers_p_
+                    && other_terms_floor( scene, config, other_floor ) ) {
+                scratch.bound_ = &score_bound_->slot( ::devel::scheme::omp_thread_num() );
+                scratch.bound_->bounded = false;
+                scratch.bound_best_onebody_ = &HSearchScoreBound::best_onebody( *scratch.bound_, data_cache->local_onebody_p );
+                scratch.bound_rif_floor_ = rif_score_floor();
+                scratch.bound_sum_ = 0;
+                scratch.bound_floor_left_ = other_floor;
+                for ( float best1b : *scratch.bound_best_onebody_ ) {
+                    scratch.bound_floor_left_ += HSearchScoreBound::residue_floor( best1b, scratch.bound_rif_floor_ );
+                }
+            }
+
 			if( !packing_ ) return;
 
 			// Added by brian ////////////////////////
@@ -1451,20 +1480,63 @@ std::string get_rif_type_from_file( std::string fname )
 			runtime_assert( rot_tgt_scorer_.target_field_by_atype_.size() == 22 );
 			scratch.hackpack_ = packperthread_.at( ::devel::scheme::omp_thread_num() );
 
-			if ( ! scratch.burial_manager_ ) {
-				scratch.hackpack_->reinitialize( data_cache->local_twobody_p );
-			} else {
-				scratch.hackpack_->reinitialize( data_cache->local_twobody_per_thread.at(::devel::scheme::omp_thread_num()) );
-				scratch.reference_twobody_ = data_cache->local_twobody_p;
-			}
+			scratch.hackpack_->reinitialize( data_cache->local_twobody_p );
 
 		}
 
+		// lowest score a rif lookup can give a rotamer, including sat bonuses
+		float rif_score_floor() const {
+			float floor = RIF::Value::RotScore::min_score();
+			float bonus = 0;
+			for ( float b : sat_bonus_ ) bonus = std::min( bonus, b );
+			return std::min( floor + bonus, bonus );
+		}
+
+		// lowest everything but the rif lookups can add to this sample: the clash grids and the CB penalty
+		// false if there is no such floor, the hbond and sasa terms can go arbitrarily low
+		template<class Scene, class Config>
+		bool other_terms_floor( Scene const & scene, Config const & config, float & floor ) const {
+			floor = 0;
+			if ( scene.nbodies() != scene.nbodies_asym() ) return false; // symmetric copies score at other weights
+			size_t natoms = 0;
+			for ( size_t ib = 0; ib < scene.nbodies_asym(); ib++ ) {
+				if ( scene.template num_actors<BBHBondActor>(ib) || scene.template num_actors<BBSasaActor>(ib) ) return false;
+				natoms += scene.template num_actors<SimpleAtom>(ib);
+			}
+			// MyClashScore scores every VoxelActor against the SimpleAtoms of the other bodies
+			for ( size_t ib = 0; ib < scene.nbodies_asym(); ib++ ) {
+				size_t const nother = natoms - scene.template num_actors<SimpleAtom>(ib);
+				for ( VoxelActor const & va : scene.conformation(ib).template get<VoxelActor>() ) {
+					float const lowest = va.min_value( config );
+					if ( lowest <= -std::numeric_limits<float>::max() ) return false;
+					floor += std::min( 0.0f, lowest ) * nother;
+				}
+			}
+			if ( CB_too_close_manager_ ) {
+				for ( size_t ib = 0; ib < scene.nbodies_asym(); ib++ ) {
+					floor += std::min( 0.0f, CB_too_close_manager_->penalty_ ) * scene.template num_actors<BBActor>(ib);
+				}
+			}
+			return true;
+		}
+
 		template<class Config>
 		Result operator()( RIFAnchor const &, BBActor const & bb, Scratch & scratch, Config const& c ) const
 		{
             if ( CB_too_close_manager_ ) scratch.cb_too_close_score_ += CB_too_close_manager_->get_CB_penalty( bb.position() );
 
+            if ( scratch.bound_ ) {
+                if ( scratch.bound_->bounded ) return 0.0;
+                scratch.bound_floor_left_ -= HSearchScoreBound::residue_floor(
+                    scratch.bound_best_onebody_->at( bb.index_ ), scratch.bound_rif_floor_ );
+            }
+
+			HSearchResidueHints::Slot const * hint = nullptr;
+			if( residue_hints_ && !packing_ ){
+				hint = &residue_hints_->slot( ::devel::scheme::omp_thread_num() );
+				if( hint->probe_only && !HSearchResidueHints::test( hint->probe_only, bb.index_ ) ) return 0.0;
+			}
+
 			if( target_proximity_test_grid_ && target_proximity_test_grid_->at( bb.position().translation() ) == 0.0 ){
 				return 0.0;
 			}
@@ -1472,6 +1544,8 @@ std::string get_rif_type_from_file( std::string fname )
 			const bool want_sats = scratch.burial_manager_;
 
 			typename RIF::Value const & rotscores = rif_->operator[]( bb.position() );
+			if( probe_counters_ ) probe_counters_->add( ::devel::scheme::omp_thread_num(), rotscores.empty(0) ? RIF_MISS : RIF_HIT );
+			if( hint && hint->record_hits && !rotscores.empty(0) ) HSearchResidueHints::set( hint->record_hits, bb.index_ );
 			static int const Nrots = RIF::Value::N;
 			int const ires = bb.index_;
 			float bestsc = 0.0;
@@ -1603,6 +1677,11 @@ std::string get_rif_type_from_file( std::string fname )
 				//}
 			}
 
+            if ( scratch.bound_ ) {
+                scratch.bound_sum_ += bestsc;
+                if ( scratch.bound_sum_ + scratch.bound_floor_left_ > score_bound_->cutoff() ) scratch.bound_->bounded = true;
+            }
+
             // This doesn't respect packopts_.rescore_rots_before_insertion. i.e. this gives garbage at low resolution
             //  Theoretically fixable, but correct rotamers may have been pushed out of the rif
             // // add native scaffold rotamers TODO: this is bugged somehow?
@@ -1702,18 +1781,13 @@ std::string get_rif_type_from_file( std::string fname )
 				float unsat_zerobody = 0;
 				if ( scratch.burial_manager_ ) {
                     EigenXform scaffold_xform = scene.position(1);
-					unsat_zerobody = scratch.unsat_manager_->prepare_packer( packer, 
-                        scratch.burial_manager_->get_burial_weights( scaffold_xform, scratch.scaff_burial_grid_ ),
-                        scratch.is_satisfied_ );
+                    scratch.burial_manager_->get_burial_weights( scaffold_xform, scratch.scaff_burial_grid_, scratch.burial_weights_ );
+					unsat_zerobody = scratch.unsat_manager_->prepare_packer( packer, scratch.burial_weights_, scratch.is_satisfied_ );
 				}
 				
 				result.val_ = packer.pack( result.rotamers_ );
 				result.val_ += unsat_zerobody;
 
-				if ( scratch.burial_manager_ ) {scratch.unsat_manager_->fix_packer( packer, scratch.reference_twobody_ );
-					// runtime_assert(scratch.reference_twobody_->check_equal(*packer.twob_));
-				}
-				
 
                 if ( hydrophobic_manager_ ) {
                     std::vector<std::pair<intRot, EigenXform>> irot_and_bbpos;
@@ -1825,8 +1899,8 @@ std::string get_rif_type_from_file( std::string fname )
 
 				if ( scratch.burial_manager_ ) {
                     EigenXform scaffold_xform = scene.position(1);
-					std::vector<float> burial_weights = scratch.burial_manager_->get_burial_weights( scaffold_xform, scratch.scaff_burial_grid_ );
-					result.val_ += scratch.unsat_manager_->calculate_nonpack_score( burial_weights, scratch.is_satisfied_ );
+					scratch.burial_manager_->get_burial_weights( scaffold_xform, scratch.scaff_burial_grid_, scratch.burial_weights_ );
+					result.val_ += scratch.unsat_manager_->calculate_nonpack_score( scratch.burial_weights_, scratch.is_satisfied_ );
 				}
 
 
@@ -2016,6 +2090,8 @@ std::string get_rif_type_from_file( std::string fname )
 
             result.val_ += scratch.cb_too_close_score_; 
 
+            if ( scratch.bound_ && scratch.bound_->bounded ) result.val_ = 9e9;
+
 		}
 	};
 	template< class B, class X, class V >
@@ -2171,7 +2247,7 @@ std::string get_rif_type_from_file( std::string fname )
                 Eigen::Vector3f super_far_away(1e5, 1e5, 1e5);
 
                 for ( auto const & ray : bbh.hbond_rays() ) {
-                    std::vector<Sat>::const_iterator sats_iter =  rot_tgt_scorer_.target_acceptor_cache_->at( ray.horb_cen );
+                    Sat const * sats_iter =  rot_tgt_scorer_.target_acceptor_cache_->at( ray.horb_cen );
 
                     Sat don_or_acc = 0;
                     while ( (don_or_acc = *(sats_iter++)) != DonorAcceptorCache::CACHE_MAX_SAT ) {
@@ -2380,11 +2456,13 @@ struct RifFactoryImpl :
 	}
 
 	virtual	shared_ptr<rif::RifAccumulator>
-	create_rif_accumulator( float cart_resl, float ang_resl, float cart_bound, size_t scratchM ) const {
+	create_rif_accumulator( float cart_resl, float ang_resl, float cart_bound, size_t scratchM,
+	                        std::string const & spill_dir, size_t spillM ) const {
 		return make_shared< rif::RIFAccumulatorMapThreaded<XMap> >(
 			this->shared_from_this(),
 			cart_resl, ang_resl, cart_bound,
-			scratchM
+			scratchM,
+			spill_dir, spillM
 		);
 	}
 
@@ -2432,6 +2510,12 @@ struct RifFactoryImpl :
 				}
                 dynamic_cast<MySceneObjectiveRIF&>(*objective).objective.template
                     get_objective<MyScoreBBActorRIF>().ignore_rifres_if_worse_than = config.ignore_rifres_if_worse_than;
+				objective->objective.template get_objective<MyClashScore>().clash_cutoff_ = config.hsearch_clash_cutoff;
+				if( i_so < config.rif_probe_counters.size() ){
+					objective->objective.template get_objective<MyScoreBBActorRIF>().probe_counters_ = config.rif_probe_counters[i_so];
+				}
+				objective->objective.template get_objective<MyScoreBBActorRIF>().residue_hints_ = config.residue_hints;
+				objective->objective.template get_objective<MyScoreBBActorRIF>().score_bound_ = config.score_bound;
 				objective->config = i_so;
 				objectives.push_back( objective );
 			}
@@ -22,6 +22,9 @@
 #include <riflib/CBTooCloseManager.hh>
 #include <riflib/HydrophobicManager.hh>
 #include <riflib/AtomsCloseTogetherManager.hh>
+#include <riflib/HSearchResidueHints.hh>
+#include <riflib/HSearchScoreBound.hh>
+#include <scheme/util/PerfReport.hh>
 
 #ifdef USEGRIDSCORE
 #include <protocols/ligand_docking/GALigandDock/GridScorer.hh>
@@ -80,7 +83,8 @@ struct RifFactory
 	) const = 0;
 
 	virtual	shared_ptr<rif::RifAccumulator>
-	create_rif_accumulator( float cart_resl, float ang_resl, float cart_bound, size_t scratchM ) const = 0;
+	create_rif_accumulator( float cart_resl, float ang_resl, float cart_bound, size_t scratchM,
+	                        std::string const & spill_dir="", size_t spillM=0 ) const = 0;
 
 	RifPtr
 	create_rif_from_file( std::string const & fname ) const {
@@ -139,6 +143,7 @@ struct RifSceneObjectiveConfig
     float sasa_threshold;
     float sasa_multiplier;
     float ignore_rifres_if_worse_than;
+    float hsearch_clash_cutoff = 9e9;
     int num_pdbinfo_requirements_required = 0;
     std::vector< std::vector<bool> > pdbinfo_req_active_positions;
     std::vector< std::vector<bool> > pdbinfo_req_active_requirements;
@@ -150,6 +155,12 @@ struct RifSceneObjectiveConfig
     std::vector< std::vector<bool> > pdbinfo_req_active_requirements_bbN;
     std::vector<float> sat_bonus;
     std::vector<bool> sat_bonus_override;
+    // per-resolution rif lookup counters for the search objectives, empty to disable
+    std::vector< shared_ptr< ::scheme::util::ThreadCounters > > rif_probe_counters;
+    // lets the hsearch skip residues whose parent had no rif hits, null to disable
+    shared_ptr< HSearchResidueHints > residue_hints;
+    // lets the hsearch stop scoring samples that can't make the beam, null to disable
+    shared_ptr< HSearchScoreBound > score_bound;
 
 };
 
@@ -248,7 +248,7 @@ struct ScoreRotamerVsTarget {
             if ( target_donor_cache_ ) {
 
                 typedef typename DonorAcceptorCache::Sat Sat;
-                std::vector<Sat>::const_iterator sats_iter = target_donor_cache_->at( hr_rot_acc.horb_cen );
+                Sat const * sats_iter = target_donor_cache_->at( hr_rot_acc.horb_cen );
 
                 Sat i_hr_tgt_don = 0;
                 while ( (i_hr_tgt_don = *(sats_iter++)) != DonorAcceptorCache::CACHE_MAX_SAT ) {
@@ -328,7 +328,7 @@ struct ScoreRotamerVsTarget {
             if ( target_acceptor_cache_ ) {
 
                 typedef typename DonorAcceptorCache::Sat Sat;
-                std::vector<Sat>::const_iterator sats_iter =  target_acceptor_cache_->at( hr_rot_don.horb_cen );
+                Sat const * sats_iter =  target_acceptor_cache_->at( hr_rot_don.horb_cen );
 
                 Sat i_hr_tgt_acc = 0;
                 while ( (i_hr_tgt_acc = *(sats_iter++)) != DonorAcceptorCache::CACHE_MAX_SAT ) {
@@ -227,8 +227,8 @@ UnsatManager::reset() {
     to_pack_rots_.clear();  // this supposedly doesn't mess with the memory
     to_pack_rots_.reserve(512);
 
-    modified_edges_.clear();
-    modified_edges_.reserve(1024);
+    pair_penalties_.clear();
+    pair_penalties_.reserve(1024);
 }
 
 
@@ -1110,7 +1110,7 @@ UnsatManager::prepare_packer(
             // upper triangle for loop
             for ( int ilocal = 0; ilocal < (int)local_sat_satsifiers.size() - 1; ilocal ++ ) {
                 for ( int jlocal = ilocal + 1; jlocal < local_sat_satsifiers.size(); jlocal++ ) {
-                    zerobody_penalty += handle_twobody( local_sat_satsifiers[ilocal], local_sat_satsifiers[jlocal], P0, packer );
+                    zerobody_penalty += handle_twobody( local_sat_satsifiers[ilocal], local_sat_satsifiers[jlocal], P0 );
 
 
                     if (debug_) std::cout << "orbital clash: " << P0 << " heavy_atom: " << ih
@@ -1141,7 +1141,7 @@ UnsatManager::prepare_packer(
                 // all x all of iorb_satisfiers against jorb_satisfiers
                 for ( int ilocal = 0; ilocal < iorb_satisfiers.size(); ilocal++ ) {
                     for ( int jlocal = 0; jlocal < jorb_satisfiers.size(); jlocal++ ) {
-                        zerobody_penalty += handle_twobody( iorb_satisfiers[ilocal], jorb_satisfiers[jlocal], twob_penalty, packer );
+                        zerobody_penalty += handle_twobody( iorb_satisfiers[ilocal], jorb_satisfiers[jlocal], twob_penalty );
 
                         if (debug_) std::cout << "heavy atom clash: " << twob_penalty << " heavy_atom: " << ih
                                     << " ipack1: " << iorb_satisfiers[ilocal] << " ipack2: " << jorb_satisfiers[jlocal] << std::endl;
@@ -1165,9 +1165,10 @@ UnsatManager::prepare_packer(
 void
 UnsatManager::insert_to_pack_rots_into_packer(::scheme::search::HackPack & packer) {
     if ( debug_ ) std::cout << "Inserting into packer:" << std::endl;
+    packed_rot_list_.resize( to_pack_rots_.size() );
     for ( int i = 0; i < to_pack_rots_.size(); i++ ) {
         ToPackRot const & rot = to_pack_rots_[i];
-        packer.add_tmp_rot( rot.ires, rot.irot, rot.score );
+        packed_rot_list_[i] = packer.add_tmp_rot( rot.ires, rot.irot, rot.score );
 
         if ( debug_ ) {
             std::cout << "ToPackRot: " << i << " " << rot_index_p->oneletter(rot.irot) 
@@ -1177,10 +1178,18 @@ UnsatManager::insert_to_pack_rots_into_packer(::scheme::search::HackPack & packe
                 << std::endl;
         }
     }
+
+    // rotamers the packer refused (high onebody or not in the twobody table) can't be chosen
+    for ( std::pair<std::pair<int,int>,float> const & pen : pair_penalties_ ) {
+        int32_t irot_list = packed_rot_list_[ pen.first.first ];
+        int32_t jrot_list = packed_rot_list_[ pen.first.second ];
+        if ( irot_list < 0 || jrot_list < 0 ) continue;
+        packer.add_pair_energy( irot_list, jrot_list, pen.second );
+    }
 }
 
 float
-UnsatManager::handle_twobody( int satisfier1, int satisfier2, float penalty, ::scheme::search::HackPack & packer ) {
+UnsatManager::handle_twobody( int satisfier1, int satisfier2, float penalty ) {
 
     if ( satisfier1 == -1 && satisfier2 == -1 ) return penalty;
 
@@ -1199,26 +1208,12 @@ UnsatManager::handle_twobody( int satisfier1, int satisfier2, float penalty, ::s
         return 0;
     }
 
-    ToPackRot const & pack1 = to_pack_rots_[ satisfier1 ];
-    ToPackRot const & pack2 = to_pack_rots_[ satisfier2 ];
-
-    packer.twob_->upweight_edge( pack1.ires, pack2.ires, pack1.irot, pack2.irot, penalty );
-    modified_edges_.push_back( std::array<int, 4> { pack1.ires, pack2.ires, pack1.irot, pack2.irot } );
+    // applied once both rotamers are in the packer, see insert_to_pack_rots_into_packer
+    pair_penalties_.push_back( std::make_pair( std::make_pair( satisfier1, satisfier2 ), penalty ) );
 
     return 0;
 
 }
 
-void
-UnsatManager::fix_packer( 
-    ::scheme::search::HackPack & packer, 
-    shared_ptr<::scheme::objective::storage::TwoBodyTable<float> const> reference_twobody
-) {
-    for ( std::array<int, 4> const & arr : modified_edges_ ) {
-        packer.twob_->restore_edge( arr[0], arr[1], arr[2], arr[3], reference_twobody );
-    }
-}
-
-
 
 }}
@@ -276,12 +276,6 @@ struct UnsatManager {
     void
     insert_to_pack_rots_into_packer( ::scheme::search::HackPack & packer );
 
-    void
-    fix_packer( 
-        ::scheme::search::HackPack & packer, 
-        shared_ptr<::scheme::objective::storage::TwoBodyTable<float> const> reference_twobody
-    );
-
     bool
     patch_heavy_atoms( 
         int resid,
@@ -323,8 +317,7 @@ struct UnsatManager {
     handle_twobody( 
         int satisfier1,
         int satisfier2,
-        float penalty,
-        ::scheme::search::HackPack & packer
+        float penalty
     );
 
     bool
@@ -349,7 +342,8 @@ struct UnsatManager {
 
 // things that are resetable
     std::vector<ToPackRot> to_pack_rots_;
-    std::vector<std::array<int, 4>> modified_edges_;
+    std::vector<std::pair<std::pair<int,int>,float>> pair_penalties_;   // to_pack_rots_ index pairs
+    std::vector<int32_t> packed_rot_list_;                              // to_pack_rots_ -> packer rot_list_
 
 };
 
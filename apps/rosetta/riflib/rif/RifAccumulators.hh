@@ -15,6 +15,12 @@
 #include <riflib/rif/RifGenerator.hh>
 #include <riflib/RifFactory.hh>
 
+#include <scheme/util/SortedRuns.hh>
+
+#include <utility/file/file_sys_util.hh>
+
+#include <unistd.h>
+
 namespace devel {
 namespace scheme {
 namespace rif {
@@ -32,19 +38,33 @@ struct RIFAccumulatorMapThreaded : public RifAccumulator {
 
 	shared_ptr<XMap> xmap_ptr_;
 
+	// spill mode: once the condensed map grows past spill_size_M_ it is written to
+	//  spill_dir as a key sorted run and emptied. condense() k-way merges the runs
+	//  back into one map sized for the final key count
+	typedef ::scheme::util::SortedRuns< typename XMap::Key, typename XMap::Value > Runs;
+	shared_ptr<Runs> spill_runs_;
+	float spill_size_M_;
+
 	RIFAccumulatorMapThreaded(
 		shared_ptr<RifFactory const> rif_factory,
 		float cart_resl,
 		float ang_resl,
 		float cart_bound,
-		size_t scratch_size_M=8000
+		size_t scratch_size_M=8000,
+		std::string const & spill_dir="",
+		size_t spill_size_M=0
 	)
 		: rif_factory_(rif_factory)
 		, scratch_size_M_(scratch_size_M)
 	 	, N_motifs_found_(0)
+		, spill_size_M_(spill_size_M)
 	{
 		clear();
 		xmap_ptr_ = make_shared<XMap>( cart_resl, ang_resl );
+		if( spill_dir.size() ){
+			if( ! utility::file::file_exists( spill_dir ) ) utility::file::create_directory_recursive( spill_dir );
+			spill_runs_ = make_shared<Runs>( spill_dir + "/rif_accum_" + std::to_string(getpid()) + "_" + std::to_string((uint64_t)this) + "_run" );
+		}
 	}
 
 	bool initialize_with_rif( shared_ptr<RifBase> & rif ) override {
@@ -54,6 +74,7 @@ struct RIFAccumulatorMapThreaded : public RifAccumulator {
 	uint64_t n_motifs_found() const override { return N_motifs_found_ + total_samples(); }
 
 	shared_ptr<RifBase> rif() const override {
+		runtime_assert_msg( !spill_runs_ || !spill_runs_->num_runs(), "rif() with spilled runs, condense first" );
 		shared_ptr<RifBase> r = rif_factory_->create_rif();
 		r->set_xmap_ptr( xmap_ptr_ );
 		return r;
@@ -101,6 +122,11 @@ struct RIFAccumulatorMapThreaded : public RifAccumulator {
 	}
 
 	void condense(bool force_override/*=false*/) override {
+		condense_scratch( force_override );
+		if( spill_runs_ && spill_runs_->num_runs() ) merge_runs();
+	}
+
+	void condense_scratch( bool force_override ) {
 		using ObjexxFCL::format::I;
 		for( int i = 0; i < to_insert_.size(); ++i ){
 			// std::cout << I(3,i+1) << " of " << to_insert_.size() << " progress: ";
@@ -124,14 +150,54 @@ struct RIFAccumulatorMapThreaded : public RifAccumulator {
 		}
 	}
 
+	// spilled runs are rewritten one at a time rather than merged back, so this keeps the spill bound
+	void clear_sats() override {
+		condense_scratch( false );
+		N_motifs_found_ += total_samples();
+		clear(); // or the next checkpoint merges the scratch, sats and all, back in
+		for( auto & v : xmap_ptr_->map_ ) v.second.clear_sats();
+		if( spill_runs_ && spill_runs_->num_runs() ){
+			spill_runs_->rewrite( []( typename XMap::Value & v ){ v.clear_sats(); } );
+		}
+	}
+
+	// write the condensed map as a sorted run and free it
+	void spill_map() {
+		if( xmap_ptr_->map_.empty() ) return;
+		std::vector< typename Runs::Record > records( xmap_ptr_->map_.begin(), xmap_ptr_->map_.end() );
+		typename XMap::Map empty;
+		empty.set_empty_key( std::numeric_limits<uint64_t>::max() );
+		xmap_ptr_->map_.swap( empty );
+		spill_runs_->spill( records );
+	}
+
+	// equal keys are merged in spill order, as condense would have merged them in memory
+	void merge_runs() {
+		spill_map();
+		uint64_t const nkeys = spill_runs_->count_unique_keys();
+		std::cout << "RIFAccum merging " << spill_runs_->num_runs() << " spilled runs, "
+		          << devel::scheme::KMGT(spill_runs_->num_records()) << " records, "
+		          << devel::scheme::KMGT(nkeys) << " keys" << std::endl;
+		typename XMap::Map & map = xmap_ptr_->map_;
+		map.resize( nkeys );
+		spill_runs_->merge_reduce(
+			[]( typename XMap::Value & acc, typename XMap::Value const & v ){ acc.merge( v ); },
+			[&map]( typename XMap::Key const & k, typename XMap::Value const & v ){ map.insert( std::make_pair( k, v ) ); }
+		);
+		spill_runs_->clear();
+	}
+
 	void report( std::ostream & out ) const override {
 		out << "RIFAccum nrots: " << devel::scheme::KMGT(n_motifs_found())
 		    << " mem: " << devel::scheme::KMGT(mem_use())
-		    << " rif_mem: " << devel::scheme::KMGT(xmap_ptr_->mem_use()) << std::endl;
+		    << " rif_mem: " << devel::scheme::KMGT(xmap_ptr_->mem_use());
+		if( spill_runs_ ) out << " spilled_runs: " << spill_runs_->num_runs() << " spilled: " << devel::scheme::KMGT(spill_runs_->num_records());
+		out << std::endl;
 	}
 
 	// inclusive on the ranges
 	uint64_t count_these_irots( int irot_low, int irot_high ) const {
+		runtime_assert_msg( !spill_runs_ || !spill_runs_->num_runs(), "count_these_irots needs the whole rif in memory, condense first" );
 		uint64_t count = 0;
 		for ( auto pair : xmap_ptr_->map_ ) {
 			count += pair.second.count_these_irots( irot_low, irot_high );
@@ -143,6 +209,7 @@ struct RIFAccumulatorMapThreaded : public RifAccumulator {
 	std::set<size_t> get_sats_of_this_irot( devel::scheme::EigenXform const & x, int irot ) const override {
 
 		std::set<size_t> sats;
+		runtime_assert_msg( !spill_runs_ || !spill_runs_->num_runs(), "get_sats_of_this_irot needs the whole rif in memory, condense first" );
 
 		uint64_t const key = xmap_ptr_->hasher_.get_key( x );
 
@@ -213,9 +280,15 @@ struct RIFAccumulatorMapThreaded : public RifAccumulator {
 		// if( m > uint64_t(scratch_size_M_)*uint64_t(1024*1024) ){ // time to clean up a bit...
 			// out << "mem use " << float(m)/1024.0/1024.0 << "M is above threshold " << scratch_size_M_ << "M, time to condense" << std::endl;
 			out << '<'; out.flush();
-			condense(force_override);
+			// a forced merge has to see every earlier value of a key, bring the runs back first
+			if( force_override && spill_runs_ && spill_runs_->num_runs() ) merge_runs();
+			condense_scratch(force_override);
 			N_motifs_found_ += total_samples();
 			clear();
+			if( spill_runs_ && xmap_ptr_->mem_use() > uint64_t(spill_size_M_)*uint64_t(1024*1024) ){
+				out << 's'; out.flush();
+				spill_map();
+			}
 			out << '>'; out.flush();
 			// out << "RIF so far: " << " non0 in RIF: " << KMGT(xmap_ptr_->size()) << " N_motifs_found_: "
 			    // << KMGT(N_motifs_found_) << " coverage: " << (double)N_motifs_found_/xmap_ptr_->size()
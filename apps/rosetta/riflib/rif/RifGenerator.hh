@@ -56,6 +56,7 @@ struct RifAccumulator {
 	virtual uint64_t count_these_irots( int irot_low, int irot_high ) const = 0;
 	virtual std::set<size_t> get_sats_of_this_irot( devel::scheme::EigenXform const & x, int irot ) const = 0;
 	virtual bool initialize_with_rif( shared_ptr<RifBase> & rif ) = 0;
+	virtual void clear_sats() = 0; // everything inserted so far, including spilled runs
 };
 typedef shared_ptr<RifAccumulator> RifAccumulatorP;
 
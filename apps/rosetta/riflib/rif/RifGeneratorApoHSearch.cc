@@ -437,32 +437,60 @@ namespace rif {
         abs_score_cut_by_res["DTY"] = -2.8;
         abs_score_cut_by_res["DHI"] = -1.8;
 
-		// #ifdef USE_OPENMP
-		// #pragma omp parallel for schedule(dynamic,1)
-		// #endif
-		for( int ijob = 0; ijob < rots.size(); ++ijob ){
-
+		// each rotamer is searched in two phases. the hierarchical stages only touch per-rotamer
+		// state, so several rotamers can run at once, each on its share of the threads. the final stage inserts
+		// into the accumulator, which keys its buffers on omp thread num and can only condense
+		// between parallel regions, so it runs one rotamer at a time over all threads
+		struct RotChild {
+		    int rotid;
+		    Eigen::Vector3f Ncen, CAcen, Ccen;
+		    Eigen::Vector3f CBcen;
+		    // used for the cation-pi interaction
+		    Eigen::Vector3f benzene_ring_center, imidazole_ring_center, ring_norm_vector;
+		};
+		struct RotamerSearch {
+			int irot = -1;
+			std::string resn;
+			float abs_score_cut_by_res_thisres = 0;
+			float rotamer_radius = 0;
+			Eigen::Vector3f rotamer_center = Eigen::Vector3f(0,0,0);
+			shared_ptr<Scene> scene_proto;
+			shared_ptr<Director> director;
+			std::vector<RotChild> inv_rotamer_backbones;
+			std::vector<SearchPoint> parents; // last hierarchical stage samples passing the final cut
+			std::string log; // buffered output when searched concurrently with other rotamers
+		};
+
+		// hierarchical stages for one rotamer, inner loops run on nthread_inner threads
+		auto hsearch_rotamer = [&]( int ijob, RotamerSearch & rs, int nthread_inner, bool concurrent )
+		{
+			// when rotamers run concurrently their logs are buffered and printed whole
+			std::ostringstream buf;
+			std::ostream & out( concurrent ? (std::ostream&)buf : cout );
+			bool const inner_parallel = nthread_inner > 1;
 			int irot = rots[ijob];
 			std::string resn = rot_index_p->rotamers_[irot].resname_;
+			rs.irot = irot;
+			rs.resn = resn;
 
 			runtime_assert_msg( abs_score_cut_by_res.find(resn) != abs_score_cut_by_res.end(), "unsupported res "+resn );
-			float const abs_score_cut_by_res_thisres = abs_score_cut_by_res[resn] * opts.score_cut_adjust;
+			float const abs_score_cut_by_res_thisres = abs_score_cut_by_res.find(resn)->second * opts.score_cut_adjust;
+			rs.abs_score_cut_by_res_thisres = abs_score_cut_by_res_thisres;
 
 			// utility::io::ozstream rif_apo_vis_out("rif_apo_vis_"+resn+str(irot)+".pdb");
 
 			{
-				omp_set_lock(&cout_lock);
-				// cout << "========================================================================================================" << endl;
-				cout << "================== ApoHSearch rotamer " << irot << " " << resn << " chis: ";
-				for( int i = 0; i < rot_index_p->rotamers_[irot].chi_.size(); ++i ) cout << " " << rot_index_p->rotamers_[irot].chi_[i];
-				cout << " ================== Progress: " << ijob+1 << " of " << rots.size() << " " << ijob*1.f/rots.size()*100.0f << "\% ==================" << endl;
-				// cout << "========================================================================================================" << endl;
-				omp_unset_lock(&cout_lock);
+				// out << "========================================================================================================" << endl;
+				out << "================== ApoHSearch rotamer " << irot << " " << resn << " chis: ";
+				for( int i = 0; i < rot_index_p->rotamers_[irot].chi_.size(); ++i ) out << " " << rot_index_p->rotamers_[irot].chi_[i];
+				out << " ================== Progress: " << ijob+1 << " of " << rots.size() << " " << ijob*1.f/rots.size()*100.0f << "\% ==================" << endl;
+				// out << "========================================================================================================" << endl;
 			}
 
-			Scene scene_proto(2);
-			float rotamer_radius = 0;
-			Eigen::Vector3f rotamer_center(0,0,0);
+			rs.scene_proto = make_shared<Scene>(2);
+			Scene & scene_proto( *rs.scene_proto );
+			float & rotamer_radius( rs.rotamer_radius );
+			Eigen::Vector3f & rotamer_center( rs.rotamer_center );
 			{
 				int firstatom = 3; // CB
 				if( rot_index_p->nchi(irot) == 0 ) firstatom = 0;
@@ -496,16 +524,9 @@ namespace rif {
 			}
 
 
-            struct RotChild {
-                int rotid;
-                Eigen::Vector3f Ncen, CAcen, Ccen;
-                Eigen::Vector3f CBcen;
-                // used for the cation-pi interaction
-                Eigen::Vector3f benzene_ring_center, imidazole_ring_center, ring_norm_vector;
-            };
-            std::vector<RotChild> inv_rotamer_backbones;
+            std::vector<RotChild> & inv_rotamer_backbones( rs.inv_rotamer_backbones );
             
-            std::cout << "RifGeneratorApoHSearch: add child rotamers:";
+            out << "RifGeneratorApoHSearch: add child rotamers:";
             for( size_t crot = 0; crot < rot_index_p->size(); ++crot ){
                 if( rot_index_p->structural_parent_of_.at(crot) == irot && rot_index_p->is_primary(crot) ){
                     RotChild child;
@@ -567,10 +588,10 @@ namespace rif {
                     auto primaryca = rot_index_p->atom(irot,3).position()-rotamer_center;
                     runtime_assert( (primaryca - testca).norm() < 0.001 );
                     inv_rotamer_backbones.push_back(child);
-                    std::cout << " " << resn << crot;
+                    out << " " << resn << crot;
                 }
             }
-            std::cout << std::endl;
+            out << std::endl;
 
 			float const half_tgt_resl = RESLS.front()/2.0;
 			float rot_resl_deg;
@@ -585,8 +606,9 @@ namespace rif {
 					 std::ceil( (ub0[2]-lb0[2])/half_tgt_resl*sqrt(3.0)/2.0 )   );
 			F3 lb = ( lb0 + ub0 - nc.template cast<float>() * half_tgt_resl/sqrt(3)*2.0 )/2.0;
 			F3 ub = ( lb0 + ub0 + nc.template cast<float>() * half_tgt_resl/sqrt(3)*2.0 )/2.0;
-			Director d( rot_resl_deg, lb, ub, nc, 1 );
-			std::cout << "NEST info base resl: " << (ub-lb)/nc.template cast<float>() << " " << rot_resl_deg << std::endl;
+			rs.director = make_shared<Director>( rot_resl_deg, lb, ub, nc, 1 );
+			Director & d( *rs.director );
+			out << "NEST info base resl: " << (ub-lb)/nc.template cast<float>() << " " << rot_resl_deg << std::endl;
 			// {
 				// cout << "NEST RAD " << rotamer_radius << endl;
 				// cout << "NEST ROT " << rot_resl_deg << endl;
@@ -603,7 +625,7 @@ namespace rif {
 
 
 
-			std::vector< Scene > scene_per_thread( omp_max_threads_1() );
+			std::vector< Scene > scene_per_thread( nthread_inner );
 			for( auto & s : scene_per_thread ) s = scene_proto;
 
 			Objective objective;
@@ -612,23 +634,25 @@ namespace rif {
 				samples[0].resize( d.nest_.size(0) );
 				for( uint64_t i = 0; i < d.nest_.size(0); ++i )	samples[0][i] = SearchPoint( i );
 
+			float const hsearch_score_cut = std::min( opts.abs_score_cut, abs_score_cut_by_res_thisres );
+
 			for( int r = 0; r < RESLS.size()-1; ++r){
 				if( 0 == samples[r].size() ) break;
-				cout << "Hstage: " << r << " resl: " << F(4,2,RESLS[r]) << " nsamp: " << KMGT(samples[r].size()) << " ";
-				int64_t const out_interval = samples[r].size()/50;
+				out << "Hstage: " << r << " resl: " << F(4,2,RESLS[r]) << " nsamp: " << KMGT(samples[r].size()) << " ";
+				int64_t const out_interval = std::max<int64_t>( 1, samples[r].size()/50 );
 				std::exception_ptr exception = nullptr;
 				#ifdef USE_OPENMP
-				#pragma omp parallel for schedule(dynamic,8192)
+				#pragma omp parallel for schedule(dynamic,8192) num_threads(nthread_inner) if(inner_parallel)
 				#endif
 				for( int64_t i = 0; i < samples[r].size(); ++i ){
 					if( exception ) continue;
 					try {
-						if( i%out_interval==0 ){
+						if( !concurrent && inner_parallel && i%out_interval==0 ){
 							cout << '*'; cout.flush();// (float)i/samples[r].size()*100.0 << "% "; cout.flush();
 						}
 						// uint64_t i = numeric::random::uniform()*d.nest_.size(0);
 						uint64_t const isamp = samples[r][i].index;
-						Scene & tscene( scene_per_thread[omp_get_thread_num()] );
+						Scene & tscene( scene_per_thread[ inner_parallel ? omp_get_thread_num() : 0 ] );
 						d.set_scene( isamp, r, tscene );
 						// this is necssary, lots seem to have the same score
 						samples[r][i].score = /*samples[r][i].rank =*/ objective( tscene, r ).template get<VoxelScore>();// - numeric::random::uniform()/1000.0;
@@ -653,57 +677,75 @@ namespace rif {
 					max_pt = *__gnu_parallel::max_element( samples[r].begin(), samples[r].end() );
 				}
 
-				float const hsearch_score_cut = std::min( opts.abs_score_cut, abs_score_cut_by_res_thisres );
-				omp_set_lock(&cout_lock);
-				cout << " branching: " << F(9,6,min_pt.score) << " to " << F(9,6, std::min(hsearch_score_cut,max_pt.score)) << endl;
-				omp_unset_lock(&cout_lock);
+				out << " branching: " << F(9,6,min_pt.score) << " to " << F(9,6, std::min(hsearch_score_cut,max_pt.score)) << endl;
 
 				// this hackyness is necessary.. don't want to explicidly build final samples vector... too big
 				if( r+2 >= samples.size() ) break;
 
-				// cout << "populating new sample array" << endl; // 26 sec for 2G... can speed up with threads?
-				std::vector< std::vector< SearchPoint > > samples_thread(omp_max_threads_1());
-
-				// #ifdef USE_OPENMP
-				// #pragma omp parallel for schedule(dynamic,1024)
-				// #endif
-				// for( int64_t i = 0; i < len; ++i ){
-				// 	if( samples[r][i].score > hsearch_score_cut ) continue;
-				// 	uint64_t isamp0 = samples[r][i].index;
-				// 	for( uint64_t j = 0; j < DIMPOW2; ++j ){
-				// 		uint64_t isamp = isamp0 * DIMPOW2 + j;
-				// 		samples_thread[omp_get_thread_num()].push_back( SearchPoint(isamp) );
-				// 	}
-				// }
-				// for( int i = 0; i < samples_thread.size(); ++i ){
-				// 	  std::copy ( samples_thread[i].begin(), samples_thread[i].end(), std::back_inserter( samples[r+1] ) );
-				// }
-				// samples[r+1].reserve( beam_size );
-				for( int64_t i = 0; i < len; ++i ){
-					if( samples[r][i].score > hsearch_score_cut ) continue;
-					uint64_t isamp0 = samples[r][i].index;
-					for( uint64_t j = 0; j < DIMPOW2; ++j ){
-						uint64_t isamp = isamp0 * DIMPOW2 + j;
-						samples[r+1].push_back( SearchPoint(isamp) );
+				// expand surviving parents in parallel: count survivors per chunk, prefix sum
+				// for output offsets, then each chunk writes its children in place. the child
+				// array is sized exactly once and the parent array is freed right after, so
+				// peak memory per stage is one beam of parents plus its children
+				int64_t const chunk = 8192;
+				int64_t const nchunk = ( len + chunk - 1 ) / chunk;
+				std::vector<int64_t> chunk_offset( nchunk+1, 0 );
+				#ifdef USE_OPENMP
+				#pragma omp parallel for schedule(static) num_threads(nthread_inner) if(inner_parallel)
+				#endif
+				for( int64_t ic = 0; ic < nchunk; ++ic ){
+					int64_t const end = std::min( len, (ic+1)*chunk );
+					for( int64_t i = ic*chunk; i < end; ++i ){
+						chunk_offset[ic+1] += samples[r][i].score <= hsearch_score_cut;
 					}
 				}
-				// cout << "done populating new sample array, clearing" << endl;
-				samples[r].clear();
+				for( int64_t ic = 0; ic < nchunk; ++ic ) chunk_offset[ic+1] += chunk_offset[ic];
+				samples[r+1].resize( chunk_offset[nchunk] * DIMPOW2 );
+				#ifdef USE_OPENMP
+				#pragma omp parallel for schedule(static) num_threads(nthread_inner) if(inner_parallel)
+				#endif
+				for( int64_t ic = 0; ic < nchunk; ++ic ){
+					int64_t const end = std::min( len, (ic+1)*chunk );
+					int64_t iout = chunk_offset[ic] * DIMPOW2;
+					for( int64_t i = ic*chunk; i < end; ++i ){
+						if( samples[r][i].score > hsearch_score_cut ) continue;
+						uint64_t isamp0 = samples[r][i].index;
+						for( uint64_t j = 0; j < DIMPOW2; ++j ){
+							samples[r+1][iout++] = SearchPoint( isamp0 * DIMPOW2 + j );
+						}
+					}
+				}
+				std::vector< SearchPoint >().swap( samples[r] );
 
 			}
 
+			// keep only the parents the final stage will expand
 			float const final_score_cut = std::min( opts.abs_score_cut, abs_score_cut_by_res_thisres );
-			uint64_t num_final_samples = 0;{
-				std::vector<uint64_t> tmp(omp_max_threads_1(),0);
-				#ifdef USE_OPENMP
-				#pragma omp parallel for schedule(dynamic,8192)
-				#endif
-				for( int64_t i = 0; i < samples[RESLS.size()-2].size(); ++i ){
-					tmp[omp_get_thread_num()] += ( samples[RESLS.size()-2][i].score < final_score_cut );
-				}
-				for( int i = 0; i < tmp.size(); ++i ) num_final_samples += tmp[i];
+			std::vector< SearchPoint > & last = samples[RESLS.size()-2];
+			rs.parents.clear();
+			for( int64_t i = 0; i < last.size(); ++i ){
+				if( last[i].score <= final_score_cut ) rs.parents.push_back( last[i] );
 			}
+			rs.parents.shrink_to_fit();
+
+			rs.log = buf.str();
+		};
+
+		// final stage for one rotamer, all threads
+		auto final_stage_rotamer = [&]( RotamerSearch & rs )
+		{
+			int const irot = rs.irot;
+			std::string const & resn = rs.resn;
+			float const abs_score_cut_by_res_thisres = rs.abs_score_cut_by_res_thisres;
+			Eigen::Vector3f const & rotamer_center = rs.rotamer_center;
+			std::vector<RotChild> const & inv_rotamer_backbones = rs.inv_rotamer_backbones;
+			std::vector<SearchPoint> const & parents = rs.parents;
+			Director & d( *rs.director );
+			Objective objective;
+			std::vector< Scene > scene_per_thread( omp_max_threads_1() );
+			for( auto & s : scene_per_thread ) s = *rs.scene_proto;
 
+			float const final_score_cut = std::min( opts.abs_score_cut, abs_score_cut_by_res_thisres );
+			uint64_t const num_final_samples = parents.size();
 
 			// final
 				float score_weight = 1.0;
@@ -719,17 +761,17 @@ namespace rif {
 				std::vector<TestHit> test_hits;
 				int r = RESLS.size()-1;
 				cout << "Hstage: " << r << " resl: " << F(4,2,RESLS.back()) << " nsamp: " << KMGT(num_final_samples*DIMPOW2) << " ";
-				int64_t const out_interval = samples[r-1].size()/50;
+				int64_t const out_interval = std::max<int64_t>( 1, parents.size()/50 );
 				float min_score = 9e9;
 				std::vector<double> avg_scores( omp_max_threads_1(), 0.0 );
 				std::vector<uint64_t> avg_scores_count( omp_max_threads_1(), 0 );
 				std::exception_ptr exception = nullptr;
 
 				int64_t block_size = 8192;
-				for( int64_t iblock = 0; iblock < samples[r-1].size()/block_size; ++iblock )
+				for( int64_t iblock = 0; iblock*block_size < parents.size(); ++iblock )
 				{
 					int64_t block_begin = iblock * block_size;
-					int64_t block_end = std::min<int64_t>( samples[r-1].size(), block_begin+block_size );
+					int64_t block_end = std::min<int64_t>( parents.size(), block_begin+block_size );
 
 					#ifdef USE_OPENMP
 					#pragma omp parallel for schedule(dynamic,1)
@@ -740,8 +782,8 @@ namespace rif {
 							if( i%out_interval==0 ){
 								cout << '*'; cout.flush();// (float)i/samples[r].size()*100.0 << "% "; cout.flush();
 							}
-							if( samples[r-1][i].score > final_score_cut ) continue;
-							uint64_t isamp0 = samples[r-1][i].index;
+							if( parents[i].score > final_score_cut ) continue;
+							uint64_t isamp0 = parents[i].index;
 							for( uint64_t j = 0; j < DIMPOW2; ++j ){
 								uint64_t isamp = isamp0 * DIMPOW2 + j;
 								Scene & tscene( scene_per_thread[omp_get_thread_num()] );
@@ -947,12 +989,61 @@ namespace rif {
 			}
 			test_hits.clear();
 
-			samples.back().clear();
+
+			std::vector<SearchPoint>().swap( rs.parents );
 
 			// rif_apo_vis_out.close();
+		};
+
+		// rotamers are handled in batches so at most max_parallel rotamer beams are alive at once.
+		// the rotamers of a batch split the threads between them, each searching in a nested
+		// parallel region on its share, so no batch size leaves threads idle
+		int const nthreads = omp_max_threads_1();
+		int const max_parallel = opts.max_parallel_rotamers > 0 ? std::min( opts.max_parallel_rotamers, nthreads ) : nthreads;
+		int const max_active_levels = omp_get_max_active_levels();
+		omp_set_max_active_levels( std::max( 2, max_active_levels ) );
+		for( int batch_begin = 0; batch_begin < rots.size(); batch_begin += max_parallel ){
+			int const batch_end = std::min<int>( rots.size(), batch_begin + max_parallel );
+			int const nbatch = batch_end - batch_begin;
+			bool const rotamer_parallel = nbatch > 1;
+			std::vector< RotamerSearch > batch( nbatch );
+			std::exception_ptr exception = nullptr;
+			#ifdef USE_OPENMP
+			#pragma omp parallel for schedule(static,1) num_threads(nbatch) if(rotamer_parallel)
+			#endif
+			for( int ijob = batch_begin; ijob < batch_end; ++ijob ){
+				if( exception ) continue;
+				try {
+					RotamerSearch & rs( batch[ijob-batch_begin] );
+					int const ibatch = ijob - batch_begin;
+					int const nthread_inner = nthreads / nbatch + ( ibatch < nthreads % nbatch );
+					// also limits the __gnu_parallel calls in this rotamer's search to its share
+					omp_set_num_threads( nthread_inner );
+					hsearch_rotamer( ijob, rs, nthread_inner, rotamer_parallel );
+					if( rotamer_parallel ){
+						omp_set_lock(&cout_lock);
+						cout << rs.log;
+						cout.flush();
+						omp_unset_lock(&cout_lock);
+					}
+				} catch( ... ) {
+					#ifdef USE_OPENMP
+					#pragma omp critical
+					#endif
+					exception = std::current_exception();
+				}
+			}
+			if( exception ){
+				omp_set_max_active_levels( max_active_levels );
+				std::rethrow_exception(exception);
+			}
 
+			for( auto & rs : batch ){
+				final_stage_rotamer( rs );
+				rs = RotamerSearch();
+			}
 		}
-
+		omp_set_max_active_levels( max_active_levels );
 
 		omp_destroy_lock( & cout_lock ) ;
 		omp_destroy_lock( & io_lock );
@@ -28,6 +28,7 @@ struct RifGeneratorApoHSearchOpts {
 	bool only_place_requirement_res = false;
 	float min_cationpi_score     = -0.2;
 	float cationpi_bonus_weights = 6.0;
+	int max_parallel_rotamers = 4; // each holds a beam of up to beam_size_M, <= 0 means one per thread
 };
 
 struct RifGeneratorApoHSearch : public RifGenerator {
@@ -51,6 +51,7 @@
 	#include <scheme/objective/storage/RotamerScores.hh>
 	#include <scheme/objective/voxel/FieldCache.hh>
 	// #include <scheme/objective/voxel/VoxelArray.hh>
+	#include <scheme/io/BulkArrayFile.hh>
 	#include <scheme/rosetta/score/RosettaField.hh>
 	#include <scheme/util/StoragePolicy.hh>
 
@@ -70,6 +71,8 @@ namespace devel {
 namespace scheme {
 namespace rif {
 
+// stored in the .rel_rot_pos.bin header, bump if make_hbond_geometries output changes
+static uint64_t const HBGEOM_CACHE_TAG = 1;
 
 struct hbjob_hbgeom_lessthan {
     inline bool operator() ( HBJob const & lhs, HBJob const & rhs ) {
@@ -181,22 +184,43 @@ RifGeneratorSimpleHbonds::prepare_hbgeoms(
                 cachefile += "__ex3_0";
                 cachefile += "__ex4_0";
                 cachefile += "__nrots"  + boost::lexical_cast<std::string>( nrots ) ;
-                cachefile += "__" + hbgeomtag + ".rel_rot_pos.gz";
-
+                cachefile += "__" + hbgeomtag + ".rel_rot_pos";
+            std::string const binfile = cachefile + ".bin";
+            std::string const gzfile  = cachefile + ".gz";
 
             bool failed_to_read = true;
+            bool need_to_save = true;
+
+            // preferred: bulk binary cache, one read or mmap + checksum
+            for( auto const & dir : cache_data_path ){
+                std::string fname = dir + "/" + binfile;
+                if( !utility::file::file_exists( fname ) ) continue;
+                if( ::scheme::io::read_bulk_array<RelRotPos>( fname, *cache, HBGEOM_CACHE_TAG, opts.hbgeom_cache_mmap ) ){
+                    if( ihbjob==start_job ){
+                        omp_set_lock(&cout_lock);
+                        cout << "load hbgeom " << fname << endl;
+                        cout << "            (will not log rest)" << endl;
+                        omp_unset_lock(&cout_lock);
+                    } else {
+                        std::cout << "*"; std::cout.flush();
+                    }
+                    failed_to_read = false;
+                    need_to_save = false;
+                    break;
+                }
+                omp_set_lock(&cout_lock);
+                cout << "WARNING: hbgeom cache " << fname << " is stale or corrupt, ignoring it" << endl;
+                omp_unset_lock(&cout_lock);
+            }
+
+            // legacy gzipped cache, converted to the binary format once read
             utility::io::izstream instream;
-            std::string cachefile_found = devel::scheme::open_for_read_on_path( cache_data_path, cachefile, instream );
+            std::string cachefile_found = failed_to_read ? devel::scheme::open_for_read_on_path( cache_data_path, gzfile, instream ) : "";
             if( cachefile_found.size() ){
 
-                if( ihbjob==start_job ){
-                    omp_set_lock(&cout_lock);
-                    cout << "load hbgeom " << cachefile_found << endl;
-                    cout << "            (will not log rest)" << endl;
-                    omp_unset_lock(&cout_lock);
-                } else {
-                    std::cout << "*"; std::cout.flush();
-                }
+                omp_set_lock(&cout_lock);
+                cout << "load legacy hbgeom " << cachefile_found << endl;
+                omp_unset_lock(&cout_lock);
 
                 size_t n;
                 runtime_assert( instream.good() );
@@ -226,6 +250,7 @@ RifGeneratorSimpleHbonds::prepare_hbgeoms(
                 mhbopts.tip_tol_deg    = opts.tip_tol_deg;
                 mhbopts.rot_samp_resl  = opts.rot_samp_resl;
                 mhbopts.rot_samp_range = opts.rot_samp_range;
+                hbond_geoms.clear(); // may hold a partial legacy read
                 devel::scheme::rif::make_hbond_geometries(
                     *rot_index_p,
                     don,
@@ -242,22 +267,25 @@ RifGeneratorSimpleHbonds::prepare_hbgeoms(
                     // std::cout << "WARNING: storing exemplar to cache!!!" << std::endl;
                 // }
 
+            }
+
+            if( need_to_save ){
+                utility::vector1< RelRotPos > const & hbond_geoms( *hbond_geoms_cache[hbgeomtag] );
                 size_t n = hbond_geoms.size();
-                utility::io::ozstream out;
-                std::string cachefile_found = devel::scheme::open_for_write_on_path( cache_data_path, cachefile, out, true );
-                if( cachefile_found.size() ){
-                    omp_set_lock(&cout_lock);
-                        cout << "SAVING " << KMGT(n) << " HBOND GEOMETRIES TO " << cachefile_found << endl;
-                    omp_unset_lock(&cout_lock);
-                    runtime_assert( out.good() );
-                    out.write( (char*)(&n), sizeof(size_t) );
-                    cout << n << endl;
-                    for(size_t i = 0; i < n; ++i){
-                        out.write( (char*)( &hbond_geoms[i+1] ), sizeof(RelRotPos) );
+                bool saved = false;
+                for( auto const & dir : cache_data_path ){
+                    if( !utility::file::file_exists( dir ) ) utility::file::create_directory_recursive( dir );
+                    std::string fname = dir + "/" + binfile;
+                    if( ::scheme::io::write_bulk_array( fname, hbond_geoms.data(), n, HBGEOM_CACHE_TAG ) ){
+                        omp_set_lock(&cout_lock);
+                            cout << "SAVING " << KMGT(n) << " HBOND GEOMETRIES TO " << fname << endl;
+                        omp_unset_lock(&cout_lock);
+                        saved = true;
+                        break;
                     }
-                    out.close();
-                } else {
-                    std::cout << "WARNING: can't save HBOND GEOMETRIES for " << cachefile << ", they will be regenerated every time!" << std::endl;
+                }
+                if( !saved ){
+                    std::cout << "WARNING: can't save HBOND GEOMETRIES for " << binfile << ", they will be regenerated every time!" << std::endl;
                 }
             }
 
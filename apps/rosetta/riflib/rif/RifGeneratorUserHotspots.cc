@@ -118,8 +118,7 @@ namespace rif {
 
         if ( opts.clear_sats_first ) {
             std::cout << "Clearing sats before hotspots..." << std::endl;
-            accumulator->condense();
-            accumulator->rif()->clear_sats();
+            accumulator->clear_sats();
         }
 
         // requirements definitions
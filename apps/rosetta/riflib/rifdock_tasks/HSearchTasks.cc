@@ -15,12 +15,15 @@
 #include <riflib/rifdock_tasks/OutputResultsTasks.hh>
 
 
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 
 #include <ObjexxFCL/format.hh>
+#include <utility/exit.hh>
 #include <boost/format.hpp>
 
 namespace devel {
@@ -77,6 +80,16 @@ DiversifyByNestTask::return_any_points(
 }
 
 
+// onebody tables and burial grids every later task expects
+static void
+setup_hsearch_scaffold( ScaffoldIndex si, RifDockData & rdd ) {
+    ScaffoldDataCacheOP sdc = rdd.scaffold_provider->get_data_cache_slow(si);
+    sdc->setup_onebody_tables( rdd.rot_index_p, rdd.opt);
+
+    if ( rdd.burial_manager ) {
+        sdc->setup_burial_grids( rdd.burial_manager );
+    }
+}
 
 shared_ptr<std::vector<SearchPoint>> 
 HSearchInit::return_search_points( 
@@ -89,23 +102,17 @@ HSearchInit::return_search_points(
 
     SelectiveRifDockIndexHasher   hasher( false, false, true );
     SelectiveRifDockIndexEquater equater( false, false, true );
-    std::unordered_map<RifDockIndex, bool, SelectiveRifDockIndexHasher, SelectiveRifDockIndexEquater> uniq_scaffolds (
-        1000, hasher, equater);
+    RifDockIndexSet uniq_scaffolds( 1000, hasher, equater );
 
     for ( SearchPoint const & sp : *search_points ) {
-        uniq_scaffolds[ sp.index ] = true;
+        uniq_scaffolds.insert( sp.index );
     }
 
     pd.unique_scaffolds.clear();
-    for ( std::pair<RifDockIndex, bool> pair : uniq_scaffolds ) {
-        ScaffoldIndex si = pair.first.scaffold_index;
-        ScaffoldDataCacheOP sdc = rdd.scaffold_provider->get_data_cache_slow(si);
-        sdc->setup_onebody_tables( rdd.rot_index_p, rdd.opt);
+    for ( RifDockIndex const & rdi : uniq_scaffolds.keys() ) {
+        ScaffoldIndex si = rdi.scaffold_index;
+        setup_hsearch_scaffold( si, rdd );
         pd.unique_scaffolds.push_back(si);
-
-        if ( rdd.burial_manager ) {
-            sdc->setup_burial_grids( rdd.burial_manager );
-        }
     }
 
 
@@ -127,6 +134,49 @@ HSearchInit::return_search_points(
     return search_points;
 }
 
+void
+HSearchInit::restore_for_resume( RifDockData & rdd, ProtocolData & pd ) {
+    for ( ScaffoldIndex si : pd.unique_scaffolds ) {
+        setup_hsearch_scaffold( si, rdd );
+    }
+}
+
+
+// -test_hsearch_score_bound: score every sample again without the bound. Whatever is under the beam
+//  cut must come out the same, otherwise the bound changed which samples HSearchFilterSortTask keeps
+static void
+test_score_bound(
+    std::vector<SearchPoint> & search_points,
+    uint64_t keeping,
+    int rif_resl,
+    std::function<void( std::function<bool(int64_t)> const & )> const & score_samples ) {
+
+    std::vector<float> with_bound( search_points.size() );
+    for ( int64_t i = 0; i < search_points.size(); i++ ) with_bound[i] = search_points[i].score;
+
+    score_samples( nullptr );
+
+    float beam_cut = std::numeric_limits<float>::max();
+    if ( search_points.size() > keeping ) {
+        std::vector<float> scores( search_points.size() );
+        for ( int64_t i = 0; i < search_points.size(); i++ ) scores[i] = search_points[i].score;
+        std::nth_element( scores.begin(), scores.begin() + keeping, scores.end() );
+        beam_cut = scores[keeping];
+    }
+
+    uint64_t nbeam = 0, nchanged = 0;
+    for ( int64_t i = 0; i < search_points.size(); i++ ) {
+        if ( search_points[i].score >= beam_cut && with_bound[i] >= beam_cut ) continue;
+        nbeam++;
+        nchanged += with_bound[i] != search_points[i].score;
+    }
+    std::cout << std::endl << "HSearsh stage " << rif_resl+1 << " score bound test: " << nchanged << " of "
+              << nbeam << " samples in the beam scored differently with the bound" << std::endl;
+    if ( nchanged ) {
+        utility_exit_with_message( "-hsearch_score_bound changed the beam" );
+    }
+}
+
 
 shared_ptr<std::vector<SearchPoint>> 
 HSearchScoreAtReslTask::return_search_points( 
@@ -158,80 +208,168 @@ HSearchScoreAtReslTask::return_search_points(
     start = std::chrono::high_resolution_clock::now();
     pd.total_search_effort += search_points.size();
 
-    #ifdef USE_OPENMP
-    #pragma omp parallel for schedule(dynamic,64)
-    #endif
-    for( int64_t i = 0; i < search_points.size(); ++i ){
-        if( exception ) continue;
-        try {
-            if( i%out_interval==0 ){ cout << '*'; cout.flush(); }
-            RifDockIndex const isamp = search_points[i].index;
+    // only valid if these are exactly the children HSearchScaleToReslTask made for this resl
+    shared_ptr<HSearchResidueHints> hints = rdd.rso_config.residue_hints;
+    bool const use_parent_hits = hints && pd.hsearch_parent_hit_words > 0
+                                 && pd.hsearch_parent_hits_resl == director_resl_
+                                 && pd.hsearch_parent_hits_nsamples == search_points.size();
+
+    // With a score bound, every bound_stride'th sample is scored in full first and the beam cut is
+    //  estimated from that pilot. The rest are scored against it, see HSearchScoreBound. If fewer
+    //  than keeping samples beat the estimate it was too strict and the bounded ones are rescored.
+    shared_ptr<HSearchScoreBound> bound = rdd.rso_config.score_bound;
+    uint64_t const keeping = bound_num_to_keep_ * pd.beam_multiplier;
+    uint64_t const BOUND_PILOT_SIZE = 20000;
+    bool const use_bound = bound && bound_num_to_keep_ > 0 && search_points.size() > 2 * BOUND_PILOT_SIZE;
+    int64_t const bound_stride = use_bound ? search_points.size() / BOUND_PILOT_SIZE : 1;
+    std::vector<uint8_t> bounded;
+    if ( use_bound ) {
+        bound->clear();
+        bounded.resize( search_points.size(), 0 );
+    }
 
-            ScenePtr tscene( rdd.scene_pt[omp_get_thread_num()] );
-            bool director_success = rdd.director->set_scene( isamp, director_resl_, *tscene );
-            if ( ! director_success ) {
-                search_points[i].score = 9e9;
-                continue;
-            }
+    auto score_sample = [&]( int64_t i ) {
+        RifDockIndex const isamp = search_points[i].index;
 
-            if ( need_sdc ) {
-                ScaffoldIndex si = isamp.scaffold_index;
-                ScaffoldDataCacheOP sdc = rdd.scaffold_provider->get_data_cache_slow(si);
-
-                if( tether_to_input_position_cut_ > 0 ){
-                    float redundancy_filter_rg = sdc->get_redundancy_filter_rg( rdd.target_redundancy_filter_rg );
-
-                    EigenXform x;// = tscene->position(1);
-                    rdd.nest.get_state( isamp.nest_index, director_resl_, x );
-                    x.translation() -= sdc->scaffold_center;
-                    float xmag =  xform_magnitude( x, redundancy_filter_rg );
-                    if( xmag > tether_to_input_position_cut_ + rdd.RESLS[rif_resl_] ){
-                        search_points[i].score = 9e9;
-                        continue;
-                    } 
-                }
+        ScenePtr tscene( rdd.scene_pt[omp_get_thread_num()] );
+        bool director_success = rdd.director->set_scene( isamp, director_resl_, *tscene );
+        if ( ! director_success ) {
+            search_points[i].score = 9e9;
+            return;
+        }
 
-                /////////////////////////////////////////////////////
-                /////// Longxing' code  ////////////////////////////
-                ////////////////////////////////////////////////////
-                if (using_csts) {
-                    EigenXform x = tscene->position(1);
-                    bool pass_all = true;
-                    for(CstBaseOP p : sdc->csts) {
-                        if (!p->apply( x )) {
-                            pass_all = false;
-                            break;
-                        }
-                    }
-                    if (!pass_all) {
-                        search_points[i].score = 9e9;
-                        continue;
+        if ( need_sdc ) {
+            ScaffoldIndex si = isamp.scaffold_index;
+            ScaffoldDataCacheOP sdc = rdd.scaffold_provider->get_data_cache_slow(si);
+
+            if( tether_to_input_position_cut_ > 0 ){
+                float redundancy_filter_rg = sdc->get_redundancy_filter_rg( rdd.target_redundancy_filter_rg );
+
+                EigenXform x;// = tscene->position(1);
+                rdd.nest.get_state( isamp.nest_index, director_resl_, x );
+                x.translation() -= sdc->scaffold_center;
+                float xmag =  xform_magnitude( x, redundancy_filter_rg );
+                if( xmag > tether_to_input_position_cut_ + rdd.RESLS[rif_resl_] ){
+                    search_points[i].score = 9e9;
+                    return;
+                } 
+            }
+
+            /////////////////////////////////////////////////////
+            /////// Longxing' code  ////////////////////////////
+            ////////////////////////////////////////////////////
+            if (using_csts) {
+                EigenXform x = tscene->position(1);
+                bool pass_all = true;
+                for(CstBaseOP p : sdc->csts) {
+                    if (!p->apply( x )) {
+                        pass_all = false;
+                        break;
                     }
                 }
+                if (!pass_all) {
+                    search_points[i].score = 9e9;
+                    return;
+                }
             }
+        }
 
-            // the real rif score!!!!!!
-            std::vector<float> scores;
-            search_points[i].score = rdd.objectives[rif_resl_]->score( *tscene, scores );
+        if ( use_parent_hits ) {
+            hints->slot( omp_get_thread_num() ).probe_only =
+                &pd.hsearch_parent_hits[ ( i / pd.hsearch_children_per_parent ) * pd.hsearch_parent_hit_words ];
+        }
 
-            search_points[i].sasa = (uint16_t) ( scores[3] / SASA_SUBVERT_MULTIPLIER );
+        // the real rif score!!!!!!
+        std::vector<float> scores;
+        search_points[i].score = rdd.objectives[rif_resl_]->score( *tscene, scores );
 
-            // search_points[i].score = rdd.objectives[rif_resl_]->score( *tscene );// + tot_sym_score;
+        search_points[i].sasa = (uint16_t) ( scores[3] / SASA_SUBVERT_MULTIPLIER );
 
+        if ( use_bound && bound->active() && bound->slot( omp_get_thread_num() ).bounded ) bounded[i] = 1;
 
-        } catch( std::exception const & ex ) {
-            #ifdef USE_OPENMP
-            #pragma omp critical
-            #endif
-            exception = std::current_exception();
+        // search_points[i].score = rdd.objectives[rif_resl_]->score( *tscene );// + tot_sym_score;
+    };
+
+    // scores the samples for which which(i) is true, or all of them
+    auto score_samples = [&]( std::function<bool(int64_t)> const & which ) {
+        #ifdef USE_OPENMP
+        #pragma omp parallel for schedule(dynamic,64)
+        #endif
+        for( int64_t i = 0; i < search_points.size(); ++i ){
+            if( exception ) continue;
+            if( which && ! which(i) ) continue;
+            try {
+                if( i%out_interval==0 ){ cout << '*'; cout.flush(); }
+                score_sample( i );
+            } catch( std::exception const & ex ) {
+                #ifdef USE_OPENMP
+                #pragma omp critical
+                #endif
+                exception = std::current_exception();
+            }
+        }
+    };
+
+    float bound_cut = HSearchScoreBound::NO_CUTOFF;
+    if ( ! use_bound ) {
+        score_samples( nullptr );
+    } else {
+        score_samples( [bound_stride]( int64_t i ){ return i % bound_stride == 0; } );
+
+        // aim wide of the keeping'th score so the rescore pass is rarely needed
+        std::vector<float> pilot;
+        for ( int64_t i = 0; i < search_points.size(); i += bound_stride ) pilot.push_back( search_points[i].score );
+        uint64_t const ipilot = 2 * keeping * pilot.size() / search_points.size() + 16;
+        if ( ! exception && ipilot < pilot.size() ) {
+            std::nth_element( pilot.begin(), pilot.begin() + ipilot, pilot.end() );
+            bound_cut = std::min<float>( pilot[ipilot], rdd.opt.global_score_cut );
+            bound->set_cutoff( bound_cut );
+        }
+
+        score_samples( [bound_stride]( int64_t i ){ return i % bound_stride != 0; } );
+        bound->clear();
+
+        uint64_t nbounded = 0, nbeat = 0;
+        for ( int64_t i = 0; i < search_points.size(); i++ ) {
+            nbounded += bounded[i];
+            nbeat += search_points[i].score < bound_cut;
+        }
+        // samples bounded at the global cut would be dropped anyway
+        bool const rescore = nbeat < keeping && bound_cut < rdd.opt.global_score_cut;
+        if ( nbounded ) {
+            cout << endl << "HSearsh stage " << rif_resl_+1 << " bounded " << KMGT(nbounded) << " samples at score " << F(7,3,bound_cut);
+            if ( rescore ) cout << ", only " << KMGT(nbeat) << " beat it, rescoring them ";
+        }
+        if ( rescore && nbounded ) {
+            score_samples( [&bounded]( int64_t i ){ return bounded[i] != 0; } );
+        }
+        if ( rdd.opt.test_hsearch_score_bound && ! exception ) {
+            test_score_bound( search_points, keeping, rif_resl_, score_samples );
+        }
+        if ( pd.perf_report ) {
+            pd.perf_report->add_count( name(), rif_resl_, "samples_bounded", rescore ? 0 : nbounded );
         }
     }
+    if ( hints ) hints->clear();
+    pd.hsearch_parent_hits.clear();
+    pd.hsearch_parent_hits.shrink_to_fit();
+    pd.hsearch_parent_hit_words = 0;
     if( exception ) std::rethrow_exception(exception);
     end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed_seconds_rif = end-start;
     pd.hsearch_rate = (double)search_points.size()/ elapsed_seconds_rif.count()/omp_max_threads();
     cout << endl;// << "done threaded sampling, partitioning data..." << endl;
 
+    if ( pd.perf_report ) {
+        pd.perf_report->add_count( name(), rif_resl_, "samples_scored", search_points.size() );
+        if ( rif_resl_ < rdd.rso_config.rif_probe_counters.size() && rdd.rso_config.rif_probe_counters[rif_resl_] ) {
+            ::scheme::util::ThreadCounters & counters = *rdd.rso_config.rif_probe_counters[rif_resl_];
+            pd.perf_report->add_count( name(), rif_resl_, "rif_hits", counters.total(0) );
+            pd.perf_report->add_count( name(), rif_resl_, "rif_misses", counters.total(1) );
+            counters.reset();
+        }
+    }
+
 
     return search_points_p;
 }
@@ -272,6 +410,69 @@ HSearchFilterSortTask::return_search_points(
     return search_points_p;
 }
 
+// Rescore the parents that are about to be expanded, recording which residues had any rif hit.
+// This is one extra evaluation per parent, i.e. 1/DIMPOW2 of the cost of scoring the children.
+// Parents are at director resl == rif resl here, as HSearchScoreAtReslTask is set up in the hsearch protocols.
+static void
+record_parent_hits(
+    std::vector<SearchPoint> const & parents,
+    size_t nparents,
+    int children_per_parent,
+    RifDockData & rdd,
+    ProtocolData & pd,
+    int resl ) {
+
+    HSearchResidueHints & hints = *rdd.rso_config.residue_hints;
+
+    int max_nres = 0;
+    for ( ScaffoldIndex si : pd.unique_scaffolds ) {
+        ScaffoldDataCacheOP sdc = rdd.scaffold_provider->get_data_cache_slow(si);
+        max_nres = std::max<int>( max_nres, sdc->scaffres_l2g_p->size() );
+    }
+    int const words = HSearchResidueHints::words( max_nres );
+
+    pd.hsearch_parent_hits.assign( nparents * words, 0 );
+    pd.hsearch_parent_hit_words = 0;
+
+    std::exception_ptr exception = nullptr;
+    #ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic,64)
+    #endif
+    for( int64_t i = 0; i < nparents; ++i ){
+        if( exception ) continue;
+        try {
+            ScenePtr tscene( rdd.scene_pt[omp_get_thread_num()] );
+            uint64_t * hits = &pd.hsearch_parent_hits[ i * words ];
+            if ( ! rdd.director->set_scene( parents[i].index, resl, *tscene ) ) {
+                // nothing to learn, probe everything in the children
+                std::fill( hits, hits + words, ~uint64_t(0) );
+                continue;
+            }
+            hints.slot( omp_get_thread_num() ).record_hits = hits;
+            rdd.objectives[resl]->score( *tscene );
+            hints.slot( omp_get_thread_num() ).record_hits = nullptr;
+        } catch( std::exception const & ex ) {
+            #ifdef USE_OPENMP
+            #pragma omp critical
+            #endif
+            exception = std::current_exception();
+        }
+    }
+    hints.clear();
+    if( exception ) std::rethrow_exception(exception);
+
+    uint64_t nhit = 0;
+    for ( uint64_t word : pd.hsearch_parent_hits ) nhit += __builtin_popcountll( word );
+
+    pd.hsearch_parent_hit_words = words;
+    pd.hsearch_children_per_parent = children_per_parent;
+    pd.hsearch_parent_hits_resl = resl + 1;
+    pd.hsearch_parent_hits_nsamples = nparents * children_per_parent;
+
+    std::cout << "HSearsh stage " << resl+2 << " will probe " << KMGT( nhit ) << " of " << KMGT( (double)nparents * max_nres )
+              << " parent residues, the rest had no rif hits" << std::endl;
+}
+
 shared_ptr<std::vector<SearchPoint>> 
 HSearchScaleToReslTask::return_search_points( 
     shared_ptr<std::vector<SearchPoint>> search_points_p, 
@@ -300,6 +501,10 @@ HSearchScaleToReslTask::return_search_points(
 
         if( current_resl_ == 0 ) pd.non0_space_size += good_points;
 
+        if ( rdd.rso_config.residue_hints && num_resls == 1 && current_resl_ < rdd.objectives.size() ) {
+            record_parent_hits( search_points, good_points, use_pow2, rdd, pd, current_resl_ );
+        }
+
         out_points.resize( use_pow2 * good_points );
 
         #ifdef USE_OPENMP
@@ -324,20 +529,18 @@ HSearchScaleToReslTask::return_search_points(
 
         SelectiveRifDockIndexHasher   hasher( true, true, true );
         SelectiveRifDockIndexEquater equater( true, true, true );
-        std::unordered_map<RifDockIndex, bool, SelectiveRifDockIndexHasher, SelectiveRifDockIndexEquater> uniq_positions(
-            search_points.size()/100 + 1000, hasher, equater );
+        RifDockIndexSet uniq_positions( search_points.size()/100 + 1000, hasher, equater );
 
         for ( SearchPoint const & sp : search_points ) {
             RifDockIndex rdi = sp.index;
             rdi.nest_index = rdi.nest_index >> shift_factor;
-            uniq_positions[rdi] = true;
+            uniq_positions.insert( rdi );
         }
 
         out_points.resize(uniq_positions.size());
 
-        int added = 0;
-        for ( std::pair<RifDockIndex, bool> pair : uniq_positions ) {
-            out_points[added++] = pair.first;
+        for ( size_t i = 0; i < uniq_positions.size(); i++ ) {
+            out_points[i] = uniq_positions[i];
         }
 
         std::cout << "Num uniq positions: " << out_points.size() << std::endl;
@@ -351,6 +554,103 @@ HSearchScaleToReslTask::return_search_points(
 
 }
 
+shared_ptr<std::vector<SearchPoint>> 
+HSearchRefineNeighborsTask::return_search_points( 
+    shared_ptr<std::vector<SearchPoint>> search_points_p, 
+    RifDockData & rdd, 
+    ProtocolData & pd ) {
+
+    using ObjexxFCL::format::F;
+
+    std::vector<SearchPoint> & search_points = *search_points_p;
+    if ( n_best_ <= 0 || max_rounds_ <= 0 || search_points.empty() ) return search_points_p;
+
+    int64_t const n_best = std::min<int64_t>( n_best_, search_points.size() );
+    __gnu_parallel::nth_element( search_points.begin(), search_points.begin() + n_best - 1, search_points.end() );
+
+    std::vector<SearchPoint> frontier;
+    for ( int64_t i = 0; i < n_best; i++ ) {
+        if ( search_points[i].score < global_score_cut_ ) frontier.push_back( search_points[i] );
+    }
+    float const worst_refined = frontier.size() ? std::max_element( frontier.begin(), frontier.end() )->score : 0;
+
+    SelectiveRifDockIndexHasher   hasher( true, true, true );
+    SelectiveRifDockIndexEquater equater( true, true, true );
+    RifDockIndexSet seen( frontier.size() * 64 + 1000, hasher, equater );
+    for ( SearchPoint const & sp : frontier ) seen.insert( sp.index );
+
+    // scoring is identical to the hsearch itself, including tether and constraints
+    HSearchScoreAtReslTask scorer( director_resl_, rif_resl_, tether_to_input_position_cut_ );
+
+    std::cout << "Refining NEST neighbors of " << KMGT( frontier.size() ) << " best points, resl " << F(5,2,rdd.RESLS[rif_resl_]) << std::endl;
+
+    int64_t total_scored = 0, total_kept = 0, total_better = 0;
+    std::vector<uint64_t> nbrs;
+    for ( int iround = 0; iround < max_rounds_ && frontier.size(); iround++ ) {
+
+        // neighbors not yet seen, remembering the score of the point they came from
+        shared_ptr<std::vector<SearchPoint>> candidates_p = make_shared<std::vector<SearchPoint>>();
+        std::vector<SearchPoint> & candidates = *candidates_p;
+        std::vector<float> source_score;
+        // candidates[i] has candidate_slot index i
+        RifDockIndexSet candidate_slot( frontier.size() * 64 + 1000, hasher, equater );
+        for ( SearchPoint const & sp : frontier ) {
+            nbrs.clear();
+            rdd.nest.get_neighbors_for_index( sp.index.nest_index, director_resl_, std::back_inserter( nbrs ) );
+            for ( uint64_t nbr : nbrs ) {
+                RifDockIndex rdi = sp.index;
+                rdi.nest_index = nbr;
+                if ( ! seen.insert( rdi ).second ) continue;
+                candidate_slot.insert( rdi );
+                candidates.push_back( SearchPoint( rdi ) );
+                source_score.push_back( sp.score );
+            }
+        }
+
+        // drop neighbors the hsearch already scored
+        std::vector<bool> already_scored( candidates.size(), false );
+        for ( SearchPoint const & sp : search_points ) {
+            size_t slot = candidate_slot.find( sp.index );
+            if ( slot != RifDockIndexSet::npos ) already_scored[ slot ] = true;
+        }
+        size_t n_new = 0;
+        for ( size_t i = 0; i < candidates.size(); i++ ) {
+            if ( already_scored[i] ) continue;
+            candidates[n_new] = candidates[i];
+            source_score[n_new] = source_score[i];
+            n_new++;
+        }
+        candidates.resize( n_new );
+        source_score.resize( n_new );
+        if ( candidates.empty() ) break;
+
+        scorer.return_search_points( candidates_p, rdd, pd );
+        total_scored += candidates.size();
+
+        frontier.clear();
+        for ( size_t i = 0; i < candidates.size(); i++ ) {
+            SearchPoint const & sp = candidates[i];
+            if ( sp.score >= global_score_cut_ ) continue;
+            search_points.push_back( sp );
+            total_kept++;
+            if ( sp.score < worst_refined ) total_better++;
+            if ( sp.score < source_score[i] ) frontier.push_back( sp );
+        }
+        std::cout << "Refine round " << iround+1 << " scored " << KMGT( candidates.size() ) << ", " << KMGT( frontier.size() )
+                  << " improved on their source" << std::endl;
+    }
+
+    std::cout << "Refine done, scored " << KMGT( total_scored ) << " neighbors, kept " << KMGT( total_kept ) << ", "
+              << KMGT( total_better ) << " better than the worst refined point " << F(7,3,worst_refined) << std::endl;
+
+    if ( pd.perf_report ) {
+        pd.perf_report->add_count( name(), rif_resl_, "neighbors_scored", total_scored );
+        pd.perf_report->add_count( name(), rif_resl_, "neighbors_kept", total_kept );
+    }
+
+    return search_points_p;
+}
+
 shared_ptr<std::vector<SearchPoint>> 
 HSearchFinishTask::return_search_points( 
     shared_ptr<std::vector<SearchPoint>> search_points_p, 
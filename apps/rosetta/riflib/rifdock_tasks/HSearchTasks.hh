@@ -71,17 +71,24 @@ struct HSearchInit : public SearchPointTask {
         RifDockData & rdd, 
         ProtocolData & pd ) override;
 
+    void
+    restore_for_resume( RifDockData & rdd, ProtocolData & pd ) override;
+
 };
 
 struct HSearchScoreAtReslTask : public SearchPointTask {
 
+    // bound_num_to_keep is the num_to_keep of the HSearchFilterSortTask that prunes these samples,
+    //  0 if they aren't pruned. With rso_config.score_bound it lets samples that can't make the beam stop early
     HSearchScoreAtReslTask(
         int director_resl,
         int rif_resl,
-        float tether_to_input_position_cut ) :
+        float tether_to_input_position_cut,
+        uint64_t bound_num_to_keep = 0 ) :
         director_resl_( director_resl ),
         rif_resl_( rif_resl ),
-        tether_to_input_position_cut_( tether_to_input_position_cut )
+        tether_to_input_position_cut_( tether_to_input_position_cut ),
+        bound_num_to_keep_( bound_num_to_keep )
         {}
 
     shared_ptr<std::vector<SearchPoint>> 
@@ -90,10 +97,13 @@ struct HSearchScoreAtReslTask : public SearchPointTask {
         RifDockData & rdd, 
         ProtocolData & pd ) override;
 
+    int report_resl() const override { return rif_resl_; }
+
 private:
     int director_resl_;
     int rif_resl_;
     float tether_to_input_position_cut_;
+    uint64_t bound_num_to_keep_;
 
 };
 
@@ -116,6 +126,8 @@ struct HSearchFilterSortTask : public SearchPointTask {
         RifDockData & rdd, 
         ProtocolData & pd ) override;
 
+    int report_resl() const override { return resl_; }
+
 private:
     int resl_;
     uint64_t num_to_keep_;
@@ -144,6 +156,8 @@ struct HSearchScaleToReslTask : public SearchPointTask {
         RifDockData & rdd, 
         ProtocolData & pd ) override;
 
+    int report_resl() const override { return current_resl_; }
+
 private:
     int current_resl_;
     int target_resl_;
@@ -152,6 +166,44 @@ private:
 
 };
 
+// Score the NEST neighbors (same resl, +-1 bin in each dimension) of the best n_best points.
+// Further rounds expand only the neighbors that beat the point they came from.
+// Recovers good positions whose parents fell out of the beam.
+struct HSearchRefineNeighborsTask : public SearchPointTask {
+
+    HSearchRefineNeighborsTask(
+        int director_resl,
+        int rif_resl,
+        int64_t n_best,
+        int max_rounds,
+        float global_score_cut,
+        float tether_to_input_position_cut ) :
+        director_resl_( director_resl ),
+        rif_resl_( rif_resl ),
+        n_best_( n_best ),
+        max_rounds_( max_rounds ),
+        global_score_cut_( global_score_cut ),
+        tether_to_input_position_cut_( tether_to_input_position_cut )
+        {}
+
+    shared_ptr<std::vector<SearchPoint>> 
+    return_search_points( 
+        shared_ptr<std::vector<SearchPoint>> search_points, 
+        RifDockData & rdd, 
+        ProtocolData & pd ) override;
+
+    int report_resl() const override { return rif_resl_; }
+
+private:
+    int director_resl_;
+    int rif_resl_;
+    int64_t n_best_;
+    int max_rounds_;
+    float global_score_cut_;
+    float tether_to_input_position_cut_;
+
+};
+
 struct HSearchFinishTask : public SearchPointTask {
 
     HSearchFinishTask(
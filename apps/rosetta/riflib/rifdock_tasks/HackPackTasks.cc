@@ -89,14 +89,6 @@ HackPackTask::return_search_point_with_rotss(
         rdd.scaffold_provider->setup_twobody_tables( si );
     }
 
-    if ( rdd.unsat_manager ) {
-        std::cout << "Building twobody tables per thread for unsats" << std::endl;
-        for( int ipack = 0; ipack < pd.npack; ++ipack ) {
-            ScaffoldIndex si = packed_results[ipack].index.scaffold_index;
-            rdd.scaffold_provider->setup_twobody_tables_per_thread( si );
-        }
-    }
-
     print_header( "hack-packing top " + KMGT(pd.npack) );
 
     std::cout << "packing options: " << rdd.packopts << std::endl;
@@ -176,6 +168,8 @@ HackPackTask::return_search_point_with_rotss(
     std::chrono::duration<double> elapsed_seconds_all_pack = std::chrono::high_resolution_clock::now()-start_pack;
     pd.time_pck += elapsed_seconds_all_pack.count();
 
+    if ( pd.perf_report ) pd.perf_report->add_count( name(), rif_resl_, "packs", pd.npack );
+
 
     return packed_results_p;
 }
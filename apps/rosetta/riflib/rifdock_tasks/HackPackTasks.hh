@@ -91,6 +91,8 @@ struct HackPackTask : public SearchPointWithRotsTask {
         ProtocolData & pd ) override;
 
 
+    int report_resl() const override { return rif_resl_; }
+
 private:
     int director_resl_;
     int rif_resl_;
@@ -21,6 +21,7 @@
 #include <riflib/rifdock_tasks/UtilTasks.hh>
 #include <riflib/rifdock_tasks/HackPackTasks.hh>
 #include <riflib/rifdock_tasks/SeedingPositionTasks.hh>
+#include <riflib/rifdock_tasks/ShardTasks.hh>
 
 
 
@@ -114,9 +115,13 @@ create_dive_pop_hsearch_task(
 
     task_list.push_back(make_shared<DiversifyBySeedingPositionsTask>()); // this is a no-op if there are no seeding positions
     task_list.push_back(make_shared<DiversifyByNestTask>( 0 ));
+    if ( rdd.opt.num_shards > 1 ) {
+        task_list.push_back(make_shared<ShardSearchSpaceTask>( rdd.opt.shard_index, rdd.opt.num_shards ));
+    }
     task_list.push_back(make_shared<HSearchInit>( ));
     for ( int i = 0; i <= rdd.opt.dive_resl-1; i++ ) {
-        task_list.push_back(make_shared<HSearchScoreAtReslTask>( i, i, rdd.opt.tether_to_input_position_cut ));
+        task_list.push_back(make_shared<HSearchScoreAtReslTask>( i, i, rdd.opt.tether_to_input_position_cut,
+                                                                  i < rdd.opt.dive_resl-1 ? rdd.opt.beam_size / rdd.opt.DIMPOW2 : 0 ));
 
         if (rdd.opt.hack_pack_during_hsearch) {
             task_list.push_back(make_shared<SortByScoreTask>( ));
@@ -144,7 +149,8 @@ create_dive_pop_hsearch_task(
 
     task_list.push_back(make_shared<HSearchInit>( ));
     for ( int i = rdd.opt.pop_resl-1; i <= rdd.RESLS.size()-1; i++ ) {
-        task_list.push_back(make_shared<HSearchScoreAtReslTask>( i, i, rdd.opt.tether_to_input_position_cut ));
+        task_list.push_back(make_shared<HSearchScoreAtReslTask>( i, i, rdd.opt.tether_to_input_position_cut,
+                                                                  i < rdd.RESLS.size()-1 ? rdd.opt.beam_size / rdd.opt.DIMPOW2 : 0 ));
 
         if (rdd.opt.hack_pack_during_hsearch) {
             task_list.push_back(make_shared<SortByScoreTask>( ));
@@ -57,7 +57,8 @@ struct TestMakeChildrenTask : public SearchPointTask {
         RifDockData & rdd, 
         ProtocolData & pd ) override;
 
-
+    // the children only exist in memory
+    bool checkpointable() const override { return false; }
 
 private:
 
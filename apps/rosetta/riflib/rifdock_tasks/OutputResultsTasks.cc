@@ -15,6 +15,7 @@
 #include <riflib/rifdock_tasks/HackPackTasks.hh>
 #include <riflib/ScoreRotamerVsTarget.hh>
 #include <riflib/RifFactory.hh>
+#include <riflib/AsyncFileWriter.hh>
 
 #include <core/chemical/ChemicalManager.hh>
 #include <core/chemical/ResidueTypeSet.hh>
@@ -88,10 +89,20 @@ OutputResultsTask::return_rif_dock_results(
 
     if( rdd.opt.align_to_scaffold ) std::cout << "ALIGN TO SCAFFOLD" << std::endl;
     else                        std::cout << "ALIGN TO TARGET"   << std::endl;
+
+    // With output_async, compression and disk writes happen on a background thread
+    //  while the next result is being built
+    shared_ptr<AsyncFileWriter> writer;
+    if ( rdd.opt.output_async ) {
+        writer = make_shared<AsyncFileWriter>( (size_t)std::max( 1, rdd.opt.output_queue_MB ) << 20, rdd.opt.output_gz_level );
+    }
+
+    std::string silent_fname;
     utility::io::ozstream out_silent_stream; // Final stream to write to
     if ( rdd.opt.outputsilent || rdd.opt.outputlite ) {
         ScaffoldDataCacheOP example_data_cache = rdd.scaffold_provider->get_data_cache_slow( ScaffoldIndex() );
-        out_silent_stream.open_append( rdd.opt.outdir + "/" + example_data_cache->scafftag + ".silent" );
+        silent_fname = rdd.opt.outdir + "/" + example_data_cache->scafftag + ".silent";
+        if ( ! writer ) out_silent_stream.open_append( silent_fname );
     }
 
     if ( rdd.opt.parallelwrite ) {
@@ -110,7 +121,8 @@ OutputResultsTask::return_rif_dock_results(
                 int const ithread = omp_get_thread_num();
                 RifDockResult const & selected_result = selected_results.at( i_selected_result );
 
-                write_selected_result( selected_result, rdd.scene_pt[ ithread ], iostreams[ ithread ], rdd, pd, i_selected_result );
+                write_selected_result( selected_result, rdd.scene_pt[ ithread ], iostreams[ ithread ], rdd, pd, i_selected_result,
+                                                                                                    writer.get(), silent_fname );
 
             } catch(...) {
                 #pragma omp critical
@@ -120,14 +132,23 @@ OutputResultsTask::return_rif_dock_results(
         if( exception ) std::rethrow_exception( exception );
 
         // Write all the streams to the output file
-        if ( rdd.opt.outputsilent || rdd.opt.outputlite )
+        if ( ( rdd.opt.outputsilent || rdd.opt.outputlite ) && ! writer )
             for( int i  = 0; i < ::devel::scheme::omp_max_threads(); ++i ) out_silent_stream << iostreams[ i ].str();
 
     } else {
         // Default behavior
         for( int i_selected_result = 0; i_selected_result < selected_results.size(); ++i_selected_result ){
             RifDockResult const & selected_result = selected_results.at( i_selected_result );
-            write_selected_result( selected_result, rdd.scene_pt.front(), out_silent_stream, rdd, pd, i_selected_result );
+            write_selected_result( selected_result, rdd.scene_pt.front(), out_silent_stream, rdd, pd, i_selected_result,
+                                                                                                    writer.get(), silent_fname );
+        }
+    }
+
+    if ( writer ) {
+        std::vector<std::string> failed = writer->flush();
+        std::cout << "async output wrote " << KMGT( writer->bytes_written() ) << "B" << std::endl;
+        if ( failed.size() ) {
+            utility_exit_with_message( "failed to write " + str( failed.size() ) + " output files, first: " + failed.front() );
         }
     }
 
@@ -142,7 +163,9 @@ OutputResultsTask::write_selected_result(
     std::ostream & out_silent_stream,
     RifDockData & rdd,
     ProtocolData & pd,
-    int i_selected_result ) {
+    int i_selected_result,
+    AsyncFileWriter * writer,
+    std::string const & silent_fname ) {
 
     using std::cout;
     using std::endl;
@@ -248,7 +271,14 @@ OutputResultsTask::write_selected_result(
     std::cout << oss.str();
     rdd.dokout << oss.str(); rdd.dokout.flush();
 
-    dump_rif_result_(rdd, selected_result, pdboutfile, director_resl_, rif_resl_, out_silent_stream, rdd.scene_pt.front(), false, resfileoutfile, allrifrotsoutfile, unsat_scores);
+    if ( writer ) {
+        std::ostringstream silent_buffer;
+        dump_rif_result_(rdd, selected_result, pdboutfile, director_resl_, rif_resl_, silent_buffer, s_ptr, false, resfileoutfile, allrifrotsoutfile,
+                                                                                                                                            unsat_scores, writer);
+        if ( silent_fname.size() && silent_buffer.tellp() > 0 ) writer->append( silent_fname, silent_buffer.str() );
+    } else {
+        dump_rif_result_(rdd, selected_result, pdboutfile, director_resl_, rif_resl_, out_silent_stream, s_ptr, false, resfileoutfile, allrifrotsoutfile, unsat_scores);
+    }
 
     std::cout << extra_output.str() << std::flush;
 }
@@ -267,7 +297,8 @@ dump_rif_result_(
     bool quiet /* = true */,
     std::string const & resfileoutfile /* = "" */,
     std::string const & allrifrotsoutfile, /* = "" */
-    std::vector<float> const & unsat_scores /* = std::vector<float>() */
+    std::vector<float> const & unsat_scores, /* = std::vector<float>() */
+    AsyncFileWriter * writer /* = nullptr */
     ) {
 
     using ObjexxFCL::format::F;
@@ -288,10 +319,10 @@ dump_rif_result_(
 
     core::pose::Pose pose_from_rif;
 
-    if ( rdd.opt.output_full_scaffold ) {        sdc->setup_both_full_pose( rdd.target ); pose_from_rif = *(sdc->mpc_both_full_pose.get_pose());
-    } else if( rdd.opt.output_scaffold_only ) {           sdc->setup_scaffold_centered(); pose_from_rif = *(sdc->mpc_scaffold_centered.get_pose());
-    } else if( rdd.opt.output_full_scaffold_only ) { sdc->setup_scaffold_full_centered(); pose_from_rif = *(sdc->mpc_scaffold_full_centered.get_pose());
-    } else {                                          sdc->setup_both_pose( rdd.target ); pose_from_rif = *(sdc->mpc_both_pose.get_pose());
+    if ( rdd.opt.output_full_scaffold ) {        sdc->setup_both_full_pose( rdd.target ); sdc->mpc_both_full_pose.clone_into( pose_from_rif );
+    } else if( rdd.opt.output_scaffold_only ) {           sdc->setup_scaffold_centered(); sdc->mpc_scaffold_centered.clone_into( pose_from_rif );
+    } else if( rdd.opt.output_full_scaffold_only ) { sdc->setup_scaffold_full_centered(); sdc->mpc_scaffold_full_centered.clone_into( pose_from_rif );
+    } else {                                          sdc->setup_both_pose( rdd.target ); sdc->mpc_both_pose.clone_into( pose_from_rif );
     }
 
 
@@ -450,7 +481,7 @@ dump_rif_result_(
     expdb << "rif_residues ";
 
     if ( selected_result.rotamers_ ) {
-        sanity_check_hackpack( rdd, selected_result.index, selected_result.rotamers_, rdd.scene_pt.front(), director_resl, rif_resl);
+        sanity_check_hackpack( rdd, selected_result.index, selected_result.rotamers_, s_ptr, director_resl, rif_resl);
     }
 
     std::vector<int> needs_RIFRES;
@@ -538,38 +569,45 @@ dump_rif_result_(
 
     rdd.scaffold_provider->modify_pose_for_output(si, pose_to_dump);
 
+    // Files are built in memory, then either handed to the async writer or written here
+    auto write_whole_file = [writer]( std::string const & fname, std::string && content ) {
+        if ( writer ) {
+            writer->write_file( fname, std::move( content ) );
+        } else {
+            utility::io::ozstream out( fname );
+            out << content;
+            out.close();
+        }
+    };
+
     if ( rdd.opt.dump_simple_atoms ) {
-        utility::io::ozstream out1( pdboutfile + "_simple.pdb" );
+        std::ostringstream out1;
         for( int ia = 0; ia < s_ptr->template num_actors<SimpleAtom>(1); ++ia ){
             SimpleAtom const & a( s_ptr->template get_actor<SimpleAtom>(1,ia) );
             write_pdb( out1, a, rdd.rot_index_p->chem_index_ );
         }
-        out1.close();
+        write_whole_file( pdboutfile + "_simple.pdb", out1.str() );
     }
 
     // Dump the main output
     if ( !rdd.opt.outputsilent && !rdd.opt.outputlite ) {
-        utility::io::ozstream out1( pdboutfile );
+        std::ostringstream out1;
         out1 << expdb.str() << std::endl;
         pose_to_dump.dump_pdb(out1);
         if ( rdd.opt.dump_all_rif_rots_into_output ) {
             if ( rdd.opt.rif_rots_as_chains ) out1 << "TER" << endl;
             out1 << allout.str();
         }
-        out1.close();
+        write_whole_file( pdboutfile, out1.str() );
     }
     // Dump a resfile
     if( rdd.opt.dump_resfile ){
-        utility::io::ozstream out1res( resfileoutfile );
-        out1res << resfile.str();
-        out1res.close();
+        write_whole_file( resfileoutfile, resfile.str() );
     }
 
     // Dump the rif rots
     if( rdd.opt.dump_all_rif_rots ){
-        utility::io::ozstream out2( allrifrotsoutfile );
-        out2 << allout.str();
-        out2.close();
+        write_whole_file( allrifrotsoutfile, allout.str() );
     }
 
     // Dump silent file
@@ -21,6 +21,8 @@
 namespace devel {
 namespace scheme {
 
+class AsyncFileWriter;
+
 struct OutputResultsTask : public RifDockResultTask {
 
     OutputResultsTask( 
@@ -50,7 +52,9 @@ private:
         std::ostream & out_silent_stream,
         RifDockData & rdd, 
         ProtocolData & pd,
-        int i_selected_result );
+        int i_selected_result,
+        AsyncFileWriter * writer,
+        std::string const & silent_fname );
 
 };
 
@@ -66,7 +70,8 @@ dump_rif_result_(
     bool quiet = true,
     std::string const & resfileoutfile = "",
     std::string const & allrifrotsoutfile = "",
-    std::vector<float> const & unsat_scores = std::vector<float>()
+    std::vector<float> const & unsat_scores = std::vector<float>(),
+    AsyncFileWriter * writer = nullptr
     );
 
 // You would think that it would be easier to get the absolute path but it's not
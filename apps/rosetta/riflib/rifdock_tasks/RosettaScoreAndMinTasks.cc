@@ -28,7 +28,10 @@
 
 #include <protocols/minimization_packing/MinMover.hh>
 
+#include <scheme/util/WorkStealingQueues.hh>
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -281,21 +284,47 @@ rosetta_score_inner(
 
 
 
+    // Execution order. Minimization time varies ~10x between results, so do the expensive
+    // ones first and let threads steal from each other at the end. With early stopping the
+    // results are done in rif score order instead, so the ones that get done are the best.
+    int const early_stop_n = is_minimizing ? rdd.opt.rosetta_min_stop_after_n_passing : 0;
+    std::vector<int64_t> order( n_scormin );
+    for ( int64_t i = 0; i < n_scormin; ++i ) order[i] = i;
+    if ( rdd.opt.rosetta_work_stealing && early_stop_n <= 0 ) {
+        std::unordered_map<ScaffoldIndex,int> scaffold_size_dict;
+        for ( ScaffoldIndex si : uniq_scaffolds ) {
+            scaffold_size_dict[si] = rdd.scaffold_provider->get_data_cache_slow(si)->scaffuseres_p->size();
+        }
+        // crude: pose size times the number of placed rotamers the minimizer has to settle
+        std::vector<double> cost( n_scormin );
+        for ( int64_t i = 0; i < n_scormin; ++i ) {
+            double nres = scaffold_size_dict[ packed_results[i].index.scaffold_index ] + rdd.target.size();
+            cost[i] = is_minimizing ? nres * ( 1 + packed_results[i].numrots() ) : nres;
+        }
+        std::stable_sort( order.begin(), order.end(), [&cost]( int64_t a, int64_t b ){ return cost[a] > cost[b]; } );
+    }
+    // one shared queue if not stealing, same as dynamic scheduling
+    ::scheme::util::WorkStealingQueues queues( order, rdd.opt.rosetta_work_stealing ? omp_max_threads() : 1 );
+    std::vector<char> was_run( n_scormin, 0 );
+    std::atomic<int64_t> n_passing( 0 );
+
     int64_t const out_interval = std::max<int64_t>(1,n_scormin/50);
     if( is_minimizing) std::cout << "rosetta min on "   << KMGT(n_scormin) << ": ";
     else            std::cout << "rosetta score on " << KMGT(n_scormin) << ": ";
     std::exception_ptr exception = nullptr;
 
+    // each thread drains its own queue, then steals from the others
     #ifdef USE_OPENMP
-    #pragma omp parallel for schedule(dynamic,1)
+    #pragma omp parallel
     #endif
-    for( int imin = 0; imin < n_scormin; ++imin )
+    for( int64_t imin; queues.pop( omp_get_thread_num(), imin ); )
 
     {
 
 
         try
         {
+            was_run[imin] = 1;
             if( imin%out_interval==0 ){ cout << '*'; cout.flush();  }
 
             int const ithread = omp_get_thread_num();
@@ -322,9 +351,9 @@ rosetta_score_inner(
             core::pose::Pose & pose_to_min( work_pose_pt[ithread] );
 
             if( rdd.opt.replace_orig_scaffold_res ){
-                pose_to_min = *(sdc->mpc_both_full_pose.get_pose());
+                sdc->mpc_both_full_pose.clone_into( pose_to_min );
             } else {
-                pose_to_min = *(sdc->mpc_both_pose.get_pose());
+                sdc->mpc_both_pose.clone_into( pose_to_min );
             }
 
             // these guys are multi-thread shared. Definitely don't modify them
@@ -526,6 +555,10 @@ rosetta_score_inner(
                 // std::cout << rosetta_score << std::endl;
             }
 
+            if( early_stop_n > 0 && packed_results[imin].score < rdd.opt.rosetta_score_cut ){
+                if( ++n_passing >= early_stop_n ) queues.stop();
+            }
+
 
             if( store_pose     && packed_results[imin].score < rdd.opt.rosetta_score_cut ){
                 packed_results[imin].pose_ = core::pose::PoseOP( new core::pose::Pose(pose_to_min) );
@@ -546,12 +579,25 @@ rosetta_score_inner(
         } catch(...) {
             #pragma omp critical
             exception = std::current_exception();
+            queues.stop();
         }
 
     } // end of OMP loop
     if( exception ) std::rethrow_exception(exception);
 
     cout << endl;
+    if ( queues.nstolen() ) std::cout << "work stealing: " << queues.nstolen() << " results stolen between threads" << std::endl;
+    if ( queues.stopped() ) {
+        // early stop, drop what never ran
+        size_t n_keep = 0;
+        for ( size_t i = 0; i < packed_results.size(); ++i ) {
+            if ( was_run[i] ) std::swap( packed_results[n_keep++], packed_results[i] );
+        }
+        std::cout << "early stop: " << n_passing << " results passed rosetta_score_cut after "
+                  << n_keep << " of " << n_scormin << std::endl;
+        packed_results.resize( n_keep );
+        n_scormin = n_keep;
+    }
     __gnu_parallel::sort( packed_results.begin(), packed_results.end() );
     {
         size_t n_scormin = 0;
@@ -578,6 +624,11 @@ rosetta_score_inner(
     std::chrono::duration<double> elapsed_seconds_rosetta = std::chrono::high_resolution_clock::now()-start_rosetta;
     pd.time_ros += elapsed_seconds_rosetta.count();
 
+    if ( pd.perf_report ) {
+        if( is_minimizing ) pd.perf_report->add_count( "RosettaMinTask", -1, "rosetta_mins", n_scormin );
+        else                pd.perf_report->add_count( "RosettaScoreTask", -1, "rosetta_scores", n_scormin );
+    }
+
 
 }
 
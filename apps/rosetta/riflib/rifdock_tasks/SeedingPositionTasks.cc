@@ -27,6 +27,7 @@
 #include <riflib/rifdock_tasks/OutputResultsTasks.hh>
 #include <riflib/rifdock_tasks/UtilTasks.hh>
 #include <riflib/rifdock_tasks/SasaTasks.hh>
+#include <riflib/rifdock_tasks/ShardTasks.hh>
 
 #include <string>
 #include <vector>
@@ -109,6 +110,9 @@ create_rifine_task(
     } else {
         task_list.push_back(make_shared<DiversifyByNestTask>( 0 ));
     }
+    if ( opt.num_shards > 1 ) {
+        task_list.push_back(make_shared<ShardSearchSpaceTask>( opt.shard_index, opt.num_shards ));
+    }
     
     task_list.push_back(make_shared<HSearchInit>( ));
     task_list.push_back(make_shared<HSearchScoreAtReslTask>( 0, final_resl, rdd.opt.tether_to_input_position_cut ));
@@ -0,0 +1,155 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+
+#include <riflib/rifdock_tasks/ShardTasks.hh>
+
+#include <riflib/types.hh>
+#include <riflib/task/PointIO.hh>
+
+#include <scheme/util/FlatIndexSet.hh>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+
+
+
+namespace devel {
+namespace scheme {
+
+
+shared_ptr<std::vector<SearchPoint>>
+ShardSearchSpaceTask::return_search_points(
+    shared_ptr<std::vector<SearchPoint>> search_points,
+    RifDockData & rdd,
+    ProtocolData & pd ) {
+    return return_any_points( search_points, rdd, pd );
+}
+shared_ptr<std::vector<SearchPointWithRots>>
+ShardSearchSpaceTask::return_search_point_with_rotss(
+    shared_ptr<std::vector<SearchPointWithRots>> search_point_with_rotss,
+    RifDockData & rdd,
+    ProtocolData & pd ) {
+    return return_any_points( search_point_with_rotss, rdd, pd );
+}
+shared_ptr<std::vector<RifDockResult>>
+ShardSearchSpaceTask::return_rif_dock_results(
+    shared_ptr<std::vector<RifDockResult>> rif_dock_results,
+    RifDockData & rdd,
+    ProtocolData & pd ) {
+    return return_any_points( rif_dock_results, rdd, pd );
+}
+
+int
+ShardSearchSpaceTask::shard_of( RifDockIndex const & index, int num_shards ) {
+    using ::scheme::util::hash_combine64;
+    uint64_t h = hash_combine64( hash_combine64( 0, index.nest_index ), index.seeding_index );
+    return h % num_shards;
+}
+
+template<class AnyPoint>
+shared_ptr<std::vector<AnyPoint>>
+ShardSearchSpaceTask::return_any_points(
+    shared_ptr<std::vector<AnyPoint>> any_points,
+    RifDockData & rdd,
+    ProtocolData & pd ) {
+
+    runtime_assert( 0 <= shard_index_ && shard_index_ < num_shards_ );
+
+    shared_ptr<std::vector<AnyPoint>> out = make_shared<std::vector<AnyPoint>>();
+    out->reserve( any_points->size() / num_shards_ + 1 );
+
+    for ( AnyPoint const & pt : *any_points ) {
+        if ( shard_of( pt.index, num_shards_ ) != shard_index_ ) continue;
+        out->push_back( pt );
+    }
+
+    std::cout << "Shard " << shard_index_ << " of " << num_shards_ << " keeps " << out->size()
+              << " of " << any_points->size() << " starting positions" << std::endl;
+
+    any_points->resize(0);
+    return out;
+}
+
+
+static uint64_t const SHARD_MAGIC = 0x32445253464952llu; // "RIFSRD2"
+
+
+bool
+write_shard_results(
+    std::string const & fname,
+    std::string const & scaffold_key,
+    int shard_index,
+    int num_shards,
+    int64_t total_search_effort,
+    std::vector<SearchPoint> const & results ) {
+
+    using namespace point_io;
+
+    std::string const tmp_fname = fname + ".tmp";
+    {
+        std::ofstream out( tmp_fname, std::ios::binary | std::ios::trunc );
+        if ( ! out ) return false;
+        write_pod( out, SHARD_MAGIC );
+        write_pod_vector( out, std::vector<char>( scaffold_key.begin(), scaffold_key.end() ) );
+        write_pod( out, (int32_t)shard_index );
+        write_pod( out, (int32_t)num_shards );
+        write_pod( out, total_search_effort );
+        write_points( out, results );
+        out.flush();
+        if ( ! out ) return false;
+    }
+    return 0 == std::rename( tmp_fname.c_str(), fname.c_str() );
+}
+
+bool
+read_shard_results(
+    std::string const & fname,
+    std::string & scaffold_key,
+    int & shard_index,
+    int & num_shards,
+    int64_t & total_search_effort,
+    std::vector<SearchPoint> & results ) {
+
+    using namespace point_io;
+
+    std::ifstream in( fname, std::ios::binary );
+    if ( ! in ) return false;
+
+    uint64_t magic;
+    std::vector<char> key;
+    int32_t file_shard_index, file_num_shards;
+    int64_t effort;
+    std::vector<SearchPoint> loaded;
+    if ( ! ( read_pod( in, magic ) && magic == SHARD_MAGIC && read_pod_vector( in, key )
+          && read_pod( in, file_shard_index ) && read_pod( in, file_num_shards ) && read_pod( in, effort )
+          && read_points( in, loaded ) ) ) {
+        return false;
+    }
+
+    scaffold_key = std::string( key.begin(), key.end() );
+    shard_index = file_shard_index;
+    num_shards = file_num_shards;
+    total_search_effort += effort;
+    results.insert( results.end(), loaded.begin(), loaded.end() );
+    return true;
+}
+
+std::string
+shard_results_fname( std::string const & outdir, std::string const & scaffold_key, int shard_index, int num_shards ) {
+    return outdir + "/" + scaffold_key + boost::str( boost::format( "_shard%iof%i.rdr" ) % shard_index % num_shards );
+}
+
+
+
+}}
@@ -0,0 +1,103 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+#ifndef INCLUDED_riflib_rifdock_tasks_ShardTasks_hh
+#define INCLUDED_riflib_rifdock_tasks_ShardTasks_hh
+
+#include <riflib/types.hh>
+#include <riflib/task/AnyPointTask.hh>
+
+#include <string>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+// Keeps this process's slice of the coarsest search space. Placed right after the
+//  nest and seeding positions are expanded, every (nest_index, seeding_index) pair
+//  lands in exactly one of num_shards slices. Slices are hashed rather than
+//  contiguous so neighboring (similarly good) positions are spread over the shards.
+struct ShardSearchSpaceTask : public AnyPointTask {
+
+    ShardSearchSpaceTask(
+        int shard_index,
+        int num_shards
+        ) :
+        shard_index_( shard_index ),
+        num_shards_( num_shards )
+        {}
+
+    shared_ptr<std::vector<SearchPoint>>
+    return_search_points(
+        shared_ptr<std::vector<SearchPoint>> search_points,
+        RifDockData & rdd,
+        ProtocolData & pd ) override;
+
+    shared_ptr<std::vector<SearchPointWithRots>>
+    return_search_point_with_rotss(
+        shared_ptr<std::vector<SearchPointWithRots>> search_point_with_rotss,
+        RifDockData & rdd,
+        ProtocolData & pd ) override;
+
+    shared_ptr<std::vector<RifDockResult>>
+    return_rif_dock_results(
+        shared_ptr<std::vector<RifDockResult>> rif_dock_results,
+        RifDockData & rdd,
+        ProtocolData & pd ) override;
+
+    static int
+    shard_of( RifDockIndex const & index, int num_shards );
+
+private:
+    template<class AnyPoint>
+    shared_ptr<std::vector<AnyPoint>>
+    return_any_points(
+        shared_ptr<std::vector<AnyPoint>> any_points,
+        RifDockData & rdd,
+        ProtocolData & pd ); // override
+
+private:
+    int shard_index_;
+    int num_shards_;
+
+};
+
+
+// A shard's hsearch results for one scaffold, read back by -rif_dock:merge_shards. Shards
+//  stop there, everything after the hsearch (hack pack, rosetta score/min, filtering and
+//  output) runs once over the merged results. scaffold_key ties the file to the scaffold it
+//  came from, total_search_effort is what the hack pack and rosetta fractions are taken of.
+bool
+write_shard_results(
+    std::string const & fname,
+    std::string const & scaffold_key,
+    int shard_index,
+    int num_shards,
+    int64_t total_search_effort,
+    std::vector<SearchPoint> const & results );
+
+// appends to results and adds to total_search_effort. shard_index and num_shards are the ones
+//  the file was written with. false if fname isn't a shard result file
+bool
+read_shard_results(
+    std::string const & fname,
+    std::string & scaffold_key,
+    int & shard_index,
+    int & num_shards,
+    int64_t & total_search_effort,
+    std::vector<SearchPoint> & results );
+
+std::string
+shard_results_fname( std::string const & outdir, std::string const & scaffold_key, int shard_index, int num_shards );
+
+}}
+
+#endif
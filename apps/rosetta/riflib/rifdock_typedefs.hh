@@ -26,6 +26,7 @@
 #include <scheme/kinematics/Director.hh>
 #include <scheme/objective/integration/SceneObjective.hh>
 #include <scheme/chemical/RotamerIndex.hh>
+#include <scheme/util/FlatIndexSet.hh>
 
 
 #include <boost/mpl/vector.hpp>
@@ -186,24 +187,22 @@ struct SelectiveRifDockIndexHasher {
         treat_scaffolds_differently_(treat_scaffolds_differently)
         {}
 
+    // nest_index is 64 bits, all of them have to reach the hash or fine resolutions collide
     size_t operator() (devel::scheme::RifDockIndex const & rdi) const {
 
-        using boost::hash;
-        using boost::hash_combine;
+        using ::scheme::util::hash_combine64;
 
-        std::size_t the_hash = 0;
+        uint64_t the_hash = 0;
 
         if ( treat_nests_differently_ ) {
-            boost::hash<int> hasher;
-            hash_combine(the_hash, hasher(rdi.nest_index));
+            the_hash = hash_combine64(the_hash, rdi.nest_index);
         }
         if ( treat_seeds_differently_ ) {
-            boost::hash<int> seeding_index_hasher;
-            hash_combine(the_hash, seeding_index_hasher(rdi.seeding_index));
+            the_hash = hash_combine64(the_hash, rdi.seeding_index);
         }
         if ( treat_scaffolds_differently_ ) {      
             std::hash<devel::scheme::ScaffoldIndex> scaffold_index_hasher;
-            hash_combine(the_hash, scaffold_index_hasher(rdi.scaffold_index));
+            the_hash = hash_combine64(the_hash, scaffold_index_hasher(rdi.scaffold_index));
         }
 
         return the_hash;
@@ -249,6 +248,9 @@ private:
 template< class __AnyPoint >
 using _AnyPointVectorsMap = std::unordered_map< RifDockIndex, std::vector<__AnyPoint>, SelectiveRifDockIndexHasher, SelectiveRifDockIndexEquater >;
 
+// dedup of RifDockIndex, each distinct index gets a dense id in insertion order
+typedef ::scheme::util::FlatIndexSet< RifDockIndex, SelectiveRifDockIndexHasher, SelectiveRifDockIndexEquater > RifDockIndexSet;
+
 
 
 typedef ::scheme::actor::Atom<
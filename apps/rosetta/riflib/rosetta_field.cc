@@ -33,6 +33,7 @@
 
 	#include <Eigen/Dense>
 
+	#include <algorithm>
 	#include <exception>
 	#include <stdexcept>
 
@@ -45,6 +46,65 @@ using std::cout;
 
 int N_ATYPE = 21;
 
+namespace {
+
+// bump if the bulk field cache layout changes, old .bin files are then ignored and remade
+uint64_t const FIELD_BULK_CACHE_TAG = 1;
+
+std::string
+bulk_cache_fname( std::string const & gz_fname ){
+	std::string base = gz_fname;
+	if( base.size() > 3 && base.substr(base.size()-3) == ".gz" ) base = base.substr( 0, base.size()-3 );
+	return base + ".bin";
+}
+
+bool
+field_cache_exists( std::string const & gz_fname, RosettaFieldOptions const & opts ){
+	if( opts.bulk_cache ) return utility::file::file_exists( bulk_cache_fname( gz_fname ) );
+	return utility::file::file_exists( gz_fname );
+}
+
+void
+save_bulk_field_cache( ::scheme::objective::voxel::VoxelArray<3,float,float> const & grid, std::string const & gz_fname ){
+	// written via temp file + rename, racing processes on a shared cache dir are harmless
+	if( !grid.save_bulk( bulk_cache_fname( gz_fname ), FIELD_BULK_CACHE_TAG ) ){
+		#ifdef USE_OPENMP
+		#pragma omp critical
+		#endif
+		std::cout << "WARNING: can't write bulk field cache " << bulk_cache_fname( gz_fname ) << std::endl;
+	}
+}
+
+// prefer the mapped .bin, fall back to the .gz (and make the .bin from it). false if neither loads
+bool
+load_field_cache(
+	::scheme::objective::voxel::VoxelArray<3,float,float> & grid,
+	std::string const & gz_fname,
+	RosettaFieldOptions const & opts
+){
+	if( opts.bulk_cache && grid.load_bulk( bulk_cache_fname( gz_fname ), FIELD_BULK_CACHE_TAG ) ) return true;
+	if( !utility::file::file_exists( gz_fname ) ) return false;
+	utility::io::izstream in( gz_fname, std::ios::binary );
+	grid.load( in );
+	in.close();
+	if( opts.bulk_cache ) save_bulk_field_cache( grid, gz_fname );
+	return true;
+}
+
+void
+save_field_cache(
+	::scheme::objective::voxel::VoxelArray<3,float,float> const & grid,
+	std::string const & gz_fname,
+	RosettaFieldOptions const & opts
+){
+	utility::io::ozstream out( gz_fname, std::ios::binary );
+	grid.save( out );
+	out.close();
+	if( opts.bulk_cache ) save_bulk_field_cache( grid, gz_fname );
+}
+
+}
+
 
 
 
@@ -329,19 +389,24 @@ get_rosetta_fields_specified_cache_prefix(
 
 				::scheme::rosetta::score::RosettaFieldAtype< SchemeAtom, devel::scheme::EtableParamsInit > rfa( rosetta_field, itype );
 
-				if( utility::file::file_exists(cachefile) ){
-					if( opts.generate_only ) continue;
+				if( opts.generate_only && field_cache_exists( cachefile, opts ) ) continue;
+				FieldCache * cached = nullptr;
+				if( utility::file::file_exists(cachefile) || field_cache_exists( cachefile, opts ) ){
+					// field_by_atype[itype] = boost::make_shared< FieldCache >( rfa, lb-6.0f, ub+6.0f, field_resl, "", true, oversample ); // no init
+					cached = new FieldCache( rfa, lb-6.0f, ub+6.0f, field_resl, "", true, oversample ); // no init
+					if( !load_field_cache( *cached, cachefile, opts ) ){
+						delete cached;
+						cached = nullptr;
+					}
+				}
+				if( cached ){
 					if( verbose ){
 						#ifdef USE_OPENMP
 						#pragma omp critical
 						#endif
 						std::cout<< "thread " << I(3,omp_thread_num_1()) << " init  rosetta_field " << I(2,itype) << " CACHE AT " << cachefile << std::endl;
 					}
-					// field_by_atype[itype] = boost::make_shared< FieldCache >( rfa, lb-6.0f, ub+6.0f, field_resl, "", true, oversample ); // no init
-					field_by_atype[itype] = new FieldCache( rfa, lb-6.0f, ub+6.0f, field_resl, "", true, oversample ); // no init
-					utility::io::izstream in( cachefile, std::ios::binary );
-					field_by_atype[itype]->load(in);
-					in.close();
+					field_by_atype[itype] = cached;
 				} else {
 					if( opts.fail_if_no_cached_data ){
 						#ifdef USE_OPENMP
@@ -359,9 +424,7 @@ get_rosetta_fields_specified_cache_prefix(
 					std::cout << "thread " << I(3,omp_thread_num_1()) << " init  rosetta_field " << I(2,itype) << " CACHE TO " << cachefile << std::endl;
 					// field_by_atype[itype] = boost::make_shared<FieldCache >( rfa, lb-6.0f, ub+6.0f, field_resl, "", false, oversample );
 					field_by_atype[itype] = new FieldCache( rfa, lb-6.0f, ub+6.0f, field_resl, "", false, oversample );
-					utility::io::ozstream out( cachefile , std::ios::binary );
-					field_by_atype[itype]->save( out );
-					out.close();
+					save_field_cache( *field_by_atype[itype], cachefile, opts );
 				}
 				// if( opts.cache_mismatch_tolerance < 9e8 ){
 				// 	double erf = static_cast<FieldCache&>(*field_by_atype[itype]).check_against_field( rfa, oversample, opts.cache_mismatch_tolerance );
@@ -465,6 +528,12 @@ get_rosetta_bounding_fields_from_fba(
 	}
 	bounding_by_atype.resize( RESLS.size() );
 	for(int i = 0; i < RESLS.size(); ++i) bounding_by_atype[i].resize(25,nullptr);
+	// three passes: caches are loaded and written in parallel over jobs, but missing grids are
+	// built one at a time so the voxel loop in BoundingFieldCache3D gets all the threads. nested
+	// parallelism is off, so building inside the job loop would fill each grid on one thread
+	std::vector<std::string> cachefiles( jobs.size() );
+	std::vector<float> bresls( jobs.size() );
+	std::vector<int> to_build;
 	std::exception_ptr exception = nullptr;
 	#ifdef USE_OPENMP
 	#pragma omp parallel for schedule(dynamic,1)
@@ -481,40 +550,65 @@ get_rosetta_bounding_fields_from_fba(
 				+"_bounding"+boost::lexical_cast<std::string>(bound)+"_"+boost::lexical_cast<std::string>(bresl)
 				+"_atype" + boost::lexical_cast<std::string>(itype)
 				 +".rf.gz";
-			VoxelArray * gp;
-			if( utility::file::file_exists(cachefile) ){
-				if( opts.generate_only ) continue;
+			cachefiles[ijob] = cachefile;
+			bresls[ijob] = bresl;
+			if( opts.generate_only && field_cache_exists( cachefile, opts ) ) continue;
+			BoundingGrid * cached = nullptr;
+			if( utility::file::file_exists(cachefile) || field_cache_exists( cachefile, opts ) ){
+					// gp = boost::make_shared<BoundingGrid>( *field_by_atype[itype], bound, bresl, "", true );
+				cached = new BoundingGrid( *field_by_atype[itype], bound, bresl, "", true );
+				if( !load_field_cache( *cached, cachefile, opts ) ){
+					delete cached;
+					cached = nullptr;
+				}
+			}
+			if( cached ){
 				if(verbose||itype==1){
 					#ifdef USE_OPENMP
 					#pragma omp critical
 					#endif
 					std::cout << "thread " << I(3,omp_thread_num_1()) << " init bounding field " << I(2,iresl) << " " << I(2,itype) << " CACHE AT " << cachefile << std::endl;
 				}
-					// gp = boost::make_shared<BoundingGrid>( *field_by_atype[itype], bound, bresl, "", true );
-				gp = new BoundingGrid( *field_by_atype[itype], bound, bresl, "", true );
-				utility::io::izstream in( cachefile, std::ios::binary );
-				gp->load(in);
-				in.close();
+				bounding_by_atype.at(iresl).at(itype) = cached;
 			} else {
 				#ifdef USE_OPENMP
 				#pragma omp critical
 				#endif
-				std::cout << "thread " << I(3,omp_thread_num_1()) << " init bounding field " << I(2,itype) << " CACHE TO " << cachefile << std::endl;
-					// gp = boost::make_shared< BoundingGrid >( *field_by_atype[itype], bound, bresl, "", false );
-				if( bound/bresl < 1.1 ){
-					#ifdef USE_OPENMP
-					#pragma omp critical
-					#endif
-					std::cout << "WARNING: bound/resl: " << bound << "/" << bresl << " too small, using unmodified source grid" << std::endl;
-					gp = field_by_atype[itype];
-				} else {
-					gp = new BoundingGrid( *field_by_atype[itype], bound, bresl, "", false );
-				}
-				utility::io::ozstream out( cachefile , std::ios::binary );
-				gp->save( out );
-				out.close();
+				to_build.push_back( ijob );
 			}
-			bounding_by_atype.at(iresl).at(itype) = gp;
+		} catch( ... ) {
+			#ifdef USE_OPENMP
+			#pragma omp critical
+			#endif
+			exception = std::current_exception();
+		}
+	}
+	if( exception ) std::rethrow_exception(exception);
+
+	std::sort( to_build.begin(), to_build.end() );
+	for( int ijob : to_build ){
+		int const iresl = jobs[ijob].first;
+		int const itype = jobs[ijob].second;
+		float const bound = RESLS[iresl];
+		float const bresl = bresls[ijob];
+		std::cout << "init bounding field " << I(2,iresl) << " " << I(2,itype) << " CACHE TO " << cachefiles[ijob] << std::endl;
+			// gp = boost::make_shared< BoundingGrid >( *field_by_atype[itype], bound, bresl, "", false );
+		if( bound/bresl < 1.1 ){
+			std::cout << "WARNING: bound/resl: " << bound << "/" << bresl << " too small, using unmodified source grid" << std::endl;
+			bounding_by_atype.at(iresl).at(itype) = field_by_atype[itype];
+		} else {
+			bounding_by_atype.at(iresl).at(itype) = new BoundingGrid( *field_by_atype[itype], bound, bresl, "", false );
+		}
+	}
+
+	#ifdef USE_OPENMP
+	#pragma omp parallel for schedule(dynamic,1)
+	#endif
+	for( int i = 0; i < to_build.size(); ++i ){
+		if(exception) continue;
+		try {
+			int const ijob = to_build[i];
+			save_field_cache( *bounding_by_atype.at(jobs[ijob].first).at(jobs[ijob].second), cachefiles[ijob], opts );
 		} catch( ... ) {
 			#ifdef USE_OPENMP
 			#pragma omp critical
@@ -71,8 +71,14 @@ void get_onebody_rotamer_energies(
 	bool replace_with_ala,
 	float favorable_1be_multiplier,
 	float favorable_1be_cutoff,
-	std::shared_ptr< std::vector< std::vector<float> > > extra_scores_p
+	std::shared_ptr< std::vector< std::vector<float> > > extra_scores_p,
+	std::vector<std::vector<float> > * raw_energies,
+	std::vector<int> const * same_as,
+	std::vector<std::vector<float> > const * reuse_energies,
+	std::vector<std::vector<int> > * raw_neighbors,
+	std::vector<std::vector<int> > const * reuse_neighbors
 ){
+	if( raw_neighbors ) raw_neighbors->clear(); // stays empty if the energies come from the cache
 	utility::io::izstream in;
 	std::string cachefile_found = devel::scheme::open_for_read_on_path( cachepath, cachefile, in );
 	if( cachefile.size() && cachefile_found.size() ){
@@ -102,7 +108,11 @@ void get_onebody_rotamer_energies(
 			scaffold_onebody_rotamer_energies,
 					// this doesn't seem to work the way I expected...
 					// false // do not mutate all to ALA!
-			replace_with_ala
+			replace_with_ala,
+			same_as,
+			reuse_energies,
+			raw_neighbors,
+			reuse_neighbors
 		);
 
 
@@ -124,6 +134,8 @@ void get_onebody_rotamer_energies(
 		}
 	}
 
+	if( raw_energies ) *raw_energies = scaffold_onebody_rotamer_energies;
+
 	utility::vector1<int> g2l( scaffold_onebody_rotamer_energies.size(), -1 );
 	if ( extra_scores_p ) {
 		runtime_assert( extra_scores_p->size() == scaffold_res.size() );
@@ -166,7 +178,11 @@ compute_onebody_rotamer_energies(
 	utility::vector1<core::Size> const & scaffold_res,
 	RotamerIndex const & rot_index,
 	std::vector<std::vector< float > > & onebody_rotamer_energies,
-	bool replace_with_ala
+	bool replace_with_ala,
+	std::vector<int> const * same_as,
+	std::vector<std::vector<float> > const * reuse_energies,
+	std::vector<std::vector<int> > * neighbors_out,
+	std::vector<std::vector<int> > const * reuse_neighbors
 ){
 	using devel::scheme::str;
 	using devel::scheme::omp_max_threads_1;
@@ -247,6 +263,65 @@ compute_onebody_rotamer_energies(
 	}
 
 
+	// everything each residue gets scored against below, packer and long range, glob0 and sorted
+	std::vector<std::vector<int> > neighbors( bbone.size() );
+	{
+		core::scoring::ScoreFunctionOP score_func = score_func_per_thread.front();
+		for( int ir = 1; ir <= bbone.size(); ++ir ){
+			std::vector<int> & nbrs = neighbors[ir-1];
+			for ( utility::graph::Graph::EdgeListConstIter
+					iter = neighbor_graph.get_node( ir )->const_edge_list_begin(),
+					iter_end = neighbor_graph.get_node( ir )->const_edge_list_end();
+					iter != iter_end; ++iter ) {
+				nbrs.push_back( (*iter)->get_other_ind( ir ) - 1 );
+			}
+			for ( auto
+				lr_iter = score_func->long_range_energies_begin(),
+				lr_end = score_func->long_range_energies_end();
+				lr_iter != lr_end; ++lr_iter ) {
+
+				core::scoring::LREnergyContainerCOP lrec = pose_per_thread.front().energies().long_range_container( (*lr_iter)->long_range_type() );
+				if ( !lrec || lrec->empty() ) continue;
+
+				for ( core::scoring::ResidueNeighborConstIteratorOP
+					rni = lrec->const_neighbor_iterator_begin(ir),
+					rniend = lrec->const_neighbor_iterator_end(ir);
+					(*rni) != (*rniend); ++(*rni) ) {
+					nbrs.push_back( rni->neighbor_id() - 1 );
+				}
+			}
+			std::sort( nbrs.begin(), nbrs.end() );
+			nbrs.erase( std::unique( nbrs.begin(), nbrs.end() ), nbrs.end() );
+		}
+	}
+	if( neighbors_out ) *neighbors_out = neighbors;
+
+	// a row can be copied if the residue and everything it gets scored against are unchanged. That has to
+	//  hold both ways: every neighbor here has to be identical to one of the parent's, and the parent residue
+	//  can't see anything else, e.g. a loop residue that was deleted or moved away in this pose
+	std::vector<bool> reuse_row( bbone.size()+1, false );
+	int nreused = 0;
+	if( same_as && reuse_energies && reuse_neighbors ){
+		runtime_assert( same_as->size() == bbone.size() );
+		runtime_assert( reuse_neighbors->size() == reuse_energies->size() );
+		std::vector<int> mapped;
+		for( int ir = 1; ir <= bbone.size(); ++ir ){
+			int const other = (*same_as)[ir-1];
+			if( other < 0 || (*reuse_energies).at(other).size() != rot_index.size() ) continue;
+			bool ok = true;
+			mapped.clear();
+			for ( int nbr : neighbors[ir-1] ) {
+				if ( (*same_as)[nbr] < 0 ) { ok = false; break; }
+				mapped.push_back( (*same_as)[nbr] );
+			}
+			if ( ! ok ) continue;
+			std::sort( mapped.begin(), mapped.end() );
+			reuse_row[ir] = mapped == (*reuse_neighbors)[other];
+			nreused += reuse_row[ir];
+		}
+		std::cout << "compute_onebody_rotamer_energies reusing " << nreused << " of " << bbone.size() << " residues" << std::endl;
+	}
+
 	onebody_rotamer_energies.resize( bbone.size() );
 	std::cout << "compute_onebody_rotamer_energies " << bbone.size() << "/" << rot_index.size() << " ";
 	std::exception_ptr exception = nullptr;
@@ -266,6 +341,10 @@ compute_onebody_rotamer_energies(
 			if( ! work_pose.residue(ir).is_protein()   ) continue;
 			if(   work_pose.residue(ir).name3()=="GLY" ) continue;
 			if(   work_pose.residue(ir).name3()=="PRO" ) continue;
+			if( reuse_row[ir] ){
+				onebody_rotamer_energies[ir-1] = (*reuse_energies)[ (*same_as)[ir-1] ];
+				continue;
+			}
 			#ifdef USE_OPENMP
 			#pragma omp critical
 			#endif
@@ -593,7 +672,10 @@ make_twobody_tables(
 	std::vector<std::vector<float> > const & onebody_energies,
 	RotamerRFTablesManager & rotrfmanager,
 	MakeTwobodyOpts opts,
-	::scheme::objective::storage::TwoBodyTable<float> & twob
+	::scheme::objective::storage::TwoBodyTable<float> & twob,
+	::scheme::objective::storage::TwoBodyTable<float> const * reuse_twob,
+	std::vector<int> const * same_as,
+	std::vector<char> * reused_pairs
 ){
 	// typedef ::scheme::objective::voxel::VoxelArray< 3, float, float > VoxelArray;
 	// typedef Eigen::Transform<float,3,Eigen::AffineCompact> EigenXform;
@@ -626,6 +708,28 @@ make_twobody_tables(
 
 	twob.init_onebody_filter( opts.onebody_threshold );
 
+	int const nres = scaffold.size();
+	if( reused_pairs ) reused_pairs->assign( nres*nres, 0 );
+
+	// a pair can only be copied if both residues select the same rotamers as their counterparts
+	std::vector<bool> same_sel( nres, false );
+	int nsame_sel = 0;
+	if( reuse_twob && same_as ){
+		runtime_assert( same_as->size() == nres );
+		runtime_assert( reuse_twob->nrot_ == rot_index.size() );
+		for( int ir = 0; ir < nres; ++ir ){
+			int const pr = (*same_as)[ir];
+			if( pr < 0 || pr >= reuse_twob->nres_ ) continue;
+			bool same = twob.nsel_[ir] == reuse_twob->nsel_[pr];
+			for( int k = 0; same && k < twob.nsel_[ir]; ++k ){
+				same = twob.sel2all_[ir][k] == reuse_twob->sel2all_[pr][k];
+			}
+			same_sel[ir] = same;
+			nsame_sel += same;
+		}
+		std::cout << "make_twobody_tables reusing pairs among " << nsame_sel << " of " << nres << " residues" << std::endl;
+	}
+
 	double const dthresh2 = opts.distance_cut * opts.distance_cut;
 
 	std::exception_ptr exception = nullptr;
@@ -654,6 +758,16 @@ make_twobody_tables(
 					continue;
 				}
 
+				if( same_sel[ir] && same_sel[jr] && (*same_as)[ir] > (*same_as)[jr] ){
+					auto const & reuse = reuse_twob->twobody_[ (*same_as)[ir] ][ (*same_as)[jr] ];
+					if( reuse.num_elements() > 0 ){
+						twob.init_twobody(ir,jr);
+						twob.twobody_[ir][jr] = reuse;
+					}
+					if( reused_pairs ) (*reused_pairs)[ir*nres+jr] = 1;
+					continue;
+				}
+
 				BackboneActor bbj( scaffold.residue(jr+1).xyz("N"), scaffold.residue(jr+1).xyz("CA"), scaffold.residue(jr+1).xyz("C") );
 
 				twob.init_twobody(ir,jr);
@@ -793,8 +907,12 @@ get_twobody_tables(
 	std::vector<std::vector<float> > const & onebody_energies,
 	RotamerRFTablesManager & rotrfmanager,
 	MakeTwobodyOpts opts,
-	::scheme::objective::storage::TwoBodyTable<float> & twob
+	::scheme::objective::storage::TwoBodyTable<float> & twob,
+	::scheme::objective::storage::TwoBodyTable<float> const * reuse_twob,
+	std::vector<int> const * same_as
 ){
+	// pairs copied from reuse_twob already have the favorable multiplier applied
+	std::vector<char> reused_pairs;
 	utility::io::izstream in;
 	std::string cachefile_found;
 	if( cachefile.size() ) cachefile_found = devel::scheme::open_for_read_on_path( cachepath, cachefile, in );
@@ -804,19 +922,27 @@ get_twobody_tables(
 		in.close();
 	} else {
 		twob.init( scaffold.size(), rot_index.size() );
-		make_twobody_tables( scaffold, rot_index, onebody_energies, rotrfmanager, opts, twob );
-		if( cachefile.size() ) std::cout << "created twobody energies and saving to: " << cachefile << std::endl;
-		if( description=="" ) description = "No description, Will sucks. Complain to willsheffler@gmail.com\n";
-		utility::io::ozstream out;//( cachefile );
-		devel::scheme::open_for_write_on_path( cachepath, cachefile, out, true );
-		twob.save( out, description );
-		out.close();
+		make_twobody_tables( scaffold, rot_index, onebody_energies, rotrfmanager, opts, twob, reuse_twob, same_as, &reused_pairs );
+		bool const mixed_multiplier = opts.favorable_2body_multiplier != 1 &&
+		                    std::find( reused_pairs.begin(), reused_pairs.end(), 1 ) != reused_pairs.end();
+		if( mixed_multiplier ){
+			// the cache holds energies before the multiplier, the copied pairs have it already
+			if( cachefile.size() ) std::cout << "created twobody energies from reused pairs, not saving to: " << cachefile << std::endl;
+		} else {
+			if( cachefile.size() ) std::cout << "created twobody energies and saving to: " << cachefile << std::endl;
+			if( description=="" ) description = "No description, Will sucks. Complain to willsheffler@gmail.com\n";
+			utility::io::ozstream out;//( cachefile );
+			devel::scheme::open_for_write_on_path( cachepath, cachefile, out, true );
+			twob.save( out, description );
+			out.close();
+		}
 	}
 
 
 	if ( opts.favorable_2body_multiplier != 1 ) {
 		for ( uint64_t i = 0; i < twob.twobody_.size(); i++ ) {
 			for ( uint64_t j = 0; j < twob.twobody_[i].size(); j++ ) {
+				if ( reused_pairs.size() && reused_pairs[i*twob.twobody_.size()+j] ) continue;
 				for ( uint64_t k = 0; k < twob.twobody_[i][j].size(); k++ ) {
 					for ( uint64_t l = 0; l < twob.twobody_[i][j][k].size(); l++ ) {
 						float val = twob.twobody_[i][j][k][l];
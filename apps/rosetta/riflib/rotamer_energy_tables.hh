@@ -18,7 +18,9 @@ namespace scheme {
 
 
 
-
+// raw_energies, if given, gets the table before extra_scores and the favorable multiplier.
+//  same_as, reuse_energies, raw_neighbors and reuse_neighbors are passed on to compute_onebody_rotamer_energies,
+//  raw_neighbors is left empty if the table is read from cachefile
 void get_onebody_rotamer_energies(
 	core::pose::Pose const & scaffold,
 	utility::vector1<core::Size> const & scaffold_res,
@@ -29,16 +31,30 @@ void get_onebody_rotamer_energies(
 	bool replace_with_ala = true,
 	float favorable_1be_multiplier = 1,
 	float favorable_1be_cutoff = 0,
-	std::shared_ptr< std::vector< std::vector<float> > > extra_scores_p = nullptr
+	std::shared_ptr< std::vector< std::vector<float> > > extra_scores_p = nullptr,
+	std::vector<std::vector<float> > * raw_energies = nullptr,
+	std::vector<int> const * same_as = nullptr,
+	std::vector<std::vector<float> > const * reuse_energies = nullptr,
+	std::vector<std::vector<int> > * raw_neighbors = nullptr,
+	std::vector<std::vector<int> > const * reuse_neighbors = nullptr
 );
 
+// neighbors, if given, gets the residues (glob0, sorted) each row was scored against.
+// same_as[ir-1] is the index of a residue identical to ir in the pose reuse_energies and
+//  reuse_neighbors were computed for (raw, as from compute_onebody_rotamer_energies), or -1.
+//  Rows of residues that are identical to theirs and see exactly the images of their neighbors
+//  are copied instead of computed. Empty rows in reuse_energies were not computed and are never copied
 void
 compute_onebody_rotamer_energies(
 	core::pose::Pose const & scaffold,
 	utility::vector1<core::Size> const & scaffold_res,
 	RotamerIndex const & rot_index,
 	std::vector<std::vector< float > > & scaffold_onebody_rotamer_energies,
-	bool replace_with_ala = true
+	bool replace_with_ala = true,
+	std::vector<int> const * same_as = nullptr,
+	std::vector<std::vector<float> > const * reuse_energies = nullptr,
+	std::vector<std::vector<int> > * neighbors = nullptr,
+	std::vector<std::vector<int> > const * reuse_neighbors = nullptr
 );
 
 
@@ -171,6 +187,9 @@ struct MakeTwobodyOpts {
 	{}
 };
 
+// pairs of residues that are both in same_as (see compute_onebody_rotamer_energies) and select the
+//  same rotamers as their counterparts in reuse_twob are copied from it instead of computed.
+//  reused_pairs, if given, is set to 1 at [ir*nres+jr] for every copied pair
 void
 make_twobody_tables(
 	core::pose::Pose const & scaffold,
@@ -178,7 +197,10 @@ make_twobody_tables(
 	std::vector<std::vector<float> > const & onebody_energies,
 	RotamerRFTablesManager & rotrfmanager,
 	MakeTwobodyOpts opts,
-	::scheme::objective::storage::TwoBodyTable<float> & twob
+	::scheme::objective::storage::TwoBodyTable<float> & twob,
+	::scheme::objective::storage::TwoBodyTable<float> const * reuse_twob = nullptr,
+	std::vector<int> const * same_as = nullptr,
+	std::vector<char> * reused_pairs = nullptr
 );
 
 void
@@ -191,7 +213,9 @@ get_twobody_tables(
 	std::vector<std::vector<float> > const & onebody_energies,
 	RotamerRFTablesManager & rotrfmanager,
 	MakeTwobodyOpts opts,
-	::scheme::objective::storage::TwoBodyTable<float> & twob
+	::scheme::objective::storage::TwoBodyTable<float> & twob,
+	::scheme::objective::storage::TwoBodyTable<float> const * reuse_twob = nullptr,
+	std::vector<int> const * same_as = nullptr
 );
 
 
@@ -193,6 +193,15 @@ MorphingScaffoldProvider::test_make_children(TreeIndex ti) {
                     temp_data_cache_->scaffold_twobody_p = data_cache->scaffold_twobody_p;
                     temp_data_cache_->local_twobody_p = data_cache->local_twobody_p;
 
+                } else if ( opt.morph_incremental_tables ) {
+                    data_cache->keep_onebody_raw = true;
+                    if ( ! data_cache->local_onebody_p ) {
+                        data_cache->setup_onebody_tables( rot_index_p, opt );
+                    }
+                    if ( ! data_cache->local_twobody_p ) {
+                        data_cache->setup_twobody_tables( rot_index_p, opt, make2bopts, rotrf_table_manager);
+                    }
+                    temp_data_cache_->set_table_parent( data_cache );
                 }
 
                 ParametricSceneConformationCOP conformation = make_conformation_from_data_cache(temp_data_cache_, false);
@@ -280,6 +289,15 @@ MorphingScaffoldProvider::test_make_children(TreeIndex ti) {
                 // two-body
                 temp_data_cache_->scaffold_twobody_p = data_cache->scaffold_twobody_p;
                 temp_data_cache_->local_twobody_p = data_cache->local_twobody_p;
+            } else if ( opt.morph_incremental_tables ) {
+                data_cache->keep_onebody_raw = true;
+                if ( ! data_cache->local_onebody_p ) {
+                    data_cache->setup_onebody_tables( rot_index_p, opt );
+                }
+                if ( ! data_cache->local_twobody_p ) {
+                    data_cache->setup_twobody_tables( rot_index_p, opt, make2bopts, rotrf_table_manager);
+                }
+                temp_data_cache_->set_table_parent( data_cache );
             }
 
             ParametricSceneConformationCOP conformation = make_conformation_from_data_cache(temp_data_cache_, false);
@@ -394,10 +412,6 @@ void
 MorphingScaffoldProvider::setup_twobody_tables( ::scheme::scaffold::TreeIndex i ) {
     get_data_cache_slow( i )->setup_twobody_tables( rot_index_p, opt, make2bopts, rotrf_table_manager);
 }
-void 
-MorphingScaffoldProvider::setup_twobody_tables_per_thread( ::scheme::scaffold::TreeIndex i ) {
-    get_data_cache_slow( i )->setup_twobody_tables_per_thread( );
-}
 
 
 void 
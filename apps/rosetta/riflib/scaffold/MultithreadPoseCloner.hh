@@ -16,8 +16,11 @@
 #include <scheme/types.hh>
 
 #include <core/pose/Pose.hh>
+#include <algorithm>
+#include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 
 
@@ -26,100 +29,70 @@ namespace scheme {
 
 // This class allows one to make the minimum copies of a pose while
 //  in a multithreaded environment where all threads want to clone the
-//  pose. 
+//  pose. Reading a Pose isn't thread safe, so each source pose can only
+//  be cloned by one thread at a time.
 //
 // Works as follows:
-//  If one of the poses is available. Lock and clone it
-//  If none of the poses are available. Wait for a pose, duplicate it, 
-//     store that pose in poses. And then retry again.
+//  A thread takes a free source pose, clones from it, and gives it back.
+//  If none are free the thread sleeps on a condition variable; waiters are
+//    served strictly in arrival order so no thread starves.
+//  When a source is given back while others are waiting, and the pool is
+//    below max_poses, the returning thread first clones one more source
+//    from the pose it still holds. So the pool grows to match demand
+//    without anyone polling, and never past max_poses.
 
 // Theoretically the max number of poses == number of threads
 // Alternatively, it's possible the list will never grow past 1
 
 struct MultithreadPoseCloner {
 
-    std::vector<core::pose::PoseCOP> poses_;
-    std::deque<std::mutex> pose_mutexes_;
-
-    std::mutex vector_mutex_;
+    MultithreadPoseCloner( int max_poses = 0 ) { init( max_poses ); }
 
-    MultithreadPoseCloner() : need_more_poses_(0) {}
-
-    MultithreadPoseCloner(core::pose::PoseCOP pose) : need_more_poses_(0) {
+    MultithreadPoseCloner(core::pose::PoseCOP pose, int max_poses = 0 ) {
+        init( max_poses );
         add_pose( pose );
     }
 
     void
     add_pose( core::pose::PoseCOP pose ) {
-        std::lock_guard<std::mutex> guard( vector_mutex_ );
-        poses_.push_back(pose);
-        pose_mutexes_.resize( poses_.size() );
+        {
+            std::lock_guard<std::mutex> guard( mutex_ );
+            poses_.push_back(pose);
+            free_.push_back( poses_.size()-1 );
+        }
+        cv_.notify_all();
     }
 
     core::pose::PoseCOP
     get_pose() {
-        runtime_assert( poses_.size() > 0);
-
-        core::pose::PoseCOP to_return;
-
-        while ( ! to_return ) {
-            int got_lock_at = -1;
-            {
-                std::lock_guard<std::mutex> guard( vector_mutex_ );
-                for ( int i = 0; i < pose_mutexes_.size(); i++ ) {
-                    if ( pose_mutexes_[i].try_lock() ) {
-                        got_lock_at = i;
-                        break;
-                    }
-                }
-            }
-            if (got_lock_at != -1) {
-                to_return = clone_a_pose( poses_[got_lock_at] );
-                pose_mutexes_[got_lock_at].unlock();
-
-                bool should_duplicate = false;
-                {
-                    std::lock_guard<std::mutex> guard( lock_need_more_poses_ );
-                    if (need_more_poses_ > 0) {
-                        need_more_poses_ -= 1;
-                        should_duplicate = true;
-                    }  
-                }
-                if (should_duplicate) {
-                    core::pose::PoseCOP new_pose = clone_a_pose( to_return );
-                }
-            } else {
-                std::this_thread::sleep_for( std::chrono::milliseconds {1});
-            }
-        }
-
+        core::pose::PoseOP to_return = make_shared<core::pose::Pose>();
+        clone_into( *to_return );
         return to_return;
+    }
 
+    // Clone straight into an existing pose, saves the extra copy of
+    //  pose = *get_pose()
+    void
+    clone_into( core::pose::Pose & dest ) {
+        core::pose::PoseCOP source;
+        int i = acquire( source );
+        dest.detached_copy( *source );
+        release( i, source );
     }
 
-    // Don't be super smart/clever here. Just wait for a mutex on the last
-    // element
+    // Grow the pool by one without waiting for demand
     void
     duplicate_a_pose() {
-        int pose_to_lock = 0;
-        {
-            std::lock_guard<std::mutex> guard( vector_mutex_ );
-            pose_to_lock = pose_mutexes_.size() - 1;
-        }
-        {
-            std::lock_guard<std::mutex> guard( lock_need_more_poses_ );
-            need_more_poses_ += 1;
-        }
-        pose_mutexes_[pose_to_lock].lock();
-        core::pose::PoseCOP new_pose = clone_a_pose( poses_[pose_to_lock] );
-        pose_mutexes_[pose_to_lock].unlock();
-
+        core::pose::PoseCOP source;
+        int i = acquire( source );
+        core::pose::PoseCOP new_pose = clone_a_pose( source );
+        release( i, source );
         add_pose( new_pose );
     }
 
     uint64_t
     size() {
-        std::lock_guard<std::mutex> guard( vector_mutex_ );
+        std::lock_guard<std::mutex> guard( mutex_ );
         return poses_.size();
     }
 
@@ -134,8 +107,63 @@ struct MultithreadPoseCloner {
 
 private:
 
-    std::mutex lock_need_more_poses_;
-    int need_more_poses_;
+    void
+    init( int max_poses ) {
+        max_poses_ = max_poses > 0 ? max_poses : std::max<int>( 1, std::thread::hardware_concurrency() );
+        next_ticket_ = 0;
+        now_serving_ = 0;
+    }
+
+    // wait (in ticket order) for a free source pose, hand out a reference to it
+    int
+    acquire( core::pose::PoseCOP & source ) {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        runtime_assert( poses_.size() > 0 );
+        uint64_t const ticket = next_ticket_++;
+        cv_.wait( lock, [&]{ return ticket == now_serving_ && ! free_.empty(); } );
+        ++now_serving_;
+        int i = free_.back();
+        free_.pop_back();
+        source = poses_[i];
+        bool const wake_next = ! free_.empty() && now_serving_ != next_ticket_;
+        lock.unlock();
+        if ( wake_next ) cv_.notify_all();
+        return i;
+    }
+
+    void
+    release( int i, core::pose::PoseCOP const & source ) {
+        bool grow = false;
+        {
+            std::lock_guard<std::mutex> guard( mutex_ );
+            // somebody is queued and there's room: one more source, reserved now so
+            //  concurrent releases don't overshoot max_poses
+            if ( next_ticket_ != now_serving_ && poses_.size() + growing_ < max_poses_ ) {
+                grow = true;
+                ++growing_;
+            }
+        }
+        core::pose::PoseCOP new_pose;
+        if ( grow ) new_pose = clone_a_pose( source ); // still held exclusively
+        {
+            std::lock_guard<std::mutex> guard( mutex_ );
+            free_.push_back( i );
+            if ( grow ) {
+                --growing_;
+                poses_.push_back( new_pose );
+                free_.push_back( poses_.size()-1 );
+            }
+        }
+        cv_.notify_all();
+    }
+
+    std::vector<core::pose::PoseCOP> poses_;
+    std::vector<int> free_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint64_t next_ticket_, now_serving_;
+    size_t growing_ = 0;
+    size_t max_poses_;
 };
 
 
@@ -0,0 +1,303 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+
+#include <riflib/scaffold/NineATable.hh>
+#include <riflib/rifdock_typedefs.hh>
+
+#include <scheme/objective/hash/XformHash.hh>
+
+#include <utility/exit.hh>
+#include <utility/string_util.hh>
+#include <utility/vector1.hh>
+#include <ObjexxFCL/format.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+
+
+namespace devel {
+namespace scheme {
+
+
+namespace {
+
+// bump these if NineARow or the geometric key change, old binary tables will then be ignored
+uint64_t const NINEA_ROWS_TAG = 0x3941524f57530001ull;
+uint64_t const NINEA_CHILDREN_TAG = 0x394143484c440001ull;
+uint64_t const NINEA_GEOKEYS_TAG = 0x3941474b45590001ull;
+
+float const NINEA_GEOKEY_CART_RESL = 1.0;
+float const NINEA_GEOKEY_ANG_RESL = 15.0;
+float const NINEA_GEOKEY_CART_BOUND = 64.0;
+
+// the binary tables carry their format tag mixed with a hash of the text table they were made from,
+//  so an edited or replaced text table makes them stale instead of silently loading old clusters
+// 0 if the text table can't be read, which no written tag matches
+uint64_t
+text_table_hash( std::string const & text_fname ) {
+    std::ifstream in( text_fname.c_str(), std::ios::binary );
+    if ( ! in.good() ) return 0;
+    std::vector<char> buf( ::scheme::io::bulk_array_impl::CHUNK );
+    uint64_t h = 0;
+    uint64_t ichunk = 0;
+    while ( in ) {
+        in.read( buf.data(), buf.size() );
+        std::streamsize const n = in.gcount();
+        if ( n <= 0 ) break;
+        h = ::scheme::io::bulk_array_impl::mix( h ^ ::scheme::io::bulk_array_impl::chunk_checksum(
+                (unsigned char const *)buf.data(), n, ichunk ) ) + ichunk;
+        ichunk++;
+    }
+    return h ? h : 1;
+}
+
+uint64_t
+source_tag( uint64_t text_hash, uint64_t format_tag ) {
+    if ( ! text_hash ) return 0;
+    uint64_t const tag = ::scheme::io::bulk_array_impl::mix( text_hash ^ format_tag );
+    return tag ? tag : 1;
+}
+
+bool
+child_less( NineAChild const & a, NineAChild const & b ) {
+    return a.parent_clust < b.parent_clust || ( a.parent_clust == b.parent_clust && a.clust < b.clust );
+}
+
+bool
+geokey_less( NineAGeoKey const & a, NineAGeoKey const & b ) {
+    return a.key < b.key || ( a.key == b.key && a.clust < b.clust );
+}
+
+Eigen::Vector3f
+row_atom( NineARow const & r, uint64_t ires, uint64_t iatom ) {
+    uint64_t const i = ires*4 + iatom;
+    return Eigen::Vector3f(
+        r.float_fields[static_cast<int>(X_1) + i],
+        r.float_fields[static_cast<int>(Y_1) + i],
+        r.float_fields[static_cast<int>(Z_1) + i] );
+}
+
+}
+
+
+NineATable::COP
+NineATable::load( std::string const & text_fname ) {
+    shared_ptr<NineATable> table = make_shared<NineATable>();
+    if ( table->open_binary( text_fname ) ) {
+        std::cout << "NineATable: mapped " << table->size() << " clusters from " << rows_fname( text_fname ) << std::endl;
+    } else {
+        std::cout << "NineATable: reading " << text_fname << ", run nineA_make_binary_tables on it to skip this next time" << std::endl;
+        table->read_text( text_fname );
+    }
+    return table;
+}
+
+
+void
+NineATable::read_text( std::string const & filename ) {
+    using ObjexxFCL::format::I;
+
+    std::ifstream f( filename );
+
+    if ( !f ) {
+        utility_exit_with_message("nineA_cluster_path file not found: " + filename);
+    }
+
+    std::string line;
+    std::getline( f, line );
+
+    utility::vector1< std::string > string_split = utility::string_split( line, '\t' );
+
+    if ( string_split.size() != 395 ) {
+        utility_exit_with_message("nineA_cluster_path file has wrong number of columns:  "
+            + I(3,string_split.size()) + " != 395 " + filename);
+    }
+
+    rows_vec_.clear();
+
+    while ( std::getline( f, line ) ) {
+        utility::vector1< std::string > sp = utility::string_split( line, '\t' );
+        if ( sp.size() <= 1 ) {
+            break;
+        }
+        if ( sp.size() != 395 ) {
+            utility_exit_with_message("nineA_cluster_path file has wrong number of columns inside:  "
+            + I(3,sp.size()) + " != 395 " + filename);
+        }
+
+        NineARow r;
+        std::memset( &r, 0, sizeof(NineARow) );
+        uint64_t pos = 1;
+
+        pos++;
+        r.int_fields[Clust] = stoi(sp[pos++]);
+        r.int_fields[NumCon] = stoi(sp[pos++]);
+        r.float_fields[AvgRad] = stof(sp[pos++]);
+        r.float_fields[MaxRad] = stof(sp[pos++]);
+        for ( int i = 0; i < 36*3; i++ ) {
+            r.float_fields[static_cast<int>(X_1) + i] = stof(sp[pos++]);
+        }
+        for ( int i = 0; i < 3*9; i++ ) {
+            r.float_fields[static_cast<int>(Phi_1) + i] = stof(sp[pos++]);
+        }
+        pos += 393 - 141;
+        std::string const & name = sp[pos++];
+        if ( name.size() >= NINEA_FILENAME_LEN ) {
+            utility_exit_with_message("nineA_cluster_path filename column too long: " + name );
+        }
+        std::strncpy( r.filename, name.c_str(), NINEA_FILENAME_LEN-1 );
+        pos++;
+        r.int_fields[PrevAssig] = stoi(sp[pos++]);
+
+        rows_vec_.push_back( r );
+    }
+
+    f.close();
+
+    children_vec_.resize( rows_vec_.size() );
+    geokeys_vec_.resize( rows_vec_.size() );
+    for ( uint64_t i = 0; i < rows_vec_.size(); i++ ) {
+        children_vec_[i].parent_clust = rows_vec_[i].int_fields[PrevAssig];
+        children_vec_[i].clust = i + 1;
+        geokeys_vec_[i].key = geometric_key( first_to_last( rows_vec_[i] ) );
+        geokeys_vec_[i].clust = i + 1;
+    }
+    std::sort( children_vec_.begin(), children_vec_.end(), child_less );
+    std::sort( geokeys_vec_.begin(), geokeys_vec_.end(), geokey_less );
+
+    point_at_vectors();
+}
+
+
+bool
+NineATable::open_binary( std::string const & text_fname ) {
+    uint64_t const text_hash = text_table_hash( text_fname );
+    if ( ! text_hash ||
+         ! rows_map_.open( rows_fname( text_fname ), source_tag( text_hash, NINEA_ROWS_TAG ) ) ||
+         ! children_map_.open( children_fname( text_fname ), source_tag( text_hash, NINEA_CHILDREN_TAG ) ) ||
+         ! geokeys_map_.open( geokeys_fname( text_fname ), source_tag( text_hash, NINEA_GEOKEYS_TAG ) ) ) {
+        rows_map_.close();
+        children_map_.close();
+        geokeys_map_.close();
+        return false;
+    }
+    if ( children_map_.size() != rows_map_.size() || geokeys_map_.size() != rows_map_.size() ) {
+        std::cout << "NineATable: binary tables for " << text_fname << " disagree in size, ignoring them" << std::endl;
+        rows_map_.close();
+        children_map_.close();
+        geokeys_map_.close();
+        return false;
+    }
+    rows_vec_.clear();
+    children_vec_.clear();
+    geokeys_vec_.clear();
+    rows_ = rows_map_.data();
+    nrows_ = rows_map_.size();
+    children_ = children_map_.data();
+    nchildren_ = children_map_.size();
+    geokeys_ = geokeys_map_.data();
+    ngeokeys_ = geokeys_map_.size();
+    return true;
+}
+
+
+bool
+NineATable::write_binary( std::string const & text_fname ) const {
+    uint64_t const text_hash = text_table_hash( text_fname );
+    if ( ! text_hash ) return false;
+    return ::scheme::io::write_bulk_array( rows_fname( text_fname ), rows_, nrows_, source_tag( text_hash, NINEA_ROWS_TAG ) )
+        && ::scheme::io::write_bulk_array( children_fname( text_fname ), children_, nchildren_, source_tag( text_hash, NINEA_CHILDREN_TAG ) )
+        && ::scheme::io::write_bulk_array( geokeys_fname( text_fname ), geokeys_, ngeokeys_, source_tag( text_hash, NINEA_GEOKEYS_TAG ) );
+}
+
+
+void
+NineATable::point_at_vectors() {
+    rows_map_.close();
+    children_map_.close();
+    geokeys_map_.close();
+    rows_ = rows_vec_.data();
+    nrows_ = rows_vec_.size();
+    children_ = children_vec_.data();
+    nchildren_ = children_vec_.size();
+    geokeys_ = geokeys_vec_.data();
+    ngeokeys_ = geokeys_vec_.size();
+}
+
+
+NineARow const &
+NineATable::row( uint64_t clust ) const {
+    runtime_assert_msg( 1 <= clust && clust <= nrows_, "NineATable: no cluster " + utility::to_string(clust) );
+    return rows_[clust-1];
+}
+
+
+StatRow
+NineATable::stat_row( uint64_t clust ) const {
+    NineARow const & r = row( clust );
+    StatRow sr;
+    sr.int_fields.assign( r.int_fields, r.int_fields + last_int_field );
+    sr.float_fields.assign( r.float_fields, r.float_fields + last_float_field );
+    sr.filename = r.filename;
+    return sr;
+}
+
+
+std::vector<uint64_t>
+NineATable::children_of( uint64_t parent_clust ) const {
+    NineAChild lo, hi;
+    lo.parent_clust = hi.parent_clust = parent_clust;
+    lo.clust = 0;
+    hi.clust = std::numeric_limits<uint64_t>::max();
+    NineAChild const * beg = std::lower_bound( children_, children_ + nchildren_, lo, child_less );
+    NineAChild const * end = std::upper_bound( beg, children_ + nchildren_, hi, child_less );
+    std::vector<uint64_t> clusts;
+    for ( NineAChild const * it = beg; it != end; ++it ) clusts.push_back( it->clust );
+    return clusts;
+}
+
+
+std::vector<uint64_t>
+NineATable::find_by_geometry( EigenXform const & first_to_last ) const {
+    NineAGeoKey lo;
+    lo.key = geometric_key( first_to_last );
+    lo.clust = 0;
+    std::vector<uint64_t> clusts;
+    for ( NineAGeoKey const * it = std::lower_bound( geokeys_, geokeys_ + ngeokeys_, lo, geokey_less );
+            it != geokeys_ + ngeokeys_ && it->key == lo.key; ++it ) {
+        clusts.push_back( it->clust );
+    }
+    return clusts;
+}
+
+
+EigenXform
+NineATable::first_to_last( NineARow const & r ) {
+    BBActor first( row_atom( r, 0, DanielAtomIndex::N ), row_atom( r, 0, DanielAtomIndex::CA ), row_atom( r, 0, DanielAtomIndex::C ) );
+    BBActor last ( row_atom( r, 8, DanielAtomIndex::N ), row_atom( r, 8, DanielAtomIndex::CA ), row_atom( r, 8, DanielAtomIndex::C ) );
+    return first.position().inverse() * last.position();
+}
+
+
+uint64_t
+NineATable::geometric_key( EigenXform const & first_to_last ) {
+    static ::scheme::objective::hash::XformHash_bt24_BCC6<EigenXform> const hasher(
+        NINEA_GEOKEY_CART_RESL, NINEA_GEOKEY_ANG_RESL, NINEA_GEOKEY_CART_BOUND );
+    return hasher.get_key( first_to_last );
+}
+
+
+
+}}
+
@@ -93,7 +93,12 @@ struct ScaffoldDataCache {
     shared_ptr<TBT> scaffold_twobody_p;                                        // twobody_rotamer_energies using global_seqpos
     shared_ptr<TBT> local_twobody_p;                                           // twobody_rotamer_energies using local_seqpos
 
-    std::vector<shared_ptr<TBT>> local_twobody_per_thread;                     // Used with BuriedUnsats, these can momentarily change but must be reset
+    bool keep_onebody_raw = false;
+    shared_ptr<std::vector<std::vector<float> > > scaffold_onebody_raw_p;      // onebodies before custom energies and multipliers, only if keep_onebody_raw
+    shared_ptr<std::vector<std::vector<int> > > scaffold_onebody_neighbors_p;  // what each onebody row was scored against, only if keep_onebody_raw
+
+    shared_ptr<ScaffoldDataCache> table_parent_p;                              // 1-/2-body tables are reused from here where residues are identical
+    shared_ptr<std::vector<int>> table_parent_same_as_p;                       // maps global_seqpos -> identical global_seqpos in table_parent_p or -1
 
 
     MultithreadPoseCloner mpc_both_pose;                                       // scaffold_centered_p + target
@@ -470,6 +475,48 @@ struct ScaffoldDataCache {
        
     }
 
+    // The tables of a morph are mostly those of its parent. Residues that are identical to one of
+    //  parent's, and only see identical residues, get their energies copied from parent instead of
+    //  computed. parent needs keep_onebody_raw set before its tables are made for the onebodies
+    //  to be reused. Call before the setup_*_tables
+    void
+    set_table_parent( shared_ptr<ScaffoldDataCache> parent ) {
+        table_parent_p = parent;
+        table_parent_same_as_p = make_shared<std::vector<int>>(
+            find_identical_residues( *scaffold_centered_p, *parent->scaffold_centered_p, 0.01 ) );
+
+        int nsame = 0;
+        for ( int same : *table_parent_same_as_p ) nsame += same >= 0;
+        std::cout << "scaffold " << scafftag << " shares " << nsame << " of " << table_parent_same_as_p->size()
+                  << " residues with " << parent->scafftag << std::endl;
+    }
+
+    // -test_morph_incremental_tables: compute the onebodies from scratch and check they match
+    //  the ones partly copied from table_parent_p
+    void
+    test_reused_onebody_tables( RotamerIndex const & rot_index ) const {
+        std::vector<std::vector<float> > full;
+        compute_onebody_rotamer_energies( *scaffold_centered_p, *scaffold_res_p, rot_index, full );
+        runtime_assert( full.size() == scaffold_onebody_raw_p->size() );
+
+        int nwrong = 0;
+        for ( int ir = 0; ir < full.size(); ir++ ) {
+            if ( ! (*scaffuseres_p)[ir] ) continue;
+            std::vector<float> const & row = (*scaffold_onebody_raw_p)[ir];
+            runtime_assert( row.size() == full[ir].size() );
+            for ( int irot = 0; irot < row.size(); irot++ ) {
+                if ( std::abs( row[irot] - full[ir][irot] ) > 0.001 ) {
+                    std::cout << "scaffold " << scafftag << " onebody of res " << ir+1 << " rot " << irot
+                              << " differs from the full table: " << row[irot] << " vs " << full[ir][irot] << std::endl;
+                    nwrong++;
+                    break;
+                }
+            }
+        }
+        std::cout << "scaffold " << scafftag << " incremental onebody test: " << nwrong << " residues differ" << std::endl;
+        if ( nwrong ) utility_exit_with_message( "-morph_incremental_tables reused onebody energies that changed" );
+    }
+
     // setup scaffold_onebody_glob0_p and local_onebody_p
     void
     setup_onebody_tables(
@@ -482,6 +529,13 @@ struct ScaffoldDataCache {
 
         std::string cachefile_1be = "__1BE_"+scafftag+(opt.replace_all_with_ala_1bre?"_ALLALA":"")+"_reshash"+scaff_res_hashstr+".bin.gz";
         if( ! opt.cache_scaffold_data ) cachefile_1be = "";
+        if ( keep_onebody_raw || opt.test_morph_incremental_tables ) {
+            scaffold_onebody_raw_p = make_shared<std::vector<std::vector<float> >>();
+            scaffold_onebody_neighbors_p = make_shared<std::vector<std::vector<int> >>();
+        }
+        bool const reuse = table_parent_p && table_parent_p->scaffold_onebody_raw_p
+                        && table_parent_p->scaffold_onebody_neighbors_p->size() == table_parent_p->scaffold_onebody_raw_p->size();
+
         std::cout << "rifdock: get_onebody_rotamer_energies" << std::endl;
         get_onebody_rotamer_energies(
                 *scaffold_centered_p,
@@ -493,9 +547,23 @@ struct ScaffoldDataCache {
                 opt.replace_all_with_ala_1bre,
                 opt.favorable_1body_multiplier,
                 opt.favorable_1body_multiplier_cutoff,
-                per_rotamer_custom_energies_p
+                per_rotamer_custom_energies_p,
+                scaffold_onebody_raw_p.get(),
+                reuse ? table_parent_same_as_p.get() : nullptr,
+                reuse ? table_parent_p->scaffold_onebody_raw_p.get() : nullptr,
+                scaffold_onebody_neighbors_p.get(),
+                reuse ? table_parent_p->scaffold_onebody_neighbors_p.get() : nullptr
             );
 
+        if ( reuse && opt.test_morph_incremental_tables ) test_reused_onebody_tables( *rot_index_p );
+
+        if ( scaffold_onebody_raw_p ) {
+            // these were never computed, don't let anyone copy them
+            for( int i = 0; i < scaffuseres_p->size(); ++i ){
+                if( ! (*scaffuseres_p)[i] ) (*scaffold_onebody_raw_p)[i].clear();
+            }
+        }
+
         // Handled above to make things more streamlined
         // if( opt.restrict_to_native_scaffold_res ){
         //     std::cout << "KILLING NON-NATIVE ROTAMERS ON SCAFFOLD!!!" << std::endl;
@@ -550,6 +618,7 @@ struct ScaffoldDataCache {
         std::string cachefile2b = "__2BE_" + scafftag + "_reshash" + scaff_res_hashstr + energy_cut + ".bin.gz";
         if( ! opt.cache_scaffold_data || opt.extra_rotamers ) cachefile2b = "";
         std::string dscrtmp;
+        bool const reuse = table_parent_p && table_parent_p->scaffold_twobody_p;
         get_twobody_tables(
                 opt.data_cache_path,
                 cachefile2b,
@@ -559,7 +628,9 @@ struct ScaffoldDataCache {
                 *scaffold_onebody_glob0_p,
                 rotrf_table_manager,
                 make2bopts,
-                *scaffold_twobody_p
+                *scaffold_twobody_p,
+                reuse ? table_parent_p->scaffold_twobody_p.get() : nullptr,
+                reuse ? table_parent_same_as_p.get() : nullptr
             );
 
 
@@ -580,35 +651,6 @@ struct ScaffoldDataCache {
 
 
 
-    // setup scaffold_twobody_p and local_twobody_p
-    void
-    setup_twobody_tables_per_thread( ) {
-        runtime_assert( local_twobody_p );
-
-        if ( local_twobody_per_thread.size() > 0 ) return;
-
-        local_twobody_per_thread.resize(::devel::scheme::omp_max_threads_1());
-
-        for ( int i = 0; i < local_twobody_per_thread.size(); i++ ) {
-            local_twobody_per_thread[i] = local_twobody_p->clone();
-        }
-    }
-
-    bool
-    check_twobody_tables_per_thread_integrity( ) {
-        runtime_assert( local_twobody_per_thread.size() > 0 );
-
-        local_twobody_per_thread.resize(::devel::scheme::omp_max_threads_1());
-
-        for ( int i = 0; i < local_twobody_per_thread.size(); i++ ) {
-            if ( ! local_twobody_per_thread[i]->check_equal( *local_twobody_p) ) {
-                return false;
-            }
-        }
-        return true;
-    }
-
-
     float
     get_redundancy_filter_rg( float target_redundancy_filter_rg ) {
         return std::min( target_redundancy_filter_rg, scaff_redundancy_filter_rg );
@@ -776,6 +776,41 @@ add_pdbinfo_if_missing( core::pose::Pose & pose ) {
 }
 
 
+std::vector<int>
+find_identical_residues( core::pose::Pose const & pose, core::pose::Pose const & reference, float tolerance ) {
+
+    float const tol2 = tolerance * tolerance;
+    auto same = [&]( core::Size ir, core::Size jr ) {
+        core::conformation::Residue const & a = pose.residue(ir);
+        core::conformation::Residue const & b = reference.residue(jr);
+        if ( a.type().name() != b.type().name() ) return false;
+        for ( core::Size ia = 1; ia <= a.natoms(); ia++ ) {
+            if ( a.xyz(ia).distance_squared( b.xyz(ia) ) > tol2 ) return false;
+        }
+        return true;
+    };
+
+    // morphs keep the residue order, so try the one after the last match first
+    std::vector<int> same_as( pose.size(), -1 );
+    core::Size hint = 1;
+    for ( core::Size ir = 1; ir <= pose.size(); ir++ ) {
+        if ( hint <= reference.size() && same( ir, hint ) ) {
+            same_as[ir-1] = hint - 1;
+            hint++;
+            continue;
+        }
+        for ( core::Size jr = 1; jr <= reference.size(); jr++ ) {
+            if ( same( ir, jr ) ) {
+                same_as[ir-1] = jr - 1;
+                hint = jr + 1;
+                break;
+            }
+        }
+    }
+    return same_as;
+}
+
+
 bool
 internal_comparative_clash_check( core::scoring::Energies const & original_energies,
     core::pose::Pose const & to_check,
@@ -92,6 +92,11 @@ get_default_scaffold_res( core::pose::Pose const & pose,
 void
 add_pdbinfo_if_missing( core::pose::Pose & pose );
 
+// for each residue of pose, the 0-indexed residue of reference with the same residue type and
+//  every atom within tolerance, or -1
+std::vector<int>
+find_identical_residues( core::pose::Pose const & pose, core::pose::Pose const & reference, float tolerance );
+
 
 bool
 internal_comparative_clash_check( core::scoring::Energies const & original_energies,
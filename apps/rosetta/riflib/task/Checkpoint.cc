@@ -0,0 +1,296 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+
+#include <riflib/task/Checkpoint.hh>
+#include <riflib/task/PointIO.hh>
+
+#include <riflib/types.hh>
+
+#include <scheme/util/FlatIndexSet.hh>
+#include <scheme/util/PerfReport.hh>
+
+#include <utility/file/file_sys_util.hh>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+namespace checkpoint {
+
+using namespace point_io;
+
+static uint64_t const MAGIC = 0x31544b4346495200llu; // "\0RIFCKT1"
+static uint64_t const DONE_MAGIC = MAGIC + 2;
+
+void write_timings( std::ostream & out, ProtocolData const & pd ) {
+    write_pod( out, pd.time_rif );
+    write_pod( out, pd.time_pck );
+    write_pod( out, pd.time_ros );
+}
+bool read_timings( std::istream & in, ProtocolData & pd ) {
+    return read_pod( in, pd.time_rif ) && read_pod( in, pd.time_pck ) && read_pod( in, pd.time_ros );
+}
+
+// seeding_tags are not stored, they are rebuilt with the seeding positions before the protocol runs
+void write_protocol_data( std::ostream & out, ProtocolData const & pd ) {
+    write_pod( out, pd.non0_space_size );
+    write_pod( out, pd.total_search_effort );
+    write_pod( out, pd.npack );
+    write_timings( out, pd );
+    std::chrono::duration<double> since_start_rif = std::chrono::high_resolution_clock::now() - pd.start_rif;
+    write_pod( out, since_start_rif.count() );
+    write_pod( out, pd.hsearch_rate );
+    write_pod( out, pd.beam_multiplier );
+    write_pod_vector( out, pd.unique_scaffolds );
+    write_pod_vector( out, pd.hsearch_parent_hits );
+    write_pod( out, pd.hsearch_parent_hit_words );
+    write_pod( out, pd.hsearch_children_per_parent );
+    write_pod( out, pd.hsearch_parent_hits_resl );
+    write_pod( out, pd.hsearch_parent_hits_nsamples );
+}
+bool read_protocol_data( std::istream & in, ProtocolData & pd ) {
+    double since_start_rif;
+    bool ok = read_pod( in, pd.non0_space_size ) && read_pod( in, pd.total_search_effort ) && read_pod( in, pd.npack )
+           && read_timings( in, pd ) && read_pod( in, since_start_rif )
+           && read_pod( in, pd.hsearch_rate ) && read_pod( in, pd.beam_multiplier )
+           && read_pod_vector( in, pd.unique_scaffolds ) && read_pod_vector( in, pd.hsearch_parent_hits )
+           && read_pod( in, pd.hsearch_parent_hit_words ) && read_pod( in, pd.hsearch_children_per_parent )
+           && read_pod( in, pd.hsearch_parent_hits_resl ) && read_pod( in, pd.hsearch_parent_hits_nsamples );
+    if ( ok ) {
+        pd.start_rif = std::chrono::high_resolution_clock::now() - std::chrono::duration_cast<
+            std::chrono::high_resolution_clock::duration>( std::chrono::duration<double>( since_start_rif ) );
+    }
+    return ok;
+}
+
+// expands @flag files (whitespace separated, # to end of line is a comment) in place
+void gather_args( std::string const & arg, std::vector<std::string> & args, int depth ) {
+    if ( arg.size() > 1 && arg[0] == '@' && depth < 8 ) {
+        std::ifstream in( arg.substr(1) );
+        std::string line;
+        while ( std::getline( in, line ) ) {
+            std::istringstream words( line.substr( 0, line.find('#') ) );
+            std::string word;
+            while ( words >> word ) gather_args( word, args, depth+1 );
+        }
+        return;
+    }
+    args.push_back( arg );
+}
+
+// -checkpoint_dir, -rif_dock:checkpoint_interval, -rif_dock::checkpoint_dir=x ...
+bool is_checkpoint_flag( std::string const & arg, bool & takes_value ) {
+    if ( arg.size() < 2 || arg[0] != '-' ) return false;
+    std::string name = arg.substr( arg.find_first_not_of('-') );
+    takes_value = name.find('=') == std::string::npos;
+    name = name.substr( 0, name.find('=') );
+    if ( name.rfind(':') != std::string::npos ) name = name.substr( name.rfind(':')+1 );
+    return name == "checkpoint_dir" || name == "checkpoint_interval";
+}
+
+}
+
+
+TaskCheckpoint::TaskCheckpoint(
+    std::string const & dir,
+    std::string const & scafftag,
+    double min_interval_seconds,
+    uint64_t options_key
+) :
+    state_fname_( dir + "/" + scafftag + ".ckpt" ),
+    done_fname_( dir + "/" + scafftag + ".done" ),
+    min_interval_seconds_( min_interval_seconds ),
+    last_save_( ::scheme::util::PerfReport::wall_seconds() ),
+    options_key_( options_key )
+{
+    if ( ! utility::file::file_exists( dir ) ) {
+        utility::file::create_directory_recursive( dir );
+    }
+}
+
+uint64_t
+TaskCheckpoint::options_key( int argc, char const * const * argv ) {
+    std::vector<std::string> args;
+    for ( int i = 1; i < argc; i++ ) checkpoint::gather_args( argv[i], args, 0 );
+
+    uint64_t key = checkpoint::MAGIC;
+    for ( size_t i = 0; i < args.size(); i++ ) {
+        bool takes_value = false;
+        if ( checkpoint::is_checkpoint_flag( args[i], takes_value ) ) {
+            if ( takes_value && i+1 < args.size() && ( args[i+1].empty() || args[i+1][0] != '-' ) ) i++;
+            continue;
+        }
+        key = ::scheme::util::hash_combine64( key, args[i].size() );
+        for ( char c : args[i] ) key = ::scheme::util::hash_combine64( key, (uint8_t)c );
+    }
+    return key;
+}
+
+uint64_t
+TaskCheckpoint::protocol_key( std::vector<shared_ptr<Task>> const & tasks ) const {
+    uint64_t key = ::scheme::util::hash_combine64( options_key_, tasks.size() );
+    for ( shared_ptr<Task> const & task : tasks ) {
+        std::string const name = task->name();
+        for ( char c : name ) key = ::scheme::util::hash_combine64( key, (uint8_t)c );
+        key = ::scheme::util::hash_combine64( key, (uint64_t)( task->report_resl() + 1 ) );
+    }
+    return key;
+}
+
+bool
+TaskCheckpoint::load(
+    uint64_t protocol_key,
+    size_t & next_taskno,
+    TaskType & last_task_type,
+    ThreePointVectors & vectors,
+    ProtocolData & pd
+) const {
+    using namespace checkpoint;
+
+    std::ifstream in( state_fname_, std::ios::binary );
+    if ( ! in ) return false;
+
+    uint64_t magic, key, taskno;
+    int32_t type;
+    if ( ! ( read_pod( in, magic ) && read_pod( in, key ) ) || magic != MAGIC ) {
+        std::cout << "WARNING: ignoring unreadable checkpoint " << state_fname_ << std::endl;
+        return false;
+    }
+    if ( key != protocol_key ) {
+        std::cout << "WARNING: ignoring checkpoint " << state_fname_ << ", it was written by a different task list or with different options" << std::endl;
+        return false;
+    }
+
+    ThreePointVectors loaded;
+    ProtocolData loaded_pd = pd;
+    if ( ! ( read_pod( in, taskno ) && read_pod( in, type )
+          && read_protocol_data( in, loaded_pd )
+          && read_optional_points( in, loaded.search_points )
+          && read_optional_points( in, loaded.search_point_with_rotss )
+          && read_optional_points( in, loaded.rif_dock_results ) ) ) {
+        std::cout << "WARNING: ignoring truncated checkpoint " << state_fname_ << std::endl;
+        return false;
+    }
+
+    next_taskno = taskno;
+    last_task_type = (TaskType)type;
+    vectors = loaded;
+    pd.non0_space_size = loaded_pd.non0_space_size;
+    pd.total_search_effort = loaded_pd.total_search_effort;
+    pd.npack = loaded_pd.npack;
+    pd.time_rif = loaded_pd.time_rif;
+    pd.time_pck = loaded_pd.time_pck;
+    pd.time_ros = loaded_pd.time_ros;
+    pd.start_rif = loaded_pd.start_rif;
+    pd.hsearch_rate = loaded_pd.hsearch_rate;
+    pd.beam_multiplier = loaded_pd.beam_multiplier;
+    pd.unique_scaffolds = loaded_pd.unique_scaffolds;
+    pd.hsearch_parent_hits.swap( loaded_pd.hsearch_parent_hits );
+    pd.hsearch_parent_hit_words = loaded_pd.hsearch_parent_hit_words;
+    pd.hsearch_children_per_parent = loaded_pd.hsearch_children_per_parent;
+    pd.hsearch_parent_hits_resl = loaded_pd.hsearch_parent_hits_resl;
+    pd.hsearch_parent_hits_nsamples = loaded_pd.hsearch_parent_hits_nsamples;
+    return true;
+}
+
+bool
+TaskCheckpoint::maybe_save(
+    uint64_t protocol_key,
+    size_t next_taskno,
+    TaskType last_task_type,
+    ThreePointVectors const & vectors,
+    ProtocolData const & pd
+) {
+    double const now = ::scheme::util::PerfReport::wall_seconds();
+    if ( now - last_save_ < min_interval_seconds_ ) return false;
+
+    if ( point_io::has_poses( vectors.search_point_with_rotss ) || point_io::has_poses( vectors.rif_dock_results ) ) {
+        return false;
+    }
+
+    if ( ! save( protocol_key, next_taskno, last_task_type, vectors, pd ) ) {
+        std::cout << "WARNING: could not write checkpoint " << state_fname_ << std::endl;
+        return false;
+    }
+    double const after = ::scheme::util::PerfReport::wall_seconds();
+    std::cout << "wrote checkpoint " << state_fname_ << " in " << after - now << "s" << std::endl;
+    last_save_ = after;
+    return true;
+}
+
+// written next to the real file and renamed over it, a preemption mid-write leaves the old checkpoint
+bool
+TaskCheckpoint::save(
+    uint64_t protocol_key,
+    size_t next_taskno,
+    TaskType last_task_type,
+    ThreePointVectors const & vectors,
+    ProtocolData const & pd
+) const {
+    using namespace checkpoint;
+
+    std::string const tmp_fname = state_fname_ + ".tmp";
+    {
+        std::ofstream out( tmp_fname, std::ios::binary | std::ios::trunc );
+        if ( ! out ) return false;
+        write_pod( out, MAGIC );
+        write_pod( out, protocol_key );
+        write_pod( out, (uint64_t)next_taskno );
+        write_pod( out, (int32_t)last_task_type );
+        write_protocol_data( out, pd );
+        write_optional_points( out, vectors.search_points );
+        write_optional_points( out, vectors.search_point_with_rotss );
+        write_optional_points( out, vectors.rif_dock_results );
+        out.flush();
+        if ( ! out ) return false;
+    }
+    return 0 == std::rename( tmp_fname.c_str(), state_fname_.c_str() );
+}
+
+void
+TaskCheckpoint::mark_done( ProtocolData const & pd ) {
+    using namespace checkpoint;
+    {
+        std::ofstream out( done_fname_, std::ios::binary | std::ios::trunc );
+        write_pod( out, DONE_MAGIC );
+        write_pod( out, options_key_ );
+        write_timings( out, pd );
+    }
+    std::remove( state_fname_.c_str() );
+}
+
+bool
+TaskCheckpoint::is_done( ProtocolData & pd ) const {
+    using namespace checkpoint;
+    std::ifstream in( done_fname_, std::ios::binary );
+    if ( ! in ) return false;
+    uint64_t magic, key;
+    ProtocolData tmp;
+    if ( ! ( read_pod( in, magic ) && magic == DONE_MAGIC && read_pod( in, key ) && read_timings( in, tmp ) ) ) return false;
+    if ( key != options_key_ ) {
+        std::cout << "WARNING: ignoring " << done_fname_ << ", it was written with different options" << std::endl;
+        return false;
+    }
+    pd.time_rif = tmp.time_rif;
+    pd.time_pck = tmp.time_pck;
+    pd.time_ros = tmp.time_ros;
+    return true;
+}
+
+
+
+}}
@@ -0,0 +1,101 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+#ifndef INCLUDED_riflib_task_Checkpoint_hh
+#define INCLUDED_riflib_task_Checkpoint_hh
+
+#include <riflib/types.hh>
+#include <riflib/task/TaskProtocol.hh>
+
+#include <string>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+// Saves the state of a TaskProtocol between tasks so a preempted run can pick up
+//  where it stopped. One checkpoint per scaffold: <dir>/<scafftag>.ckpt holds the
+//  point vectors and ProtocolData after the last finished task, <dir>/<scafftag>.done
+//  marks a scaffold that ran to the end.
+//
+// Files are raw binary for this build only. A checkpoint or done marker written by a
+//  different task list or with different options is ignored.
+struct TaskCheckpoint {
+
+    TaskCheckpoint(
+        std::string const & dir,
+        std::string const & scafftag,
+        double min_interval_seconds,
+        uint64_t options_key
+    );
+
+    // hash of the command line without the checkpoint flags. @flag files are hashed by
+    //  their contents, so editing one invalidates the checkpoints it produced
+    static uint64_t
+    options_key( int argc, char const * const * argv );
+
+    // identifies the task list and options, a checkpoint only resumes the protocol that wrote it
+    uint64_t
+    protocol_key( std::vector<shared_ptr<Task>> const & tasks ) const;
+
+    // false if there is nothing to resume. next_taskno is the first task still to run
+    bool
+    load(
+        uint64_t protocol_key,
+        size_t & next_taskno,
+        TaskType & last_task_type,
+        ThreePointVectors & vectors,
+        ProtocolData & pd
+    ) const;
+
+    // called after every task, only writes if min_interval_seconds passed since the last write
+    bool
+    maybe_save(
+        uint64_t protocol_key,
+        size_t next_taskno,
+        TaskType last_task_type,
+        ThreePointVectors const & vectors,
+        ProtocolData const & pd
+    );
+
+    // the scaffold is finished, keeps its timings so a resumed run can still report totals
+    void
+    mark_done( ProtocolData const & pd );
+
+    bool
+    is_done( ProtocolData & pd ) const;
+
+    std::string const & state_fname() const { return state_fname_; }
+
+private:
+
+    bool
+    save(
+        uint64_t protocol_key,
+        size_t next_taskno,
+        TaskType last_task_type,
+        ThreePointVectors const & vectors,
+        ProtocolData const & pd
+    ) const;
+
+    std::string state_fname_;
+    std::string done_fname_;
+    double min_interval_seconds_;
+    double last_save_;
+    uint64_t options_key_;
+
+};
+
+
+
+}}
+
+#endif
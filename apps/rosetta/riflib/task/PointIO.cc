@@ -0,0 +1,96 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+
+#include <riflib/task/PointIO.hh>
+
+#include <riflib/types.hh>
+
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+namespace point_io {
+
+static void write_rotamers( std::ostream & out, shared_ptr< std::vector< std::pair<intRot,intRot> > > const & rots ) {
+    if ( rots ) write_pod_vector( out, *rots );
+    else write_pod( out, (uint64_t)0 );
+}
+static bool read_rotamers( std::istream & in, shared_ptr< std::vector< std::pair<intRot,intRot> > > & rots ) {
+    std::vector< std::pair<intRot,intRot> > tmp;
+    if ( ! read_pod_vector( in, tmp ) ) return false;
+    rots = tmp.empty() ? nullptr : make_shared< std::vector< std::pair<intRot,intRot> > >( tmp );
+    return true;
+}
+
+void write_points( std::ostream & out, std::vector<SearchPoint> const & points ) {
+    write_pod_vector( out, points );
+}
+bool read_points( std::istream & in, std::vector<SearchPoint> & points ) {
+    return read_pod_vector( in, points );
+}
+
+void write_points( std::ostream & out, std::vector<SearchPointWithRots> const & points ) {
+    write_pod( out, (uint64_t)points.size() );
+    for ( SearchPointWithRots const & p : points ) {
+        write_pod( out, p.score );
+        write_pod( out, p.sasa );
+        write_pod( out, p.prepack_rank );
+        write_pod( out, p.index );
+        write_rotamers( out, p.rotamers_ );
+    }
+}
+bool read_points( std::istream & in, std::vector<SearchPointWithRots> & points ) {
+    uint64_t n;
+    if ( ! read_pod( in, n ) ) return false;
+    points.resize( n );
+    for ( SearchPointWithRots & p : points ) {
+        if ( ! ( read_pod( in, p.score ) && read_pod( in, p.sasa ) && read_pod( in, p.prepack_rank )
+              && read_pod( in, p.index ) && read_rotamers( in, p.rotamers_ ) ) ) return false;
+    }
+    return true;
+}
+
+void write_points( std::ostream & out, std::vector<RifDockResult> const & points ) {
+    write_pod( out, (uint64_t)points.size() );
+    for ( RifDockResult const & p : points ) {
+        write_pod( out, p.dist0 );
+        write_pod( out, p.nopackscore );
+        write_pod( out, p.rifscore );
+        write_pod( out, p.stericscore );
+        write_pod( out, p.score );
+        write_pod( out, p.scaff_bb_hbond );
+        write_pod( out, p.sasa );
+        write_pod( out, p.isamp );
+        write_pod( out, p.index );
+        write_pod( out, p.prepack_rank );
+        write_pod( out, p.cluster_score );
+        write_rotamers( out, p.rotamers_ );
+    }
+}
+bool read_points( std::istream & in, std::vector<RifDockResult> & points ) {
+    uint64_t n;
+    if ( ! read_pod( in, n ) ) return false;
+    points.resize( n );
+    for ( RifDockResult & p : points ) {
+        if ( ! ( read_pod( in, p.dist0 ) && read_pod( in, p.nopackscore ) && read_pod( in, p.rifscore )
+              && read_pod( in, p.stericscore ) && read_pod( in, p.score ) && read_pod( in, p.scaff_bb_hbond )
+              && read_pod( in, p.sasa ) && read_pod( in, p.isamp ) && read_pod( in, p.index )
+              && read_pod( in, p.prepack_rank ) && read_pod( in, p.cluster_score )
+              && read_rotamers( in, p.rotamers_ ) ) ) return false;
+    }
+    return true;
+}
+
+
+
+}
+}}
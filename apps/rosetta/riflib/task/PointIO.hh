@@ -0,0 +1,89 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://wsic_dockosettacommons.org. Questions about this casic_dock
+// (c) addressed to University of Waprotocolsgton UW TechTransfer, email: license@u.washington.eprotocols
+
+#ifndef INCLUDED_riflib_task_PointIO_hh
+#define INCLUDED_riflib_task_PointIO_hh
+
+#include <riflib/types.hh>
+#include <riflib/task/types.hh>
+
+#include <iostream>
+#include <vector>
+
+
+
+namespace devel {
+namespace scheme {
+
+// Raw binary (de)serialization of the protocol point vectors, used for checkpoints and
+//  shard results. Only meant to be read back by the same build. Poses are not stored.
+namespace point_io {
+
+template<class T>
+void write_pod( std::ostream & out, T const & t ) {
+    out.write( (char const*)&t, sizeof(T) );
+}
+template<class T>
+bool read_pod( std::istream & in, T & t ) {
+    return (bool)in.read( (char*)&t, sizeof(T) );
+}
+
+template<class T>
+void write_pod_vector( std::ostream & out, std::vector<T> const & v ) {
+    write_pod( out, (uint64_t)v.size() );
+    if ( v.size() ) out.write( (char const*)v.data(), v.size()*sizeof(T) );
+}
+template<class T>
+bool read_pod_vector( std::istream & in, std::vector<T> & v ) {
+    uint64_t n;
+    if ( ! read_pod( in, n ) ) return false;
+    v.resize( n );
+    return n == 0 || (bool)in.read( (char*)v.data(), n*sizeof(T) );
+}
+
+void write_points( std::ostream & out, std::vector<SearchPoint> const & points );
+bool read_points( std::istream & in, std::vector<SearchPoint> & points );
+
+void write_points( std::ostream & out, std::vector<SearchPointWithRots> const & points );
+bool read_points( std::istream & in, std::vector<SearchPointWithRots> & points );
+
+void write_points( std::ostream & out, std::vector<RifDockResult> const & points );
+bool read_points( std::istream & in, std::vector<RifDockResult> & points );
+
+// a null vector round trips as null
+template<class AnyPoint>
+void write_optional_points( std::ostream & out, shared_ptr<std::vector<AnyPoint>> const & points ) {
+    write_pod( out, (uint8_t)( points ? 1 : 0 ) );
+    if ( points ) write_points( out, *points );
+}
+template<class AnyPoint>
+bool read_optional_points( std::istream & in, shared_ptr<std::vector<AnyPoint>> & points ) {
+    uint8_t present;
+    if ( ! read_pod( in, present ) ) return false;
+    points = nullptr;
+    if ( ! present ) return true;
+    points = make_shared<std::vector<AnyPoint>>();
+    return read_points( in, *points );
+}
+
+// poses live only in memory, points carrying one lose it when written
+template<class AnyPoint>
+bool has_poses( shared_ptr<std::vector<AnyPoint>> const & points ) {
+    if ( ! points ) return false;
+    for ( AnyPoint const & p : *points ) if ( p.pose_ ) return true;
+    return false;
+}
+
+}
+
+
+
+}}
+
+#endif
@@ -52,6 +52,16 @@ struct Task {
 
     std::string name() const;
 
+    // resolution this task works at, for the perf report. -1 if not tied to one
+    virtual int report_resl() const { return -1; }
+
+    // Resuming from a checkpoint skips the tasks that already ran. Tasks that leave
+    //  setup behind in rdd (tables, fa mode) redo it here.
+    virtual void restore_for_resume( RifDockData & rdd, ProtocolData & pd ) {}
+
+    // false if a checkpoint can't capture what this task did, later tasks then don't checkpoint
+    virtual bool checkpointable() const { return true; }
+
 
 };
 
@@ -9,10 +9,13 @@
 
 
 #include <riflib/task/TaskProtocol.hh>
+#include <riflib/task/Checkpoint.hh>
 #include <riflib/task/util.hh>
 
 #include <riflib/types.hh>
+#include <riflib/util.hh>
 
+#include <scheme/util/PerfReport.hh>
 
 #include <string>
 #include <vector>
@@ -46,6 +49,23 @@ TaskProtocol::run( ThreePointVectors input, RifDockData & rdd, ProtocolData & pd
 
     size_t current_taskno = 0;
 
+    uint64_t const checkpoint_key = checkpoint_ ? checkpoint_->protocol_key( tasks_ ) : 0;
+    bool can_checkpoint = (bool)checkpoint_;
+
+    if ( checkpoint_ ) {
+        ThreePointVectors resumed;
+        if ( checkpoint_->load( checkpoint_key, current_taskno, last_task_type, resumed, pd ) ) {
+            std::cout << "Resuming from checkpoint " << checkpoint_->state_fname() << " before task "
+                      << current_taskno << " of " << tasks_.size() << std::endl;
+            working_search_points = resumed.search_points;
+            working_search_point_with_rotss = resumed.search_point_with_rotss;
+            working_rif_dock_results = resumed.rif_dock_results;
+            for ( size_t i = 0; i < current_taskno; i++ ) {
+                tasks_[i]->restore_for_resume( rdd, pd );
+            }
+        }
+    }
+
 
     while ( current_taskno < tasks_.size() ) {
 
@@ -58,16 +78,20 @@ TaskProtocol::run( ThreePointVectors input, RifDockData & rdd, ProtocolData & pd
         std::string name = task.name();
         std::cout << "# ";
 
+        size_t points_in = 0;
         if ( working_search_points ) {
-            std::cout << working_search_points->size();
+            points_in = working_search_points->size();
         } else if ( working_search_point_with_rotss ) {
-            std::cout << working_search_point_with_rotss->size();
+            points_in = working_search_point_with_rotss->size();
         } else if ( working_rif_dock_results ) {
-            std::cout << working_rif_dock_results->size();
+            points_in = working_rif_dock_results->size();
         } else {
             runtime_assert(false);
         }
-        std::cout << " --> " << name << std::endl;
+        std::cout << points_in << " --> " << name << std::endl;
+
+        double const wall_start = ::scheme::util::PerfReport::wall_seconds();
+        double const cpu_start = ::scheme::util::PerfReport::process_cpu_seconds();
         
         // std::cout << "--------------------------------------------" << std::endl;
 
@@ -186,32 +210,49 @@ TaskProtocol::run( ThreePointVectors input, RifDockData & rdd, ProtocolData & pd
         last_task_type = reported_task_type;
         current_taskno++;
 
-        bool no_samples = false;
+        size_t points_out = 0;
 
         switch (last_task_type) {
             case SearchPointTaskType: {
                 runtime_assert(working_search_points);
-                no_samples = working_search_points->size() == 0;
+                points_out = working_search_points->size();
                 break;
             }
             case SearchPointWithRotsTaskType: {
                 runtime_assert(working_search_point_with_rotss);
-                no_samples = working_search_point_with_rotss->size() == 0;
+                points_out = working_search_point_with_rotss->size();
                 break;
             }
             case RifDockResultTaskType: {
                 runtime_assert(working_rif_dock_results);
-                no_samples = working_rif_dock_results->size() == 0;
+                points_out = working_rif_dock_results->size();
                 break;
             }
             default: { runtime_assert(false); }
         }
+        bool no_samples = points_out == 0;
+
+        if ( pd.perf_report ) {
+            ::scheme::util::PerfReport & report = *pd.perf_report;
+            report.add_time( name, task.report_resl(),
+                ::scheme::util::PerfReport::wall_seconds() - wall_start,
+                ::scheme::util::PerfReport::process_cpu_seconds() - cpu_start,
+                ::devel::scheme::omp_max_threads() );
+            report.add_count( name, task.report_resl(), "points_in", points_in );
+            report.add_count( name, task.report_resl(), "points_out", points_out );
+        }
 
         if ( no_samples ) {
             std::cout << "search fail, no valid samples!" << std::endl;
             return ThreePointVectors();
         }
 
+        if ( ! task.checkpointable() ) can_checkpoint = false;
+        if ( can_checkpoint && current_taskno < tasks_.size() ) {
+            ThreePointVectors state { working_search_points, working_search_point_with_rotss, working_rif_dock_results };
+            checkpoint_->maybe_save( checkpoint_key, current_taskno, last_task_type, state, pd );
+        }
+
     }
 
     ThreePointVectors to_return {
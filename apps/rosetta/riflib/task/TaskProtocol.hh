@@ -27,6 +27,8 @@ struct ThreePointVectors {
     shared_ptr<std::vector<RifDockResult>> rif_dock_results;
 };
 
+struct TaskCheckpoint;
+
 struct TaskProtocol {
 
     TaskProtocol( std::vector<shared_ptr<Task>> const & tasks ) :
@@ -37,11 +39,16 @@ struct TaskProtocol {
     ThreePointVectors
     run( ThreePointVectors input, RifDockData & rdd, ProtocolData & pd );
 
+    // resume from this checkpoint if it holds one and save to it between tasks
+    void
+    set_checkpoint( shared_ptr<TaskCheckpoint> const & checkpoint ) { checkpoint_ = checkpoint; }
+
 
 private:
 
 
     std::vector<shared_ptr<Task>> tasks_;
+    shared_ptr<TaskCheckpoint> checkpoint_;
 
 
 
@@ -19,6 +19,8 @@
 
 #include <utility/io/ozstream.hh>
 
+#include <scheme/util/PerfReport.hh>
+
 #ifdef USEGRIDSCORE
 #include <protocols/ligand_docking/GALigandDock/GridScorer.hh>
 #endif
@@ -244,9 +246,20 @@ struct ProtocolData {
 // for hsearch
     double beam_multiplier;
 
+// rif hit masks of the parents of the current hsearch samples, see HSearchResidueHints
+//  parent i covers samples [ i*hsearch_children_per_parent, (i+1)*hsearch_children_per_parent )
+    std::vector<uint64_t> hsearch_parent_hits;
+    int hsearch_parent_hit_words;
+    int hsearch_children_per_parent;
+    int hsearch_parent_hits_resl;
+    uint64_t hsearch_parent_hits_nsamples;
+
 // for seeding positions
     std::vector<std::string> seeding_tags;
 
+// per-task timings and counters, null if no report requested
+    shared_ptr< ::scheme::util::PerfReport > perf_report;
+
 
 
     ProtocolData() :
@@ -257,7 +270,11 @@ struct ProtocolData {
     time_pck(0),
     time_ros(0),
     hsearch_rate(0),
-    beam_multiplier(1)
+    beam_multiplier(1),
+    hsearch_parent_hit_words(0),
+    hsearch_children_per_parent(0),
+    hsearch_parent_hits_resl(-1),
+    hsearch_parent_hits_nsamples(0)
 
 
 
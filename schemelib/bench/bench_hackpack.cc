@@ -0,0 +1,92 @@
+// HackPack annealing throughput on a synthetic interface: a sparse twobody
+// table over the scaffold and ~15 designable positions with a handful of
+// rif rotamers each, about what a good docked hit hands to the packer
+
+#include "bench_util.hh"
+
+#include "scheme/search/HackPack.hh"
+
+using namespace scheme::bench;
+using ::scheme::shared_ptr;
+using ::scheme::make_shared;
+
+typedef ::scheme::objective::storage::TwoBodyTable<float> TwoB;
+
+int main( int argc, char *argv[] ){
+	int const NRES = bench_arg( argc, argv, "nres", 60 );
+	int const NROT = bench_arg( argc, argv, "nrot", 400 );
+	int64_t const NPACK = bench_arg( argc, argv, "npack", 20000 );
+	int const NIFACE = bench_arg( argc, argv, "niface", 15 );
+	int const ROTS_PER_RES = bench_arg( argc, argv, "rots_per_res", 8 );
+	::scheme::util::PerfReport report;
+
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<> runif;
+
+	shared_ptr<TwoB> twob = make_shared<TwoB>( NRES, NROT );
+	for( int ires = 0; ires < NRES; ++ires ){
+		twob->set_onebody( ires, 0, 0.0 ); // ala, always kept
+		for( int irot = 1; irot < NROT; ++irot ) twob->set_onebody( ires, irot, runif(rng)*10.0 - 3.0 );
+	}
+	twob->init_onebody_filter( 5.0 );
+	int nedge = 0;
+	for( int ires = 0; ires < NRES; ++ires ){
+		for( int jres = 0; jres < ires; ++jres ){
+			if( ires-jres > 8 && runif(rng) > 0.15 ) continue; // sparse like a real contact graph
+			twob->init_twobody( ires, jres );
+			++nedge;
+			for( int i = 0; i < twob->nsel_[ires]; ++i ){
+				for( int j = 0; j < twob->nsel_[jres]; ++j ){
+					float e = runif(rng);
+					twob->twobody_[ires][jres][i][j] = e < 0.05 ? 10.0 : e - 0.6;
+				}
+			}
+		}
+	}
+	std::cout << "twobody table nres " << NRES << " nrot " << NROT << " edges " << nedge
+	          << " mem " << twob->twobody_mem_use() << std::endl;
+
+	// random designable positions and rif rotamers for each pack
+	struct Problem { std::vector< std::pair<int,int> > rots; std::vector<float> onebody; };
+	std::vector<Problem> problems( 256 );
+	for( size_t ip = 0; ip < problems.size(); ++ip ){
+		std::vector<int> res;
+		for( int i = 0; i < NRES; ++i ) res.push_back(i);
+		std::shuffle( res.begin(), res.end(), rng );
+		res.resize( NIFACE );
+		std::sort( res.begin(), res.end() );
+		for( int ires : res ){
+			for( int k = 0; k < ROTS_PER_RES; ++k ){
+				int const irot = 1 + rng() % (NROT-1);
+				problems[ip].rots.push_back( std::make_pair( ires, irot ) );
+				problems[ip].onebody.push_back( twob->onebody( ires, irot ) + runif(rng)*-4.0 );
+			}
+		}
+	}
+
+	::scheme::search::HackPackOpts opts;
+	int const nthreads = bench_nthreads();
+	std::vector< shared_ptr< ::scheme::search::HackPack > > packers;
+	for( int i = 0; i < nthreads; ++i ) packers.push_back( make_shared< ::scheme::search::HackPack >( opts, 0, i ) );
+
+	double sum = 0;
+	bench_run( report, "HackPack::pack", "packs", NPACK, [&](){
+		#ifdef USE_OPENMP
+		#pragma omp parallel for schedule(dynamic,16) reduction(+:sum)
+		#endif
+		for( int64_t ipack = 0; ipack < NPACK; ++ipack ){
+			::scheme::search::HackPack & packer = *packers[ bench_thread_num() ];
+			Problem const & prob = problems[ ipack % problems.size() ];
+			packer.reinitialize( twob );
+			for( size_t k = 0; k < prob.rots.size(); ++k ){
+				packer.add_tmp_rot( prob.rots[k].first, prob.rots[k].second, prob.onebody[k] );
+			}
+			std::vector< std::pair<int32_t,int32_t> > result;
+			sum += packer.pack( result );
+		}
+	}, nthreads );
+
+	std::cout << "mean pack score " << sum / NPACK << std::endl;
+	bench_finish( argc, argv, report );
+	return 0;
+}
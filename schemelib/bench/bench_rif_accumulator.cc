@@ -0,0 +1,75 @@
+// rifgen style accumulation: threads hash rotamer placements into private
+// maps which are then condensed into the rif. RIFAccumulatorMapThreaded
+// needs rosetta, this is the same insert / condense logic on schemelib types.
+
+#include "bench_util.hh"
+
+#include <limits>
+
+using namespace scheme::bench;
+
+typedef BenchXMap::Map Map;
+
+int main( int argc, char *argv[] ){
+	int64_t const NSAMP = bench_arg( argc, argv, "n", 10000000 );
+	int const NROT = bench_arg( argc, argv, "nrot", 1000 );
+	float const box = bench_arg( argc, argv, "box", 16.0 );
+	::scheme::util::PerfReport report;
+
+	BenchXMap xmap( 0.5, 16.0 );
+	int const nthreads = bench_nthreads();
+	std::vector< Map > to_insert( nthreads );
+	for( int i = 0; i < nthreads; ++i ) to_insert[i].set_empty_key( std::numeric_limits<uint64_t>::max() );
+
+	// placements are generated up front so only hashing and map work is timed
+	std::mt19937 rng(0);
+	std::vector<EigenXform> positions;
+	rand_positions( rng, std::min<int64_t>( NSAMP, 2000000 ), box, positions );
+	std::vector<int> rots( positions.size() );
+	std::vector<float> scores( positions.size() );
+	std::uniform_real_distribution<> rscore( -5.0, 0.0 );
+	for( size_t i = 0; i < positions.size(); ++i ){
+		rots[i] = rng() % NROT;
+		scores[i] = rscore(rng);
+	}
+
+	bench_run( report, "accumulator_insert", "inserts", NSAMP, [&](){
+		#ifdef USE_OPENMP
+		#pragma omp parallel for schedule(static)
+		#endif
+		for( int64_t i = 0; i < NSAMP; ++i ){
+			size_t const j = i % positions.size();
+			uint64_t const key = xmap.hasher_.get_key( positions[j] );
+			Map & map_for_this_thread( to_insert[ bench_thread_num() ] );
+			Map::iterator iter = map_for_this_thread.find( key );
+			if( iter == map_for_this_thread.end() ){
+				BenchRifValue value;
+				value.add_rotamer( rots[j], scores[j] );
+				map_for_this_thread.insert( std::make_pair( key, value ) );
+			} else {
+				iter->second.add_rotamer( rots[j], scores[j] );
+			}
+		}
+	}, nthreads );
+
+	int64_t nscratch = 0;
+	for( int i = 0; i < nthreads; ++i ) nscratch += to_insert[i].size();
+	std::cout << "scratch map entries " << nscratch << std::endl;
+
+	bench_run( report, "accumulator_condense", "entries", nscratch, [&](){
+		for( int i = 0; i < nthreads; ++i ){
+			for( Map::const_iterator i_to = to_insert[i].begin(); i_to != to_insert[i].end(); ++i_to ){
+				Map::iterator iter = xmap.map_.find( i_to->first );
+				if( iter == xmap.map_.end() ){
+					xmap.map_.insert( *i_to );
+				} else {
+					iter->second.merge( i_to->second );
+				}
+			}
+		}
+	});
+
+	std::cout << "rif cells " << xmap.size() << " mem " << xmap.mem_use() << std::endl;
+	bench_finish( argc, argv, report );
+	return 0;
+}
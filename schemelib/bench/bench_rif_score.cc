@@ -0,0 +1,69 @@
+// rif scoring of whole docked scaffolds, the ScoreBBActorVsRIF inner loop:
+// place every scaffold backbone frame, look it up in the rif and keep the
+// best rotamer score + onebody energy per residue. ScoreBBActorVsRIF itself
+// needs rosetta, so this mirrors its non-packing path with schemelib types.
+
+#include "bench_util.hh"
+
+using namespace scheme::bench;
+
+int main( int argc, char *argv[] ){
+	int64_t const NCELL = bench_arg( argc, argv, "ncell", 2000000 );
+	int64_t const NPOSE = bench_arg( argc, argv, "npose", 200000 );
+	int const NRES = bench_arg( argc, argv, "nres", 60 );
+	int const NROT = bench_arg( argc, argv, "nrot", 1000 );
+	::scheme::util::PerfReport report;
+
+	std::mt19937 rng(0);
+
+	// scaffold backbone frames within a ~20A blob
+	std::vector<EigenXform> bb_frames;
+	rand_positions( rng, NRES, 20.0, bb_frames );
+
+	// the rif is populated where scaffolds tend to land so a reasonable fraction of lookups hit
+	std::vector<EigenXform> docked( NPOSE );
+	for( int64_t i = 0; i < NPOSE; ++i ) ::scheme::numeric::rand_xform( rng, docked[i], (float)8.0 );
+	std::vector<EigenXform> stored;
+	stored.reserve( NCELL );
+	std::uniform_int_distribution<> rpose( 0, NPOSE-1 ), rres( 0, NRES-1 );
+	while( stored.size() < NCELL ) stored.push_back( docked[rpose(rng)] * bb_frames[rres(rng)] );
+	BenchXMap xmap( 0.5, 16.0 );
+	fill_rif( rng, xmap, stored, 6, NROT );
+	std::cout << "rif cells " << xmap.size() << " mem " << xmap.mem_use() << std::endl;
+
+	std::vector< std::vector<float> > onebody( NRES, std::vector<float>( NROT ) );
+	std::uniform_real_distribution<> r1b( -2.0, 4.0 );
+	for( int i = 0; i < NRES; ++i ) for( int j = 0; j < NROT; ++j ) onebody[i][j] = r1b(rng);
+
+	BenchXMap const & rif( xmap );
+	std::vector<float> scores( NPOSE );
+	int const nthreads = bench_nthreads();
+	int64_t nhit = 0;
+	bench_run( report, "rif_score_scaffold", "residue_lookups", NPOSE*NRES, [&](){
+		#ifdef USE_OPENMP
+		#pragma omp parallel for schedule(dynamic,64) reduction(+:nhit)
+		#endif
+		for( int64_t ipose = 0; ipose < NPOSE; ++ipose ){
+			float score = 0;
+			for( int ires = 0; ires < NRES; ++ires ){
+				EigenXform const bbpos = docked[ipose] * bb_frames[ires];
+				BenchRifValue const & rotscores = rif[ bbpos ];
+				float bestsc = 0.0;
+				for( int i_rs = 0; i_rs < BenchRifValue::N; ++i_rs ){
+					if( rotscores.empty(i_rs) ) break;
+					float const sc = rotscores.score(i_rs) + onebody[ires][ rotscores.rotamer(i_rs) ];
+					bestsc = std::min( bestsc, sc );
+				}
+				nhit += ! rotscores.empty(0);
+				score += bestsc;
+			}
+			scores[ipose] = score;
+		}
+	}, nthreads );
+	report.add_count( "rif_score_scaffold", -1, "poses", NPOSE );
+	std::cout << "BENCH rif_score_scaffold: " << NPOSE / report.stage("rif_score_scaffold").wall_sec << " poses/sec" << std::endl;
+
+	std::cout << "rif hit fraction " << (double)nhit / NPOSE / NRES << std::endl;
+	bench_finish( argc, argv, report );
+	return 0;
+}
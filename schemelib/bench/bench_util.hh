@@ -0,0 +1,138 @@
+#ifndef INCLUDED_scheme_bench_bench_util_HH
+#define INCLUDED_scheme_bench_bench_util_HH
+
+#include "scheme/objective/hash/XformMap.hh"
+#include "scheme/objective/storage/RotamerScores.hh"
+#include "scheme/numeric/rand_xform.hh"
+#include "scheme/util/PerfReport.hh"
+
+#include <Eigen/Geometry>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace scheme {
+namespace bench {
+
+// same types rifdock uses for the default "RotScore" rif
+typedef Eigen::Transform<float,3,Eigen::AffineCompact> EigenXform;
+typedef ::scheme::objective::storage::RotamerScore<> BenchRotScore;
+typedef ::scheme::objective::storage::RotamerScores< 12, BenchRotScore > BenchRifValue;
+typedef ::scheme::objective::hash::XformMap<
+		EigenXform,
+		BenchRifValue,
+		::scheme::objective::hash::XformHash_bt24_BCC6
+	> BenchXMap;
+
+inline int bench_nthreads(){
+	#ifdef USE_OPENMP
+		return omp_get_max_threads();
+	#else
+		return 1;
+	#endif
+}
+
+inline int bench_thread_num(){
+	#ifdef USE_OPENMP
+		return omp_get_thread_num();
+	#else
+		return 0;
+	#endif
+}
+
+/// @brief "-name value" from the command line, or default
+inline double bench_arg( int argc, char *argv[], std::string const & name, double dflt ){
+	for( int i = 1; i+1 < argc; ++i ){
+		if( std::string(argv[i]) == "-"+name ) return std::atof( argv[i+1] );
+	}
+	return dflt;
+}
+
+inline std::string bench_arg_str( int argc, char *argv[], std::string const & name, std::string const & dflt ){
+	for( int i = 1; i+1 < argc; ++i ){
+		if( std::string(argv[i]) == "-"+name ) return argv[i+1];
+	}
+	return dflt;
+}
+
+/// @brief print one throughput line and record it in the report
+inline void bench_report(
+	::scheme::util::PerfReport & report,
+	std::string const & name,
+	std::string const & what,
+	int64_t n,
+	double wall_sec,
+	double cpu_sec,
+	int nthreads = 1
+){
+	report.add_time( name, -1, wall_sec, cpu_sec, nthreads );
+	report.add_count( name, -1, what, n );
+	std::cout << "BENCH " << name << ": " << n << " " << what << " in " << wall_sec << "s, "
+	          << n / wall_sec << " " << what << "/sec";
+	if( nthreads > 1 ) std::cout << ", " << n / wall_sec / nthreads << " " << what << "/sec/thread";
+	std::cout << std::endl;
+}
+
+/// @brief runs fun() and reports n/time
+template< class F >
+void bench_run(
+	::scheme::util::PerfReport & report,
+	std::string const & name,
+	std::string const & what,
+	int64_t n,
+	F fun,
+	int nthreads = 1
+){
+	double const wall0 = ::scheme::util::PerfReport::wall_seconds();
+	double const cpu0 = ::scheme::util::PerfReport::process_cpu_seconds();
+	fun();
+	bench_report( report, name, what, n,
+		::scheme::util::PerfReport::wall_seconds() - wall0,
+		::scheme::util::PerfReport::process_cpu_seconds() - cpu0, nthreads );
+}
+
+/// @brief write the report if -report was given
+inline void bench_finish( int argc, char *argv[], ::scheme::util::PerfReport const & report ){
+	std::string fname = bench_arg_str( argc, argv, "report", "" );
+	if( fname.size() ){
+		if( report.write( fname ) ) std::cout << "wrote " << fname << std::endl;
+		else std::cout << "could not write " << fname << std::endl;
+	}
+}
+
+/// @brief synthetic docking-like positions: clustered around the origin like
+///        scaffold residues near a target, cart_bound is the box width
+template< class RNG >
+void rand_positions( RNG & rng, int64_t n, float cart_bound, std::vector<EigenXform> & out ){
+	out.resize( n );
+	for( int64_t i = 0; i < n; ++i ){
+		::scheme::numeric::rand_xform( rng, out[i], cart_bound );
+	}
+}
+
+/// @brief a rif filled with nrot random rotamers per cell over positions
+template< class RNG >
+void fill_rif( RNG & rng, BenchXMap & xmap, std::vector<EigenXform> const & positions, int rots_per_cell, int nrot ){
+	std::uniform_int_distribution<> rrot( 0, nrot-1 );
+	std::uniform_real_distribution<> rscore( -6.0, -0.5 );
+	for( size_t i = 0; i < positions.size(); ++i ){
+		BenchRifValue val;
+		for( int j = 0; j < rots_per_cell; ++j ){
+			val.add_rotamer( rrot(rng), rscore(rng) );
+		}
+		xmap.insert( positions[i], val );
+	}
+}
+
+}
+}
+
+#endif
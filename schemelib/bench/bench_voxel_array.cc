@@ -0,0 +1,49 @@
+// VoxelArray lookups as used for the target vdw / bounding grids
+
+#include "bench_util.hh"
+
+#include "scheme/objective/voxel/VoxelArray.hh"
+
+using namespace scheme::bench;
+
+typedef ::scheme::objective::voxel::VoxelArray<3,float> VoxelArray;
+
+int main( int argc, char *argv[] ){
+	int64_t const NQUERY = bench_arg( argc, argv, "n", 20000000 );
+	float const resl = bench_arg( argc, argv, "resl", 0.25 );
+	float const width = bench_arg( argc, argv, "width", 40.0 );
+	::scheme::util::PerfReport report;
+
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<> runif;
+
+	VoxelArray::Bounds lb, ub, cs;
+	lb.fill( -width/2 );
+	ub.fill( width/2 );
+	cs.fill( resl );
+	VoxelArray grid( lb, ub, cs );
+	for( size_t i = 0; i < grid.num_elements(); ++i ) grid.data()[i] = runif(rng);
+	std::cout << "grid " << grid << std::endl;
+
+	// atoms spread a bit past the grid, like scaffold atoms near the target
+	std::vector<Eigen::Vector3f> points( 1000000 );
+	for( size_t i = 0; i < points.size(); ++i ){
+		for( int k = 0; k < 3; ++k ) points[i][k] = ( runif(rng) - 0.5 ) * width * 1.2;
+	}
+
+	float sum = 0;
+	bench_run( report, "VoxelArray::at", "lookups", NQUERY, [&](){
+		for( int64_t i = 0; i < NQUERY; ++i ) sum += grid.at( points[ i % points.size() ] );
+	});
+	int const nthreads = bench_nthreads();
+	bench_run( report, "VoxelArray::at_threaded", "lookups", NQUERY, [&](){
+		#ifdef USE_OPENMP
+		#pragma omp parallel for schedule(static) reduction(+:sum)
+		#endif
+		for( int64_t i = 0; i < NQUERY; ++i ) sum += grid.at( points[ i % points.size() ] );
+	}, nthreads );
+
+	std::cout << "(ignore) " << sum << std::endl;
+	bench_finish( argc, argv, report );
+	return 0;
+}
@@ -0,0 +1,45 @@
+// XformHash key computation throughput, the first step of every rif lookup
+
+#include "bench_util.hh"
+
+#include "scheme/objective/hash/XformHash.hh"
+
+using namespace scheme::bench;
+
+int main( int argc, char *argv[] ){
+	int64_t const NSAMP = bench_arg( argc, argv, "n", 2000000 );
+	float const cart_resl = bench_arg( argc, argv, "cart_resl", 0.5 );
+	float const ang_resl = bench_arg( argc, argv, "ang_resl", 16.0 );
+	::scheme::util::PerfReport report;
+
+	std::mt19937 rng(0);
+	std::vector<EigenXform> positions;
+	rand_positions( rng, NSAMP, 32.0, positions );
+
+	::scheme::objective::hash::XformHash_bt24_BCC6<EigenXform> hasher( cart_resl, ang_resl, 512.0 );
+
+	uint64_t sum = 0;
+	bench_run( report, "XformHash_bt24_BCC6::get_key", "keys", NSAMP, [&](){
+		for( int64_t i = 0; i < NSAMP; ++i ) sum ^= hasher.get_key( positions[i] );
+	});
+
+	uint64_t sum2 = 0;
+	int const nthreads = bench_nthreads();
+	bench_run( report, "XformHash_bt24_BCC6::get_key_threaded", "keys", NSAMP, [&](){
+		#ifdef USE_OPENMP
+		#pragma omp parallel for schedule(static) reduction(^:sum2)
+		#endif
+		for( int64_t i = 0; i < NSAMP; ++i ) sum2 ^= hasher.get_key( positions[i] );
+	}, nthreads );
+
+	std::vector<uint64_t> keys( 100000 );
+	for( size_t i = 0; i < keys.size(); ++i ) keys[i] = hasher.get_key( positions[i] );
+	float fsum = 0;
+	bench_run( report, "XformHash_bt24_BCC6::get_center", "centers", keys.size(), [&](){
+		for( size_t i = 0; i < keys.size(); ++i ) fsum += hasher.get_center( keys[i] ).translation()[0];
+	});
+
+	std::cout << "(ignore) " << ( sum ^ sum2 ) << " " << fsum << std::endl;
+	bench_finish( argc, argv, report );
+	return 0;
+}
@@ -0,0 +1,57 @@
+// XformMap lookup throughput with a realistic hit / miss mix
+
+#include "bench_util.hh"
+
+using namespace scheme::bench;
+
+int main( int argc, char *argv[] ){
+	int64_t const NCELL = bench_arg( argc, argv, "ncell", 2000000 );
+	int64_t const NQUERY = bench_arg( argc, argv, "nquery", 4000000 );
+	float const hit_frac = bench_arg( argc, argv, "hit_frac", 0.1 );
+	float const filter_bits = bench_arg( argc, argv, "filter_bits", 0 );
+	::scheme::util::PerfReport report;
+
+	std::mt19937 rng(0);
+	std::vector<EigenXform> stored, queries;
+	rand_positions( rng, NCELL, 32.0, stored );
+
+	BenchXMap xmap( 0.5, 16.0 );
+	bench_run( report, "XformMap::insert", "inserts", NCELL, [&](){
+		fill_rif( rng, xmap, stored, 4, 1000 );
+	});
+	std::cout << "XformMap size " << xmap.size() << " mem " << xmap.mem_use() << std::endl;
+	if( filter_bits > 0 ){
+		xmap.build_occupancy_filter( filter_bits );
+		std::cout << "occupancy filter mem " << xmap.mem_use() << std::endl;
+	}
+
+	// mix of queries that hit a stored cell and random ones, which mostly miss
+	std::uniform_real_distribution<> runif;
+	queries.resize( NQUERY );
+	for( int64_t i = 0; i < NQUERY; ++i ){
+		if( runif(rng) < hit_frac ) queries[i] = stored[ i % NCELL ];
+		else ::scheme::numeric::rand_xform( rng, queries[i], (float)64.0 );
+	}
+	std::vector<uint64_t> keys( NQUERY );
+	for( int64_t i = 0; i < NQUERY; ++i ) keys[i] = xmap.get_key( queries[i] );
+
+	BenchXMap const & cxmap( xmap );
+	int64_t nhit = 0;
+	bench_run( report, "XformMap::operator[](Key)", "lookups", NQUERY, [&](){
+		for( int64_t i = 0; i < NQUERY; ++i ) nhit += ! cxmap[ keys[i] ].empty(0);
+	});
+	bench_run( report, "XformMap::operator[](Xform)", "lookups", NQUERY, [&](){
+		for( int64_t i = 0; i < NQUERY; ++i ) nhit += ! cxmap[ queries[i] ].empty(0);
+	});
+	int const nthreads = bench_nthreads();
+	bench_run( report, "XformMap::operator[](Xform)_threaded", "lookups", NQUERY, [&](){
+		#ifdef USE_OPENMP
+		#pragma omp parallel for schedule(static) reduction(+:nhit)
+		#endif
+		for( int64_t i = 0; i < NQUERY; ++i ) nhit += ! cxmap[ queries[i] ].empty(0);
+	}, nthreads );
+
+	std::cout << "hit fraction " << (double)nhit / NQUERY / 3.0 << std::endl;
+	bench_finish( argc, argv, report );
+	return 0;
+}
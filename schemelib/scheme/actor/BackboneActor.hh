@@ -2,6 +2,7 @@
 #define INCLUDED_actor_BackboneActor_HH
 
 #include <Eigen/Dense>
+#include <boost/mpl/bool.hpp>
 #include <scheme/io/dump_pdb_atom.hh>
 
 #include <core/conformation/Residue.hh>
@@ -21,6 +22,8 @@ namespace actor {
 		typedef typename Position::Scalar Float;
 		typedef BackboneActor<Position> THIS;
 		typedef Eigen::Matrix<Float,3,1> V3;
+		///@brief Scene moves all of a body's backbone frames in one FrameBatch
+		typedef boost::mpl::true_ BatchFrames;
 
 		Position position_;
 		char aa_,ss_;
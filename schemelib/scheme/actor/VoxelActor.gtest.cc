@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "scheme/actor/VoxelActor.hh"
+#include "scheme/actor/Atom.hh"
+#include "scheme/kinematics/Scene.hh"
+#include "scheme/objective/ObjectiveFunction.hh"
+
+#include <Eigen/Geometry>
+#include <random>
+
+namespace scheme { namespace actor { namespace test_voxel_actor {
+
+typedef Eigen::Transform<float,3,Eigen::AffineCompact> Xform;
+typedef VoxelActor<Xform,float> VA;
+typedef SimpleAtom<Eigen::Vector3f> Atom;
+typedef util::SimpleArray<3,float> F3;
+
+// the Scene's batched visit must give what scoring each moved atom alone does
+TEST( Score_Voxel_vs_Atom, batch_matches_per_atom ){
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float> val(-1,3), coord(-8,8);
+
+	int const NTYPE = N_ATYPE+3;
+	std::vector< VA::VoxelArray > grids( NTYPE, VA::VoxelArray( F3(-6,-6,-6), F3(6,6,6), 0.7 ) );
+	VA::Voxels voxels(1);
+	for( auto & g : grids ){
+		for( size_t i = 0; i < g.num_elements(); ++i ) g.data()[i] = val(rng);
+		voxels[0].push_back( &g );
+	}
+
+	typedef kinematics::Scene< kinematics::impl::Conformation< boost::mpl::vector<VA,Atom> >, Xform > Scene;
+	Scene scene(2);
+	scene.add_actor( 0, VA(voxels) );
+	std::vector<Atom> atoms;
+	for( int i = 0; i < 700; ++i ){
+		atoms.push_back( Atom( Eigen::Vector3f( coord(rng), coord(rng), coord(rng) ), rng()%NTYPE ) );
+		scene.add_actor( 1, atoms.back() );
+	}
+	Xform x( Eigen::AngleAxisf( 0.7, Eigen::Vector3f(1,2,3).normalized() ) );
+	x.translation() = Eigen::Vector3f(1,-2,0.5);
+	scene.set_position( 1, x );
+
+	typedef Score_Voxel_vs_Atom<VA,Atom> Score;
+	Score score;
+	VA const & va = scene.get_actor<VA>(0,0);
+	float ref = 0;
+	for( Atom const & a : atoms ) ref += score( va, Atom(a,x), 0 );
+
+	typedef objective::ObjectiveFunction< boost::mpl::vector<Score>, int > ObjFun;
+	ObjFun objfun;
+	ASSERT_NEAR( objfun( scene, 0 ).sum(), ref, 1e-3*std::abs(ref) );
+
+	// the cutoff only rejects bodies that can't come in under it
+	objfun.get_objective<Score>().clash_cutoff_ = ref + 1;
+	ASSERT_NEAR( objfun( scene, 0 ).sum(), ref, 1e-3*std::abs(ref) );
+	objfun.get_objective<Score>().clash_cutoff_ = ref - 1;
+	ASSERT_EQ( objfun( scene, 0 ).sum(), Score::rejected_score() );
+}
+
+}}}
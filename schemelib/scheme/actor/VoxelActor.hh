@@ -3,6 +3,11 @@
 
 #include "scheme/objective/voxel/VoxelArray.hh"
 
+#include <boost/mpl/bool.hpp>
+
+#include <algorithm>
+#include <limits>
+
 namespace scheme {
 namespace actor {
 
@@ -23,10 +28,19 @@ const int N_ATYPE = 21;
 
 		// Position position_;
 		Voxels voxels_;
+		std::vector<Float> min_value_; // lowest value over all atom types, per config
 
 		VoxelActor() {}
 
-		VoxelActor( Voxels const & v ) :  voxels_(v) {}
+		VoxelActor( Voxels const & v ) :  voxels_(v) {
+			for( size_t c = 0; c < voxels_.size(); ++c ){
+				Float lo = 0;
+				for( VoxelArray const * va : voxels_[c] ){
+					if( va && va->num_elements() ) lo = std::min( lo, *std::min_element( va->data(), va->data()+va->num_elements() ) );
+				}
+				min_value_.push_back( lo );
+			}
+		}
 
 		// VoxelActor( Position const & p, Voxels const * v ) :  voxels_(v) {}
 
@@ -48,6 +62,10 @@ const int N_ATYPE = 21;
 
 		Voxels const & voxels() const { return voxels_; }
 
+		///@brief no atom can score below this at config c; -max() for an unknown config, so
+		///       any bound built from it is never tight enough to reject anything
+		Float min_value( size_t c ) const { return c < min_value_.size() ? min_value_[c] : -std::numeric_limits<Float>::max(); }
+
 		// bool operator==(THIS const & o) const { return o.position_==position_ && o.voxels_==voxels_; }
 
 		// ///@brief necessary for testing only
@@ -79,7 +97,16 @@ template< class VoxelActor, class Atom, bool REPL_ONLY = false >
 struct Score_Voxel_vs_Atom {
 	typedef float Result;
 	typedef std::pair<VoxelActor,Atom> Interaction;
+	typedef boost::mpl::true_ BatchPairs;
+	static int const BATCH_CHUNK = 256;
+	static int const BATCH_MAX_ATYPES = 64;
+
+	///@brief batch() gives up on a body pair once its clash can no longer come in under
+	///       this and returns rejected_score() instead
+	float clash_cutoff_ = std::numeric_limits<float>::max();
+
 	static std::string name(){ return "Score_Voxel_vs_Atom"; }
+	static float rejected_score(){ return 9e9; }
 	template<class Config>
 	Result operator()( VoxelActor const & v, Atom const & a, Config const& c ) const {
 		// std::cout << "score voxel vs atom " << a.data().atomname << std::endl;
@@ -97,6 +124,64 @@ struct Score_Voxel_vs_Atom {
 	Result operator()(Pair const & p, Config const& c) const {
 		return this->operator()(p.first,p.second,c);
 	}
+
+	///@brief every atom in atoms moved by rel_pos against every VoxelActor in voxel_actors
+	///@detail atoms are moved a chunk at a time into x/y/z arrays, bucketed by atom type and
+	///        each bucket summed by VoxelArray::sum_at. after each chunk the running sum plus
+	///        the lowest score the remaining atoms could get is checked against clash_cutoff_
+	template<class VoxelActors, class Atoms, class Position, class Config>
+	Result batch( VoxelActors const & voxel_actors, Atoms const & atoms, Position const & rel_pos, Config const & c ) const {
+		typedef typename VoxelActor::Float Float;
+		Float const r00 = rel_pos.linear()(0,0), r01 = rel_pos.linear()(0,1), r02 = rel_pos.linear()(0,2);
+		Float const r10 = rel_pos.linear()(1,0), r11 = rel_pos.linear()(1,1), r12 = rel_pos.linear()(1,2);
+		Float const r20 = rel_pos.linear()(2,0), r21 = rel_pos.linear()(2,1), r22 = rel_pos.linear()(2,2);
+		Float const t0 = rel_pos.translation()[0], t1 = rel_pos.translation()[1], t2 = rel_pos.translation()[2];
+		Float x[BATCH_CHUNK], y[BATCH_CHUNK], z[BATCH_CHUNK];
+		int type[BATCH_CHUNK], start[BATCH_MAX_ATYPES+1];
+		size_t const natoms = atoms.size();
+
+		bool const use_cutoff = clash_cutoff_ < std::numeric_limits<float>::max();
+		Float rest = 0; // lowest possible score of everything not yet summed
+		if( use_cutoff && !REPL_ONLY ){
+			for( auto const & v : voxel_actors ) rest += std::min( (Float)0, v.min_value(c) ) * natoms;
+		}
+
+		Result score = 0;
+		for( auto const & v : voxel_actors ){
+			auto const & grids = v.voxels()[c];
+			int const ntypes = grids.size();
+			Float const lowest = REPL_ONLY ? 0 : std::min( (Float)0, v.min_value(c) );
+			if( ntypes > BATCH_MAX_ATYPES ){
+				for( size_t j = 0; j < natoms; ++j ) score += this->operator()( v, Atom( atoms[j], rel_pos ), c );
+				rest -= lowest * natoms;
+				continue;
+			}
+			for( size_t beg = 0; beg < natoms; beg += BATCH_CHUNK ){
+				int const n = std::min<size_t>( BATCH_CHUNK, natoms-beg );
+				std::fill( start, start+ntypes+1, 0 );
+				for( int i = 0; i < n; ++i ){
+					type[i] = atoms[beg+i].type();
+					assert( type[i] < ntypes );
+					++start[ type[i]+1 ];
+				}
+				for( int t = 0; t < ntypes; ++t ) start[t+1] += start[t];
+				for( int i = 0; i < n; ++i ){
+					auto const & p = atoms[beg+i].position();
+					int const k = start[ type[i] ]++;
+					x[k] = r00*p[0] + r01*p[1] + r02*p[2] + t0;
+					y[k] = r10*p[0] + r11*p[1] + r12*p[2] + t1;
+					z[k] = r20*p[0] + r21*p[1] + r22*p[2] + t2;
+				}
+				// start[t] is now the end of bucket t
+				for( int t = 0, b = 0; t < ntypes; b = start[t++] ){
+					if( start[t] > b ) score += grids[t]->sum_at( x+b, y+b, z+b, start[t]-b, REPL_ONLY || t > N_ATYPE );
+				}
+				rest -= lowest * n;
+				if( use_cutoff && score + rest > clash_cutoff_ ) return rejected_score();
+			}
+		}
+		return score;
+	}
 };
 template< class A, class B >
 std::ostream & operator<<( std::ostream & out, Score_Voxel_vs_Atom<A,B> const& si ){ return out << si.name(); }
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "scheme/io/BulkArrayFile.hh"
+
+#include <cstdio>
+#include <random>
+
+namespace scheme {
+namespace io {
+namespace bulk_array_test {
+
+using std::cout;
+using std::endl;
+
+struct TestRec {
+	float x, y, z, score;
+	int16_t a, b;
+	bool operator==( TestRec const & o ) const { return x==o.x && y==o.y && z==o.z && score==o.score && a==o.a && b==o.b; }
+};
+
+static std::vector<TestRec> make_recs( size_t n ){
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float> runif;
+	std::vector<TestRec> recs( n );
+	for( size_t i = 0; i < n; ++i ){
+		recs[i].x = runif(rng); recs[i].y = runif(rng); recs[i].z = runif(rng); recs[i].score = -runif(rng);
+		recs[i].a = i%100; recs[i].b = i%7;
+	}
+	return recs;
+}
+
+TEST( BulkArrayFile, round_trip_read_and_mmap ){
+	std::string fname = "_BulkArrayFile_test.bin";
+	std::vector<TestRec> recs = make_recs( 300000 ); // > 1 checksum chunk
+	ASSERT_TRUE( write_bulk_array( fname, recs.data(), recs.size(), 7 ) );
+
+	std::vector<TestRec> a, b;
+	ASSERT_TRUE( read_bulk_array<TestRec>( fname, a, 7, false ) );
+	ASSERT_TRUE( read_bulk_array<TestRec>( fname, b, 7, true ) );
+	ASSERT_TRUE( a == recs );
+	ASSERT_TRUE( b == recs );
+
+	MappedBulkArray<TestRec> mapped;
+	ASSERT_TRUE( mapped.open( fname, 7 ) );
+	ASSERT_EQ( mapped.size(), recs.size() );
+	ASSERT_TRUE( mapped[12345] == recs[12345] );
+
+	// wrong tag or wrong element type is rejected
+	ASSERT_FALSE( read_bulk_array<TestRec>( fname, a, 8 ) );
+	ASSERT_TRUE( a.empty() );
+	std::vector<float> f;
+	ASSERT_FALSE( read_bulk_array<float>( fname, f, 7 ) );
+
+	std::remove( fname.c_str() );
+}
+
+TEST( BulkArrayFile, detects_corruption_and_truncation ){
+	std::string fname = "_BulkArrayFile_corrupt.bin";
+	std::vector<TestRec> recs = make_recs( 1000 ), out;
+	ASSERT_TRUE( write_bulk_array( fname, recs.data(), recs.size() ) );
+	{
+		std::fstream f( fname.c_str(), std::ios::binary | std::ios::in | std::ios::out );
+		f.seekp( sizeof(BulkArrayHeader) + 500 );
+		char c = 0x5a;
+		f.write( &c, 1 );
+	}
+	ASSERT_FALSE( read_bulk_array<TestRec>( fname, out, 0, false ) );
+	ASSERT_FALSE( read_bulk_array<TestRec>( fname, out, 0, true ) );
+	ASSERT_TRUE( read_bulk_array<TestRec>( fname, out, 0, true, false ) ); // verify off
+
+	ASSERT_TRUE( write_bulk_array( fname, recs.data(), recs.size() ) );
+	ASSERT_EQ( truncate( fname.c_str(), sizeof(BulkArrayHeader) + 100 ), 0 );
+	ASSERT_FALSE( read_bulk_array<TestRec>( fname, out ) );
+	ASSERT_FALSE( read_bulk_array<TestRec>( fname, out, 0, false ) );
+
+	ASSERT_FALSE( read_bulk_array<TestRec>( "_BulkArrayFile_missing.bin", out ) );
+	std::remove( fname.c_str() );
+}
+
+TEST( BulkArrayFile, empty_array ){
+	std::string fname = "_BulkArrayFile_empty.bin";
+	std::vector<TestRec> recs, out( 3 );
+	ASSERT_TRUE( write_bulk_array( fname, recs.data(), 0 ) );
+	ASSERT_TRUE( read_bulk_array<TestRec>( fname, out, 0, false ) );
+	ASSERT_TRUE( out.empty() );
+	std::remove( fname.c_str() );
+}
+
+}
+}
+}
@@ -0,0 +1,241 @@
+#ifndef INCLUDED_io_BulkArrayFile_HH
+#define INCLUDED_io_BulkArrayFile_HH
+
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace scheme { namespace io {
+
+/// @brief flat binary file holding one array of trivially copyable elements
+/// @detail layout is a fixed 64 byte header followed by the raw element bytes.
+///         the header records element size and count, a caller supplied tag
+///         (typically a version of whatever generated the data) and a checksum
+///         of the payload, so stale or truncated files are detected instead of
+///         being silently misread. no compression, so a load is one read() or
+///         one mmap, and the payload can be copied / verified in parallel
+struct BulkArrayHeader {
+	static uint32_t const VERSION = 1;
+	char magic[8];
+	uint32_t version;
+	uint32_t elem_size;
+	uint64_t count;
+	uint64_t tag;
+	uint64_t checksum;
+	char pad[24];
+
+	BulkArrayHeader() : version(VERSION), elem_size(0), count(0), tag(0), checksum(0) {
+		std::memcpy( magic, "SCHMBULK", 8 );
+		std::memset( pad, 0, sizeof(pad) );
+	}
+	bool magic_ok() const { return std::memcmp( magic, "SCHMBULK", 8 ) == 0; }
+	uint64_t payload_bytes() const { return count * elem_size; }
+};
+static_assert( sizeof(BulkArrayHeader) == 64, "BulkArrayHeader must be 64 bytes" );
+
+namespace bulk_array_impl {
+
+	// checksum is defined over fixed size chunks so it doesn't depend on thread count
+	static size_t const CHUNK = 1<<20;
+
+	inline uint64_t mix( uint64_t k ){
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdllu;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53llu;
+		k ^= k >> 33;
+		return k;
+	}
+
+	inline uint64_t chunk_checksum( unsigned char const * p, size_t nbytes, uint64_t seed ){
+		uint64_t h = mix( seed + nbytes );
+		size_t i = 0;
+		for( ; i + 8 <= nbytes; i += 8 ){
+			uint64_t w;
+			std::memcpy( &w, p+i, 8 );
+			h = ( h ^ mix(w) ) * 0x9e3779b97f4a7c15llu;
+		}
+		uint64_t w = 0;
+		if( i < nbytes ) std::memcpy( &w, p+i, nbytes-i );
+		return mix( h ^ w );
+	}
+
+	/// @brief copy src to dst (if dst non-null) and return checksum of src, chunks in parallel
+	inline uint64_t copy_and_checksum( void * dst, void const * src, size_t nbytes, bool do_checksum ){
+		unsigned char const * s = (unsigned char const *)src;
+		unsigned char * d = (unsigned char *)dst;
+		int64_t const nchunk = ( nbytes + CHUNK - 1 ) / CHUNK;
+		std::vector<uint64_t> sums( nchunk, 0 );
+		#ifdef USE_OPENMP
+		#pragma omp parallel for schedule(static)
+		#endif
+		for( int64_t ic = 0; ic < nchunk; ++ic ){
+			size_t const beg = ic*CHUNK;
+			size_t const n = std::min( CHUNK, nbytes-beg );
+			if( d ) std::memcpy( d+beg, s+beg, n );
+			if( do_checksum ) sums[ic] = chunk_checksum( s+beg, n, ic );
+		}
+		uint64_t h = mix( nbytes );
+		for( int64_t ic = 0; ic < nchunk; ++ic ) h = mix( h ^ sums[ic] ) + ic;
+		return do_checksum ? h : 0;
+	}
+
+	inline bool read_header( std::string const & fname, BulkArrayHeader & header ){
+		std::ifstream in( fname.c_str(), std::ios::binary );
+		if( !in.good() ) return false;
+		in.read( (char*)&header, sizeof(BulkArrayHeader) );
+		return in.good() && header.magic_ok();
+	}
+
+	inline int64_t file_size( std::string const & fname ){
+		struct stat st;
+		if( stat( fname.c_str(), &st ) != 0 ) return -1;
+		return st.st_size;
+	}
+
+}
+
+inline uint64_t bulk_array_checksum( void const * data, size_t nbytes ){
+	return bulk_array_impl::copy_and_checksum( nullptr, data, nbytes, true );
+}
+
+/// @brief write array atomically: data goes to a temp file which is renamed
+///        over fname, so concurrent readers never see a partial file
+template< class T >
+bool write_bulk_array( std::string const & fname, T const * data, size_t n, uint64_t tag = 0 ){
+	BulkArrayHeader header;
+	header.elem_size = sizeof(T);
+	header.count = n;
+	header.tag = tag;
+	header.checksum = bulk_array_checksum( data, n*sizeof(T) );
+
+	std::ostringstream tmpname;
+	tmpname << fname << ".tmp" << getpid() << "_" << (void const*)data;
+	{
+		std::ofstream out( tmpname.str().c_str(), std::ios::binary );
+		if( !out.good() ) return false;
+		out.write( (char const*)&header, sizeof(BulkArrayHeader) );
+		if( n ) out.write( (char const*)data, n*sizeof(T) );
+		out.close();
+		if( !out.good() ){
+			std::remove( tmpname.str().c_str() );
+			return false;
+		}
+	}
+	if( std::rename( tmpname.str().c_str(), fname.c_str() ) != 0 ){
+		std::remove( tmpname.str().c_str() );
+		return false;
+	}
+	return true;
+}
+
+/// @brief read-only memory mapped view of a bulk array file
+/// @detail pages are faulted in on demand, so opening is O(1) apart from
+///         the optional checksum pass
+template< class T >
+class MappedBulkArray {
+public:
+	MappedBulkArray() : map_(nullptr), map_bytes_(0), data_(nullptr), size_(0) {}
+	~MappedBulkArray() { close(); }
+
+	/// @brief map fname, false if missing, wrong element type or tag, truncated, or checksum mismatch
+	bool open( std::string const & fname, uint64_t tag = 0, bool verify = true ){
+		close();
+		BulkArrayHeader header;
+		if( !bulk_array_impl::read_header( fname, header ) ) return false;
+		if( header.version != BulkArrayHeader::VERSION || header.elem_size != sizeof(T) || header.tag != tag ) return false;
+		int64_t const fsize = bulk_array_impl::file_size( fname );
+		if( fsize != (int64_t)( sizeof(BulkArrayHeader) + header.payload_bytes() ) ) return false;
+		int fd = ::open( fname.c_str(), O_RDONLY );
+		if( fd < 0 ) return false;
+		void * m = mmap( nullptr, fsize, PROT_READ, MAP_PRIVATE, fd, 0 );
+		::close( fd );
+		if( m == MAP_FAILED ) return false;
+		map_ = m;
+		map_bytes_ = fsize;
+		data_ = (T const *)( (char const*)m + sizeof(BulkArrayHeader) );
+		size_ = header.count;
+		if( verify && bulk_array_checksum( data_, size_*sizeof(T) ) != header.checksum ){
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void close(){
+		if( map_ ) munmap( map_, map_bytes_ );
+		map_ = nullptr;
+		map_bytes_ = 0;
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	bool is_open() const { return map_ != nullptr; }
+	size_t size() const { return size_; }
+	T const * data() const { return data_; }
+	T const & operator[]( size_t i ) const { return data_[i]; }
+	T const * begin() const { return data_; }
+	T const * end() const { return data_ + size_; }
+
+private:
+	MappedBulkArray( MappedBulkArray const & );
+	MappedBulkArray & operator=( MappedBulkArray const & );
+	void * map_;
+	size_t map_bytes_;
+	T const * data_;
+	size_t size_;
+};
+
+/// @brief load whole array into a contiguous container (anything with resize() and data())
+/// @detail with use_mmap the file is mapped and copied out in parallel chunks while the
+///         checksum is computed, otherwise it's read with a single bulk read. on any
+///         failure returns false and out is left empty
+template< class T, class Container >
+bool read_bulk_array( std::string const & fname, Container & out, uint64_t tag = 0, bool use_mmap = true, bool verify = true ){
+	out.resize( 0 );
+	if( use_mmap ){
+		MappedBulkArray<T> mapped;
+		if( !mapped.open( fname, tag, false ) ) return false;
+		BulkArrayHeader header;
+		if( !bulk_array_impl::read_header( fname, header ) ) return false;
+		out.resize( mapped.size() );
+		uint64_t sum = bulk_array_impl::copy_and_checksum( out.data(), mapped.data(), mapped.size()*sizeof(T), verify );
+		if( verify && sum != header.checksum ){
+			out.resize( 0 );
+			return false;
+		}
+		return true;
+	}
+	std::ifstream in( fname.c_str(), std::ios::binary );
+	if( !in.good() ) return false;
+	BulkArrayHeader header;
+	in.read( (char*)&header, sizeof(BulkArrayHeader) );
+	if( !in.good() || !header.magic_ok() ) return false;
+	if( header.version != BulkArrayHeader::VERSION || header.elem_size != sizeof(T) || header.tag != tag ) return false;
+	if( bulk_array_impl::file_size( fname ) != (int64_t)( sizeof(BulkArrayHeader) + header.payload_bytes() ) ) return false;
+	out.resize( header.count );
+	if( header.count ) in.read( (char*)out.data(), header.payload_bytes() );
+	if( !in.good() || ( verify && bulk_array_checksum( out.data(), header.payload_bytes() ) != header.checksum ) ){
+		out.resize( 0 );
+		return false;
+	}
+	return true;
+}
+
+}}
+
+#endif
@@ -110,6 +110,8 @@ struct NestDirector
 	NestDirector( A const & a, B const & b, C const & c, Index ibody ) : ibody_(ibody),nest_(a,b,c) {}
 	template<class A, class B, class C, class D>
 	NestDirector( A const & a, B const & b, C const & c, D const & d, Index ibody ) : ibody_(ibody),nest_(a,b,c,d) {}
+	template<class A, class B, class C, class D, class E>
+	NestDirector( A const & a, B const & b, C const & c, D const & d, E const & e, Index ibody ) : ibody_(ibody),nest_(a,b,c,d,e) {}
 
 	Nest const & nest() const { return nest_; }
 
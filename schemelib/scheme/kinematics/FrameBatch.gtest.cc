@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "scheme/kinematics/FrameBatch.hh"
+
+#include <Eigen/Geometry>
+#include <random>
+
+namespace scheme { namespace kinematics { namespace test_frame_batch {
+
+typedef Eigen::Transform<float,3,Eigen::AffineCompact> Xform;
+
+Xform random_xform( std::mt19937 & rng ){
+	std::normal_distribution<float> gauss;
+	Eigen::Quaternionf q( gauss(rng), gauss(rng), gauss(rng), gauss(rng) );
+	q.normalize();
+	Xform x( q.matrix() );
+	x.translation() = 10.0*Eigen::Vector3f( gauss(rng), gauss(rng), gauss(rng) );
+	return x;
+}
+
+TEST( FrameBatch, transform_matches_xform_product ){
+	std::mt19937 rng(0);
+	std::vector<Xform> frames;
+	FrameBatch<float> batch(37), moved;
+	for( int i = 0; i < 37; ++i ){
+		frames.push_back( random_xform(rng) );
+		batch.set( i, frames.back() );
+	}
+	Xform x = random_xform(rng);
+	batch.transform( x, moved );
+	ASSERT_EQ( moved.size(), 37 );
+	for( int i = 0; i < 37; ++i ){
+		Xform back, expected = x * frames[i];
+		batch.get( i, back );
+		ASSERT_TRUE( back.isApprox( frames[i] ) );
+		moved.get( i, back );
+		ASSERT_TRUE( back.isApprox( expected, 1e-5 ) );
+	}
+}
+
+}}}
@@ -0,0 +1,62 @@
+#ifndef INCLUDED_kinematics_FrameBatch_HH
+#define INCLUDED_kinematics_FrameBatch_HH
+
+#include <Eigen/Dense>
+
+#include <stdint.h>
+
+namespace scheme {
+namespace kinematics {
+
+///@brief rigid frames stored struct-of-arrays, one column per rotation or
+///       translation component, so moving all of them by one Xform is twelve
+///       vectorized column updates instead of a 3x4 product per frame
+///@detail column 3*r+c holds rotation(r,c), columns 9,10,11 the translation
+template< class _Float >
+struct FrameBatch {
+	typedef _Float Float;
+	typedef Eigen::Array<Float,Eigen::Dynamic,12> Data;
+
+	Data data_;
+
+	FrameBatch() {}
+	FrameBatch( size_t n ) : data_(n,12) {}
+
+	size_t size() const { return (size_t)data_.rows(); }
+	void resize( size_t n ){ data_.resize(n,12); }
+
+	template< class Xform >
+	void set( size_t i, Xform const & x ){
+		for( int r = 0; r < 3; ++r ){
+			for( int c = 0; c < 3; ++c ) data_(i,3*r+c) = x.linear()(r,c);
+			data_(i,9+r) = x.translation()[r];
+		}
+	}
+
+	template< class Xform >
+	void get( size_t i, Xform & x ) const {
+		x.setIdentity();
+		for( int r = 0; r < 3; ++r ){
+			for( int c = 0; c < 3; ++c ) x.linear()(r,c) = data_(i,3*r+c);
+			x.translation()[r] = data_(i,9+r);
+		}
+	}
+
+	///@brief out[i] = x * this[i] for every frame
+	template< class Xform >
+	void transform( Xform const & x, FrameBatch & out ) const {
+		out.resize( size() );
+		for( int r = 0; r < 3; ++r ){
+			Float const x0 = x.linear()(r,0), x1 = x.linear()(r,1), x2 = x.linear()(r,2);
+			for( int c = 0; c < 3; ++c ){
+				out.data_.col(3*r+c) = x0*data_.col(c) + x1*data_.col(3+c) + x2*data_.col(6+c);
+			}
+			out.data_.col(9+r) = x0*data_.col(9) + x1*data_.col(10) + x2*data_.col(11) + (Float)x.translation()[r];
+		}
+	}
+};
+
+}
+}
+
+#endif
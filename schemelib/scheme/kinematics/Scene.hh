@@ -5,6 +5,7 @@
 #include "scheme/util/assert.hh"
 #include "scheme/kinematics/SceneBase.hh"
 #include "scheme/kinematics/SceneIterator.hh"
+#include "scheme/kinematics/FrameBatch.hh"
 
 #include "scheme/util/meta/InstanceMap.hh"
 #include "scheme/util/container/ContainerInteractions.hh"
@@ -124,6 +125,10 @@ namespace impl {
 	using m::false_;
 	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(Symmetric,true_)
 	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(RequireAbsolutePositioning,false_)
+	// Actors with BatchFrames = true_ are moved all at once through a FrameBatch
+	// when visited relative to a fixed partner, they must provide set_position()
+	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(BatchFrames,false_)
+	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(Scalar,double)
 
 	template<class _Interaction>
 	struct AccessVisitor {
@@ -336,6 +341,8 @@ namespace impl {
 		typedef std::vector<Body> Bodies;
 		typedef m::true_ DefinesInteractionWeight;
 		typedef m::true_ UseVisitor;
+		typedef m::true_ VisitBatch;
+		typedef typename impl::get_Scalar_double<Position>::type PositionFloat;
 
 		Bodies bodies_;
 
@@ -446,7 +453,10 @@ namespace impl {
 		// }
 		// void set_body(Index i, shared_ptr<ConformationConst> const & c){ bodies_[i] = c; }
 		// void set_body(Index i, Body const & b){ bodies_[i] = b; }
-		Conformation & mutable_conformation_asym(Index i) { return const_cast<Conformation&>(bodies_.at(i).conformation()); }
+		Conformation & mutable_conformation_asym(Index i) {
+			batch_frame_cache_.clear();
+			return const_cast<Conformation&>(bodies_.at(i).conformation());
+		}
 
 
 		Conformation const & conformation(Index i) const { return bodies_.at(i%bodies_.size()).conformation(); }
@@ -658,20 +668,121 @@ namespace impl {
 					Container2 const & container2 = c2.template get<Actor2>();
 					Position const rel_pos = inverse(__position_unsafe__(i1))*( __position_unsafe__(i2) );
 					ContInter::get_interaction_range( rel_pos, container1, container2, range );
-					for( iter = get_cbegin(range),end  = get_cend(range); iter != end; ++iter){
-						double const w = i1<NBOD&&i2<NBOD?1.0:0.5;
-						Index j1,j2;
-						boost::tie(j1,j2) = *iter;
-						Actor1 const & a1_0( c1.template get<Actor1>()[j1] );
-						Actor2 const & a2_0( c2.template get<Actor2>()[j2] );
-						visit_2b_inner(visitor,a1_0,a2_0,p1,p2,rel_pos,w);
-					}
+					double const w = i1<NBOD&&i2<NBOD?1.0:0.5;
+					visit_2b_range<Actor1,Actor2>( visitor, range, container1, container2, i2%NBOD, p1, p2, rel_pos, w );
 
 				}
 			}
 
 		}
 
+		///@brief like the pair visit, but the visitor gets visitor( container1, container2, rel_pos, weight )
+		///       once per pair of bodies and must score every pair of actors in the two containers
+		///       itself, with Actor1 fixed and Actor2 at rel_pos
+		template<class Visitor>
+		void visit_batch(Visitor & visitor) const {
+			typedef typename Visitor::Interaction::first_type Actor1;
+			typedef typename Visitor::Interaction::second_type Actor2;
+			typedef typename f::result_of::value_at_key<Conformation,Actor1>::type Container1;
+			typedef typename f::result_of::value_at_key<Conformation,Actor2>::type Container2;
+			BOOST_STATIC_ASSERT(( !boost::is_same<Actor1,Actor2>::value ));
+
+			Index const NBOD = (Index)bodies_.size();
+			Index const NSYM = (Index)this->symframes_.size();
+			for(Index i1 = 0; i1 < NBOD*NSYM; ++i1){
+				Container1 const & container1 = conformation(i1).template get<Actor1>();
+				if( container1.size() == 0 ) continue;
+				for(Index i2 = 0; i2 < NBOD*NSYM; ++i2){
+					if( i1 >= NBOD && i2 >= NBOD ) continue;
+					if( i1==i2 ) continue;
+					Container2 const & container2 = conformation(i2).template get<Actor2>();
+					if( container2.size() == 0 ) continue;
+					Position const rel_pos = inverse(__position_unsafe__(i1))*( __position_unsafe__(i2) );
+					visitor( container1, container2, rel_pos, i1<NBOD&&i2<NBOD?1.0:0.5 );
+				}
+			}
+		}
+
+		template<class Actor1, class Actor2, class Visitor, class ContRange, class Container1, class Container2>
+		typename boost::disable_if<
+			m::and_<
+				impl::get_BatchFrames_false_<Actor2>,
+				m::not_<impl::get_RequireAbsolutePositioning_false_<Visitor> >
+			> >::type
+		visit_2b_range(
+			Visitor & visitor,
+			ContRange const & range,
+			Container1 const & container1,
+			Container2 const & container2,
+			Index ,
+			Position const & p1,
+			Position const & p2,
+			Position const & rel_pos,
+			double w
+		) const {
+			typename util::container::get_citer<ContRange>::type iter,end;
+			for( iter = get_cbegin(range),end  = get_cend(range); iter != end; ++iter){
+				Index j1,j2;
+				boost::tie(j1,j2) = *iter;
+				Actor1 const & a1_0( container1[j1] );
+				Actor2 const & a2_0( container2[j2] );
+				visit_2b_inner(visitor,a1_0,a2_0,p1,p2,rel_pos,w);
+			}
+		}
+
+		///@brief same as visit_2b_inner with a fixed Actor1, but all Actor2 frames are moved by
+		///       rel_pos in one FrameBatch::transform before the range is walked
+		template<class Actor1, class Actor2, class Visitor, class ContRange, class Container1, class Container2>
+		typename boost::enable_if<
+			m::and_<
+				impl::get_BatchFrames_false_<Actor2>,
+				m::not_<impl::get_RequireAbsolutePositioning_false_<Visitor> >
+			> >::type
+		visit_2b_range(
+			Visitor & visitor,
+			ContRange const & range,
+			Container1 const & container1,
+			Container2 const & container2,
+			Index ib2,
+			Position const & ,
+			Position const & ,
+			Position const & rel_pos,
+			double w
+		) const {
+			typename util::container::get_citer<ContRange>::type iter = get_cbegin(range), end = get_cend(range);
+			if( iter == end ) return;
+			FrameBatch<PositionFloat> const & moved = batch_frames_moved( ib2, container2, rel_pos );
+			Position pos;
+			for( ; iter != end; ++iter){
+				Index j1,j2;
+				boost::tie(j1,j2) = *iter;
+				Actor2 a2( container2[j2] );
+				moved.get( j2, pos );
+				a2.set_position( pos );
+				visitor.template operator()< std::pair<Actor1,Actor2> >( container1[j1], a2, w );
+			}
+		}
+
+		///@brief frames of body ib's container moved by rel_pos, the unmoved frames are
+		///       cached per body until the body's conformation or container changes
+		template<class Container>
+		FrameBatch<PositionFloat> const &
+		batch_frames_moved( Index ib, Container const & container, Position const & rel_pos ) const {
+			if( batch_frame_cache_.size() < bodies_.size() ) batch_frame_cache_.resize( bodies_.size() );
+			BatchFrameCache & cache = batch_frame_cache_[ib];
+			shared_ptr<ConformationConst> const conf = bodies_[ib].conformation_ptr();
+			if( cache.container_ != (void const*)&container || cache.frames_.size() != container.size() ||
+			    cache.conformation_.owner_before(conf) || conf.owner_before(cache.conformation_) )
+			{
+				cache.conformation_ = conf;
+				cache.container_ = &container;
+				cache.frames_.resize( container.size() );
+				for( size_t j = 0; j < container.size(); ++j ) cache.frames_.set( j, container[j].position() );
+			}
+			cache.frames_.transform( rel_pos, batch_frames_moved_ );
+			return batch_frames_moved_;
+		}
+
 		///@brief visit_2b_inner specialization handles case where both actors are positionable (not fixed)
 		template<class Visitor, class Actor1, class Actor2>
 		typename boost::enable_if<
@@ -885,6 +996,21 @@ namespace impl {
 			return ( ph.first.first < this->nbodies_asym() && ph.first.second < this->nbodies_asym() ) ? 1.0 : 0.5;
 		}
 
+	private:
+
+		struct BatchFrameCache {
+			weak_ptr<ConformationConst> conformation_;
+			void const * container_;
+			FrameBatch<PositionFloat> frames_;
+			BatchFrameCache() : container_(0) {}
+		};
+
+		// scratch for visit_2b_range, so const visitation of one Scene is not thread safe with
+		// BatchFrames actors. copies start empty, in place actor edits go through
+		// mutable_conformation_asym which drops it
+		mutable std::vector<BatchFrameCache> batch_frame_cache_;
+		mutable FrameBatch<PositionFloat> batch_frames_moved_;
+
 
 	};
 
@@ -176,6 +176,58 @@ TEST(Scene_eigen,relative_relations_preserved){
 	// ASSERT_TRUE( xa.isApprox(xr) );
 }
 
+template<class Batch>
+struct XactorMaybeBatch : Xactor {
+	typedef Batch BatchFrames;
+	XactorMaybeBatch() {}
+	XactorMaybeBatch(Position const & p, int d) : Xactor(p,d) {}
+	XactorMaybeBatch(XactorMaybeBatch const & a,Position const & moveby) : Xactor(a,moveby) {}
+	void set_position(Position const & p){ position_ = p; }
+};
+
+template<class Actor2>
+struct RecordPositions {
+	typedef std::pair<Xactor,Actor2> Interaction;
+	std::vector<Xform> positions_;
+	std::vector<double> weights_;
+	template<class I>
+	void operator()( Xactor const &, Actor2 const & a2, double w ){
+		positions_.push_back( a2.position() );
+		weights_.push_back( w );
+	}
+};
+
+template<class Actor2>
+RecordPositions<Actor2> visit_fixed_vs_moving( Xform const & x0, Xform const & x1 ){
+	typedef Scene< impl::Conformation< m::vector<Xactor,Actor2> >, Xform > MyScene;
+	MyScene scene(2);
+	scene.add_symframe( Xform(Vec(0,0,20),1,UZ) );
+	scene.mutable_conformation_asym(0).add_actor( Xactor(Xform(Vec(1,2,3),0,UX),0) );
+	for( int i = 0; i < 7; ++i ){
+		scene.mutable_conformation_asym(1).add_actor( Actor2(Xform(Vec(i,-i,2*i),0.3*i,Vec(1,i,2).normalized()),i) );
+	}
+	RecordPositions<Actor2> visitor;
+	scene.set_position(0,x0);
+	scene.set_position(1,x1);
+	scene.visit(visitor);
+	// second visit reuses the cached frames
+	scene.set_position(1,x0*x1);
+	scene.visit(visitor);
+	return visitor;
+}
+
+TEST(Scene_eigen,batch_frames_match_per_actor){
+	Xform x0(Vec(10,0,0),2,UX), x1(Vec(0,10,0),2,UY);
+	RecordPositions< XactorMaybeBatch<m::false_> > plain = visit_fixed_vs_moving< XactorMaybeBatch<m::false_> >(x0,x1);
+	RecordPositions< XactorMaybeBatch<m::true_ > > batch = visit_fixed_vs_moving< XactorMaybeBatch<m::true_ > >(x0,x1);
+	ASSERT_EQ( plain.positions_.size(), 42 );
+	ASSERT_EQ( batch.positions_.size(), plain.positions_.size() );
+	for( size_t i = 0; i < plain.positions_.size(); ++i ){
+		ASSERT_TRUE( batch.positions_[i].isApprox( plain.positions_[i] ) );
+		ASSERT_EQ( batch.weights_[i], plain.weights_[i] );
+	}
+}
+
 // TEST(Scene_eigen,symmetry){
 // 	typedef	objective::ObjectiveFunction<
 // 		m::vector<
@@ -291,6 +291,10 @@ namespace nest {
 		template< class A, class B, class C, class D >
 		NEST(A const & a, B const & b, C const & c, D const & d) : ParamMapType(a,b,c,d) {}
 
+		///@brief general constructor 5
+		template< class A, class B, class C, class D, class E >
+		NEST(A const & a, B const & b, C const & c, D const & d, E const & e) : ParamMapType(a,b,c,d,e) {}
+
 
 		///@brief get size of NEST at depth resl
 		///@return size of NEST at resolution depth resl
@@ -408,6 +412,28 @@ namespace nest {
 			functor = boost::bind( & ThisType::template push_index<OutIter>, this, _1, cell_index, resl, out );
 			util::NESTED_FOR<DIM>(lb,ub,functor);
 		}
+		///@brief get the index vector and cell index of a zorder index at resolution resl, inverse of get_index
+		///@returns false iff index is out of range
+		bool get_indicies_for_index(Index index, Index resl, Indices & indices_out, Index & cell_index_out) const {
+			assert(resl<=MAX_RESL_ONE_CELL); // not rigerous check if Ncells > 1
+			if(index >= size(resl)) return false;
+			cell_index_out = index >> (DIM*resl);
+			Index hier_index = index & ((ONE<<(DIM*resl))-1);
+			for(size_t i = 0; i < DIM; ++i) indices_out[i] = util::undilate<DIM>(hier_index>>i);
+			return true;
+		}
+		///@brief put the zorder indices of all neighbors of bin index at resolution resl into OutIter out
+		///@detail works from the index alone, so no value lookup is needed. includes index itself.
+		///        only neighbors in the same cell are found, bins on a cell face get fewer neighbors
+		///@return false iff index is out of range
+		template<class OutIter>
+		bool get_neighbors_for_index(Index index, Index resl, OutIter out) const {
+			Indices indices;
+			Index cell_index;
+			if( !get_indicies_for_index(index,resl,indices,cell_index) ) return false;
+			get_neighbors(indices,cell_index,resl,out);
+			return true;
+		}
 		///@brief put the zorder indices of all neighbors of bin for Value v at resolution resl into OutIter out
 		///@return false iff Value v itself dosen't have a valid index in this NEST
 		template<class OutIter>
@@ -30,6 +30,31 @@ TEST(NEST_NEIGHBOR,dim2_test_case){
  	ASSERT_EQ(neighbors[3],3);
 }
 
+TEST(NEST_NEIGHBOR,neighbors_for_index){
+	NEST<3> nest;
+	size_t const r = 3;
+	for( size_t index = 0; index < nest.size(r); index += 37 ){
+		NEST<3>::Indices indices;
+		size_t cell_index;
+		ASSERT_TRUE( nest.get_indicies_for_index( index, r, indices, cell_index ) );
+		ASSERT_EQ( nest.get_index( indices, cell_index, r ), index );
+
+		std::vector<size_t> from_index, from_value;
+		nest.get_neighbors_for_index( index, r, std::back_inserter(from_index) );
+		nest.get_neighbors( nest.set_and_get(index,r), r, std::back_inserter(from_value) );
+		ASSERT_EQ( from_index, from_value );
+		ASSERT_TRUE( std::find( from_index.begin(), from_index.end(), index ) != from_index.end() );
+	}
+	// interior bin gets all 3^3, corner bin only 2^3
+	std::vector<size_t> nbrs;
+	nest.get_neighbors_for_index( nest.get_index( NEST<3>::ValueType(0.5,0.5,0.5), r ), r, std::back_inserter(nbrs) );
+	ASSERT_EQ( nbrs.size(), 27 );
+	nbrs.clear();
+	nest.get_neighbors_for_index( 0, r, std::back_inserter(nbrs) );
+	ASSERT_EQ( nbrs.size(), 8 );
+	ASSERT_FALSE( nest.get_neighbors_for_index( nest.size(r), r, std::back_inserter(nbrs) ) );
+}
+
 TEST(NEST_NEIGHBOR,dim3_test_case){
 	NEST<3> nest;
 	typedef NEST<3>::ValueType VAL;
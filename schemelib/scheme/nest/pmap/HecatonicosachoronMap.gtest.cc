@@ -646,6 +646,55 @@ TEST(hecatonicosachoron,covering){
 
 }
 
+// the param cube is about twice the volume of the dodecahedral cell, so with nside > 2 many
+// bin centers fall in a neighboring cell and look up to that cell's bin instead. that bin
+// must still be a close one
+TEST(hecatonicosachoron,nside_cell_lookup){
+	double const * covrad = HecatonicosachoronMap<>::get_covrad_data();
+	for(int nside = 1; nside <= 6; ++nside){
+		NEST<3,Matrix3d,HecatonicosachoronMap> nest(nside);
+		ASSERT_EQ( nest.size(0), 60u*nside*nside*nside );
+		uint64_t nfail = 0;
+		for(int i = 0; i < (int)nest.size(0); ++i){
+			if( nest.set_state(i,0) ){
+				Eigen::Quaterniond q( nest.value() );
+				size_t ilookup = nest.get_index( nest.value(), 0 );
+				nfail += ( (size_t)i != ilookup );
+				ASSERT_TRUE( nest.set_state(ilookup,0) );
+				ASSERT_LE( q.angularDistance( Eigen::Quaterniond( nest.value() ) )*180.0/M_PI, 2.0*covrad[nside-1] );
+			}
+		}
+		if( nside <= 2 ){ ASSERT_EQ( nfail, 0u ); }
+	}
+}
+
+// sampled covering radius must stay under the table get_nside_for_rot_resl_deg uses
+TEST(hecatonicosachoron,nside_covering){
+	int MAX_NSIDE = 8;
+	int NITER = 20*1000;
+	#ifdef SCHEME_BENCHMARK
+		MAX_NSIDE = 32;
+		NITER *= 50;
+	#endif
+	std::mt19937 rng(0);
+	std::normal_distribution<> gauss;
+	double const * covrad = HecatonicosachoronMap<>::get_covrad_data();
+	for(int nside = 1; nside <= MAX_NSIDE; ++nside){
+		NEST<3,Matrix3d,HecatonicosachoronMap> nest(nside);
+		double maxdiff = 0;
+		for(int i = 0; i <= NITER; ++i){
+			Eigen::Quaterniond q( fabs(gauss(rng)), gauss(rng), gauss(rng), gauss(rng) );
+			q.normalize();
+			ASSERT_TRUE( nest.set_state( nest.get_index(q.matrix(),0), 0 ) );
+			maxdiff = std::max( maxdiff, q.angularDistance( Eigen::Quaterniond( nest.value() ) ) );
+		}
+		ASSERT_LE( maxdiff*180.0/M_PI, covrad[nside-1] + 0.01 );
+		ASSERT_NEAR( nest.bin_circumradius(0)*180.0/M_PI, covrad[nside-1], 0.0001 );
+	}
+	ASSERT_EQ( HecatonicosachoronMap<>::get_nside_for_rot_resl_deg( 50.0 ), 1 );
+	ASSERT_EQ( HecatonicosachoronMap<>::get_nside_for_rot_resl_deg( 10.0 ), 8 );
+}
+
 // TEST( hecatonicosachoron, visualize ){
 
 // 	std::mt19937 rng((unsigned int)time(0));
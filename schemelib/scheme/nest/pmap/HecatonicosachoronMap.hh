@@ -256,10 +256,14 @@ namespace pmap {
 		return Eigen::Map<Eigen::Quaternion<Float>const>( get_h120inv<Float>() + 4* get_h120_nbrs<uint8_t>()[12*i+j]  );
 	}
 
-	template<class Float> static double cell_width()    { return 1.12*0.61803398874989479; }
-	template<class Float> static double cell_inradius() { return 1.12*0.61803398874989479/2.0; }
+	template<class Float> static double h120_cell_width()    { return 1.12*0.61803398874989479; }
+	template<class Float> static double h120_cell_inradius() { return 1.12*0.61803398874989479/2.0; }
 
 
+	///@brief orientations as the 60 cells of the half 120-cell, each split into nside^3 subcells
+	///@detail cells are much rounder than those of TetracontoctachoronMap, so for a given
+	///        covering radius fewer orientations are needed. cell_index is
+	///        h120_cell * nside^3 + subcell, nside 1 is the plain 60 cell map
 	template<
 		int DIM=3,
 		class Value=Eigen::Matrix3d,
@@ -269,6 +273,8 @@ namespace pmap {
 	struct HecatonicosachoronMap {
 		BOOST_STATIC_ASSERT_MSG(DIM==3,"HecatonicosachoronMap DIM must be == 3");
 
+		static std::string pmap_name() { return "HecatonicosachoronMap"; }
+
 		static int const DIMENSION = DIM;
 		typedef Value ValueType ;
 		typedef Float FloatType ;		
@@ -276,6 +282,14 @@ namespace pmap {
 		typedef util::SimpleArray<DIM,Index> Indices;
 		typedef util::SimpleArray<DIM,Float> Params;		
 
+		Index nside_;
+		Float one_over_nside_;
+
+		HecatonicosachoronMap() { init(1); }
+		HecatonicosachoronMap(Index nside) { init(nside); }
+
+		void init(uint64_t nside){ nside_ = nside; one_over_nside_ = 1.0/nside_; }
+
 		///@brief sets value to parameters without change
 		///@return false iff invalid parameters
 		bool params_to_value(
@@ -285,36 +299,58 @@ namespace pmap {
 			Value & value
 		) const {
 			// cout << "        set p0 " << params << endl;
-			Float const & w(cell_width<Float>());
-			Matrix<Float,3,1> p(w*(params[0]-0.5), w*(params[1]-0.5), w*(params[2]-0.5));
+			Float const w( h120_cell_width<Float>() );
+
+			Index const nside3 = nside_*nside_*nside_;
+			Index const h120_cell_index = cell_index / nside3;
+			cell_index = cell_index % nside3;
+			Params pp = params * one_over_nside_;
+			pp[0] += one_over_nside_ * (Float)( cell_index                   % nside_ );
+			pp[1] += one_over_nside_ * (Float)( cell_index /  nside_         % nside_ );
+			pp[2] += one_over_nside_ * (Float)( cell_index / (nside_*nside_) % nside_ );
+
+			Matrix<Float,3,1> p(w*(pp[0]-0.5), w*(pp[1]-0.5), w*(pp[2]-0.5));
 			// cout << "      set p  " << p.transpose() << endl;
 
-			Float corner = w * sqrt(3.0)/2.0 / (1<<resl);
+			Float corner = w * sqrt(3.0)/2.0 / (1<<resl) * one_over_nside_;
 			Float d1 = p.dot(Matrix<Float,3,1>(-0.95445795738974371,-0.21097222748273989,-0.21095195378656478));
 			Float d2 = p.dot(Matrix<Float,3,1>(0.21096798633445943,0.2109735541787314,0.95445412052082268));
 			Float d3 = p.dot(Matrix<Float,3,1>(0.50929718594265139,0.5093043977875642,-0.69370412049024388));
 			Float d4 = p.dot(Matrix<Float,3,1>(-0.50931727232506019,0.69368514566945905,-0.50931015578810335));
 			Float d5 = p.dot(Matrix<Float,3,1>(-0.69369485751947446,0.50930654442677104,0.50930765599497663));
 			Float d6 = p.dot(Matrix<Float,3,1>(0.2109555722674199,0.95446198014589045,0.2109504088294476));
-			if( fabs(d1)-corner >= cell_inradius<Float>() ||
-			    fabs(d2)-corner >= cell_inradius<Float>() ||
-			    fabs(d3)-corner >= cell_inradius<Float>() ||
-			    fabs(d4)-corner >= cell_inradius<Float>() ||
-			    fabs(d5)-corner >= cell_inradius<Float>() ||
-			    fabs(d6)-corner >= cell_inradius<Float>() ){ return false; }
+			if( fabs(d1)-corner >= h120_cell_inradius<Float>() ||
+			    fabs(d2)-corner >= h120_cell_inradius<Float>() ||
+			    fabs(d3)-corner >= h120_cell_inradius<Float>() ||
+			    fabs(d4)-corner >= h120_cell_inradius<Float>() ||
+			    fabs(d5)-corner >= h120_cell_inradius<Float>() ||
+			    fabs(d6)-corner >= h120_cell_inradius<Float>() ){ return false; }
 
 
 				// 1 = w2 + x2 + y2 + z2
 				// w = sqrt( 1 - x2 - y2 - z2 )
 			Eigen::Quaternion<Float> q( sqrt(1.0-p.squaredNorm()), p[0], p[1], p[2] );
-			assert( fabs(q.squaredNorm()-1.0) < 0.000001 );
+			assert( fabs(q.squaredNorm()-1.0) < 0.0001 );
 			// Eigen::Quaternion<Float> q( 1, p[0], p[1], p[2] );
 			// q.normalize();
 
+			// the cube of params is bigger than the cell, so subcells near its corners can lie
+			// wholly in a neighboring cell and would only duplicate that cell's samples. seen
+			// from its own center every cell has the same 12 neighbors as cell 0 (identity).
+			// a bin whose center is closer to a neighbor by more than twice the bin radius
+			// (in quaternion arc, 1.3 bounds the stretch of the p -> q map) has no orientation
+			// of its own and is dropped
+			Float const bin_arc = 1.3 * corner;
+			Float nbr_dot = 0;
+			for(int inbr = 0; inbr < 12; ++inbr){
+				nbr_dot = std::max<Float>( nbr_dot, fabs( q.coeffs().dot( h120_cellnbr<Float>(0,inbr).coeffs() ) ) );
+			}
+			if( acos( std::min<Float>( 1.0, fabs(q.w()) ) ) - acos( std::min<Float>( 1.0, nbr_dot ) ) > 2.0*bin_arc ) return false;
+
 			// cout << "    set q0 " << q.coeffs().transpose() << endl;
 			// cout << "  set ci " << cell_index << endl;
 
-			q = h120_cellcen<Float>(cell_index)*q;
+			q = h120_cellcen<Float>(h120_cell_index)*q;
 			// cout << "set q  " << q.coeffs().transpose() << endl;
 			value = q.matrix();
 			return true;
@@ -333,23 +369,24 @@ namespace pmap {
 			// cout << "get q  " << q.coeffs().transpose() << endl;
 
 			// compare to all cell centers... TODO: optimize this!
-			Map< Matrix<double,4,60> const > h120( get_h120<Float>() );
+			Map< Matrix<Float,4,60> const > h120( get_h120<Float>() );
 			Matrix<Float,60,1> dots = ( q.coeffs().transpose() * h120 );
 			double mx = - 9e9;
+			Index h120_cell_index = 0;
 			for(int i = 0; i < 60; ++i){
 				// cout << i << " " << dots[i] << endl;
 				if( fabs(dots[i]) > mx ){ // TODO: needs fabs?
 					mx = fabs(dots[i]);
-					cell_index = i;
+					h120_cell_index = i;
 					// cout << i << " " << dots[i] << " " << cell_index << endl;
 				}
 			}
 			// cout << "closest cell " << cell_index << endl;
-			assert( cell_index < 60 );
+			assert( h120_cell_index < 60 );
 
 			// cout << "  get ci " << cell_index << endl;
 
-			q = h120_cellceninv<Float>(cell_index) * q;
+			q = h120_cellceninv<Float>(h120_cell_index) * q;
 			q = to_half_cell(q);
 			// cout << q.w() << endl;
 			assert( q.w() > 0.7 );
@@ -358,9 +395,18 @@ namespace pmap {
 
 			// cout << "      get p  " << q.x() << " " << q.y() << " " << q.z() << endl;
 
-			params[0] = q.x()/cell_width<Float>() + 0.5;
-			params[1] = q.y()/cell_width<Float>() + 0.5;			
-			params[2] = q.z()/cell_width<Float>() + 0.5;
+			params[0] = q.x()/h120_cell_width<Float>() + 0.5;
+			params[1] = q.y()/h120_cell_width<Float>() + 0.5;			
+			params[2] = q.z()/h120_cell_width<Float>() + 0.5;
+
+			// subcell, clamped so rounding at the cell boundary can't leave the cell
+			Indices ci;
+			for(int i = 0; i < 3; ++i){
+				Float const x = params[i] * nside_;
+				ci[i] = x <= 0.0 ? 0 : std::min<Index>( (Index)x, nside_-1 );
+				params[i] = x - ci[i];
+			}
+			cell_index = h120_cell_index*nside_*nside_*nside_ + ci[0] + ci[1]*nside_ + ci[2]*nside_*nside_;
 
 			// cout << "        get p0 " << params << endl;
 
@@ -379,8 +425,61 @@ namespace pmap {
 		template<class OutIter>
 		void get_neighboring_cells(Value const & value, Float radius, OutIter out) const;
 
+		///@brief max angle (degrees) from a resl 0 bin center to any orientation in the
+		///       bin for nside 1..32, measured by sampling (see nside_covering test)
+		static Float const * get_covrad_data(){
+			static Float const covrad[32] = {
+				 44.34695 , // 1
+				 34.63364 , // 2
+				 23.85990 , // 3
+				 18.29092 , // 4
+				 14.92451 , // 5
+				 12.27624 , // 6
+				 10.40428 , // 7
+				  9.02202 , // 8
+				  8.01097 , // 9
+				  7.25065 , // 10
+				  6.59271 , // 11
+				  5.95735 , // 12
+				  5.56135 , // 13
+				  5.12995 , // 14
+				  4.78753 , // 15
+				  4.48897 , // 16
+				  4.24020 , // 17
+				  4.04669 , // 18
+				  3.75995 , // 19
+				  3.57012 , // 20
+				  3.42057 , // 21
+				  3.25186 , // 22
+				  3.10616 , // 23
+				  3.02144 , // 24
+				  2.88262 , // 25
+				  2.75266 , // 26
+				  2.69083 , // 27
+				  2.56119 , // 28
+				  2.45744 , // 29
+				  2.35562 , // 30
+				  2.30901 , // 31
+				  2.24817   // 32
+			};
+			return covrad;
+		}
+
+		static int get_nside_for_rot_resl_deg( Float rot_resl_deg ){
+			static Float const * covrad = get_covrad_data();
+			int nside = 0;
+			while( covrad[nside] > rot_resl_deg && nside < 31 ) ++nside;
+			return nside+1;
+		}
+
 		///@brief aka covering radius max distance from bin center to any value within bin
+		///@note each resl halves the subcells, so this is the covrad of nside*2^resl,
+		///      extrapolated as 1/n past the table
 		Float bin_circumradius(Index resl) const {
+			static Float const * covrad = get_covrad_data();
+			Index const n = nside_ << resl;
+			Float const deg = n <= 32 ? covrad[n-1] : covrad[31] * (Float)32.0 / (Float)n;
+			return deg * M_PI / 180.0;
 		}
 
 		///@brief maximum distance from the bin center which must be within the bin
@@ -396,9 +495,21 @@ namespace pmap {
 		}
 
 		///@brief cell size
-		Index num_cells() const { return 60; }
+		Index num_cells() const { return 60*nside_*nside_*nside_; }
 	};
 
+	template<
+		int DIM,
+		class Value,
+		class Index,
+		class Float
+	>
+	std::ostream & operator << ( std::ostream & out, HecatonicosachoronMap<DIM,Value,Index,Float> const & hm ){
+		out << "HecatonicosachoronMap nside = " << hm.nside_ << " covrad0 = " << hm.bin_circumradius(0)*180.0/M_PI;
+		return out;
+	}
+
+
 
 
 }
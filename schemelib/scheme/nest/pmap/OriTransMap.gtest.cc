@@ -71,6 +71,36 @@ TEST( OriTransMap, lookups_multicell_ori ){
 	ASSERT_LE( nfail*1./end, 0.1 );
 }
 
+TEST( OriTransMap, lookups_hecatonicosachoron ){
+
+	typedef Eigen::Transform<double,3,Eigen::AffineCompact> EigenXform;
+
+	typedef NEST<6,EigenXform,OriTransMap> Nest;
+
+	Nest nest( 10.0, 0.0, 1.0, 1, OriMapType::Hecatonicosachoron );
+	ASSERT_EQ( nest.ori120_map_.nside_, 8u );
+	ASSERT_EQ( nest.size(0), 60u*8*8*8 );
+
+	// index -> xform -> index lands on the same bin or, near ori cell faces, a close one
+	int const resl = 0;
+	int end = std::min( (int)1000000,  (int)nest.size( resl ) );
+	int nvalid = 0;
+	for(int i = 0; i < end; ++i){
+		EigenXform x, y;
+		if( !nest.get_state( i, resl, x ) ) continue;
+		++nvalid;
+		ASSERT_TRUE( nest.get_state( nest.get_index( x, resl ), resl, y ) );
+		ASSERT_LE( Eigen::Quaterniond( x.rotation() ).angularDistance( Eigen::Quaterniond( y.rotation() ) )*180.0/M_PI, 20.0 );
+		ASSERT_LE( ( x.translation() - y.translation() ).norm(), 0.001 );
+	}
+	ASSERT_GT( nvalid, 0 );
+
+	// neighbors come from the index alone, same as with the default map
+	std::vector<uint64_t> nbrs;
+	ASSERT_TRUE( nest.get_neighbors_for_index( 12345, 2, std::back_inserter(nbrs) ) );
+	ASSERT_GT( nbrs.size(), 1u );
+}
+
 TEST( OriTransMap, name ){
 	typedef Eigen::Transform<double,3,Eigen::AffineCompact> EigenXform;
 
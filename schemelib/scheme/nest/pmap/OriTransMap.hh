@@ -3,6 +3,7 @@
 
 #include "scheme/nest/pmap/ScaleMap.hh"
 #include "scheme/nest/pmap/TetracontoctachoronMap.hh"
+#include "scheme/nest/pmap/HecatonicosachoronMap.hh"
 
 #include "scheme/util/SimpleArray.hh"
 
@@ -14,6 +15,9 @@
 
 namespace scheme { namespace nest { namespace pmap {
 
+	///@brief orientation half of OriTransMap, chosen at init
+	enum class OriMapType { Tetracontoctachoron, Hecatonicosachoron };
+
 	template<
 		int DIM=6,
 		class Value=Eigen::Transform<double,3,Eigen::AffineCompact>,
@@ -36,12 +40,15 @@ namespace scheme { namespace nest { namespace pmap {
 
 
 		typedef scheme::nest::pmap::TetracontoctachoronMap<3,M,Index,Float> OriMap;
+		typedef scheme::nest::pmap:: HecatonicosachoronMap<3,M,Index,Float> Ori120Map;
 		typedef scheme::nest::pmap::              ScaleMap<3,V,Index,Float> TransMap;
 
+		OriMapType ori_type_;
 		OriMap ori_map_;
+		Ori120Map ori120_map_;
 		TransMap trans_map_;
 
-		OriTransMap(){}
+		OriTransMap() : ori_type_( OriMapType::Tetracontoctachoron ) {}
 
 		template< class P, class I >
 		OriTransMap(
@@ -53,15 +60,33 @@ namespace scheme { namespace nest { namespace pmap {
 			init( rot_resl_deg, lb, ub, bs );
 		}
 
+		template< class P, class I >
+		OriTransMap(
+			Float rot_resl_deg,
+			P const & lb,
+			P const & ub,
+			I const & bs,
+			OriMapType ori_type
+		){
+			init( rot_resl_deg, lb, ub, bs, ori_type );
+		}
+
+		///@brief ori_nside is picked so the resl 0 covering radius is <= rot_resl_deg,
+		///       from the covering table of whichever orientation map is used
 		template< class P, class I >
 		void init(
 			Float rot_resl_deg,
 			P const & lb,
 			P const & ub,
-			I const & bs
+			I const & bs,
+			OriMapType ori_type = OriMapType::Tetracontoctachoron
 		){
-			int const ori_nside = OriMap::get_nside_for_rot_resl_deg( rot_resl_deg );
-			ori_map_.init( ori_nside );
+			ori_type_ = ori_type;
+			if( ori_type_ == OriMapType::Hecatonicosachoron ){
+				ori120_map_.init( Ori120Map::get_nside_for_rot_resl_deg( rot_resl_deg ) );
+			} else {
+				ori_map_.init( OriMap::get_nside_for_rot_resl_deg( rot_resl_deg ) );
+			}
 			trans_map_.init( lb, ub, bs );
 			// cout << "OriMap: TetracontoctachoronMap, "
 			//      << rot_resl_deg << " nside: " << ori_map_.nside_ << ", covrad: "
@@ -77,14 +102,16 @@ namespace scheme { namespace nest { namespace pmap {
 			Index resl,
 			Value & value
 		) const {
-			Index const ncori  = ori_map_.num_cells();
+			Index const ncori  = num_ori_cells();
 			Index const cori   = cell_index % ncori;
 			Index const ctrans = cell_index / ncori;
 			P3 pori  ( params, 0 ); // offset 0
 			P3 ptrans( params, 3 ); // offset 3
 			M m;
 			V v;
-			bool valid = ori_map_.params_to_value( pori  , cori  , resl, m );
+			bool valid = ori_type_ == OriMapType::Hecatonicosachoron
+			           ? ori120_map_.params_to_value( pori, cori, resl, m )
+			           : ori_map_   .params_to_value( pori, cori, resl, m );
 			valid   &= trans_map_.params_to_value( ptrans, ctrans, resl, v );
 			if( !valid ) return false;
 			value = Value( m );
@@ -111,7 +138,9 @@ namespace scheme { namespace nest { namespace pmap {
 			}
 			P3 o_params, t_params;
 			Index o_ci, t_ci;
-			bool valid = ori_map_.value_to_params( m, resl, o_params, o_ci );
+			bool valid = ori_type_ == OriMapType::Hecatonicosachoron
+			           ? ori120_map_.value_to_params( m, resl, o_params, o_ci )
+			           : ori_map_   .value_to_params( m, resl, o_params, o_ci );
 			if( !valid ) return false;
 			// cout << "o_ci " << o_ci << endl;
 			trans_map_.value_to_params( v, resl, t_params, t_ci );
@@ -119,14 +148,18 @@ namespace scheme { namespace nest { namespace pmap {
 				params[i  ] = o_params[i];
 				params[i+3] = t_params[i];
 			}
-			cell_index = t_ci * ori_map_.num_cells() + o_ci;
+			cell_index = t_ci * num_ori_cells() + o_ci;
 
 			return true;
 		}
 
 
 		///@brief cell size
-		Index num_cells() const { return ori_map_.num_cells() * trans_map_.num_cells(); }
+		Index num_cells() const { return num_ori_cells() * trans_map_.num_cells(); }
+
+		Index num_ori_cells() const {
+			return ori_type_ == OriMapType::Hecatonicosachoron ? ori120_map_.num_cells() : ori_map_.num_cells();
+		}
 
 		static std::string pmap_name() { return "OriTransMap< "+OriMap::pmap_name()+", "+TransMap::pmap_name()+" >"; }
 
@@ -134,7 +167,8 @@ namespace scheme { namespace nest { namespace pmap {
 
 template< int D, class V, class I, class F >
 std::ostream & operator << ( std::ostream & out, OriTransMap<D,V,I,F> const & otm ){
-	out << "OriMap: " << otm.ori_map_ << std::endl;
+	if( otm.ori_type_ == OriMapType::Hecatonicosachoron ) out << "OriMap: " << otm.ori120_map_ << std::endl;
+	else                                                  out << "OriMap: " << otm.ori_map_    << std::endl;
 	out << "TransMap: " << otm.trans_map_ ;
 	return out;
 }
@@ -1,5 +1,5 @@
-#ifndef INCLUDED_scheme_nest_maps_HecatonicosachoronMap_HH
-#define INCLUDED_scheme_nest_maps_HecatonicosachoronMap_HH
+#ifndef INCLUDED_scheme_nest_maps_TetracontoctachoronMap_HH
+#define INCLUDED_scheme_nest_maps_TetracontoctachoronMap_HH
 
 #include "scheme/numeric/geom_4d.hh"
 
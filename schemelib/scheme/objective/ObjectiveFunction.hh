@@ -12,6 +12,7 @@
 // #include <boost/mpl/inserter.hpp>
 // #include <boost/mpl/insert.hpp>
 #include <boost/mpl/for_each.hpp>
+#include <boost/mpl/count_if.hpp>
 // #include <boost/mpl/copy.hpp>
 // #include <boost/mpl/copy_if.hpp>
 #include <boost/mpl/transform.hpp>
@@ -178,9 +179,51 @@ namespace impl {
 	using m::false_;
 	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(DefinesInteractionWeight,false_)
 	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(UseVisitor,false_)
+	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(VisitBatch,false_)
+	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(BatchPairs,false_)
 	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(HasPre,false_)
 	SCHEME_MEMBER_TYPE_DEFAULT_TEMPLATE(HasPost,false_)
 
+	struct objective_has_batch_pairs { template<class Objective> struct apply : get_BatchPairs_false_<Objective>::type {}; };
+
+	///@brief true if every objective for an Interaction can score whole containers at once
+	template<class Objectives>
+	struct all_batch_pairs : m::bool_<
+		m::count_if<Objectives,objective_has_batch_pairs>::value == m::size<Objectives>::value > {};
+
+	///@brief helper functor to call objective.batch( container1, container2, rel_pos, config ),
+	///       which scores every pair of actors from the two containers in one call
+	template<
+		class Container1,
+		class Container2,
+		class Position,
+		class Results,
+		class Config
+	>
+	struct EvalObjectiveBatch {
+		Container1 const & container_1;
+		Container2 const & container_2;
+		Position const & rel_pos;
+		Results & results;
+		Config const & config;
+		double weight;
+		EvalObjectiveBatch(
+			Container1 const & c1,
+			Container2 const & c2,
+			Position const & x,
+			Results & r,
+			Config const & c,
+			double w
+		) : container_1(c1),container_2(c2),rel_pos(x),results(r),config(c),weight(w) {}
+
+		template<class Objective>
+		void
+		operator()(Objective const & objective) const {
+			BOOST_STATIC_ASSERT(( f::result_of::has_key<typename Results::FusionType,Objective>::value ));
+			results.template get<Objective>() += weight*objective.batch( container_1, container_2, rel_pos, config );
+		}
+	};
+
 	template<class InteractionSource, class Placeholder>
 	typename boost::disable_if<typename get_DefinesInteractionWeight_false_<InteractionSource>::type,double>::type
 	get_interaction_weight(InteractionSource const & , Placeholder const & ){
@@ -480,6 +523,61 @@ namespace impl {
 	};
 
 
+	///@brief visitor for InteractionSource::visit_batch, gets whole containers of the two
+	///       actor types and their relative position instead of one pair of actors at a time
+	template<
+		class _Interaction,
+		class Objectives,
+		class Results,
+		class Config
+	>
+	struct ObjectivesBatchVisitor {
+
+		typedef _Interaction Interaction;
+
+		Objectives const & objectives_;
+		Results & results_;
+		Config const & config_;
+
+		ObjectivesBatchVisitor(
+			Objectives const & o,
+			Results & r,
+			Config const & c
+		) : objectives_(o), results_(r), config_(c){}
+
+		template<class Container1, class Container2, class Position>
+		void
+		operator()( Container1 const & c1, Container2 const & c2, Position const & rel_pos, double weight ) {
+			f::for_each(
+				objectives_,
+				EvalObjectiveBatch< Container1, Container2, Position, Results, Config >
+					         ( c1, c2, rel_pos, results_, config_, weight )
+			);
+		}
+	};
+
+	template< class Interaction, class Objectives, class InteractionSource, class Results, class Scratches, class Config >
+	typename boost::disable_if< m::and_<
+			typename get_VisitBatch_false_<InteractionSource>::type,
+			util::meta::is_pair<Interaction>,
+			all_batch_pairs<Objectives>
+		> >::type
+	visit_objectives( InteractionSource const & source, Objectives const & objectives, Results & results, Scratches & scratches, Config const & config ){
+		ObjectivesVisitor<Interaction,Objectives,Results,Scratches,Config> visitor(objectives,results,scratches,config);
+		source.visit(visitor);
+	}
+
+	template< class Interaction, class Objectives, class InteractionSource, class Results, class Scratches, class Config >
+	typename boost::enable_if< m::and_<
+			typename get_VisitBatch_false_<InteractionSource>::type,
+			util::meta::is_pair<Interaction>,
+			all_batch_pairs<Objectives>
+		> >::type
+	visit_objectives( InteractionSource const & source, Objectives const & objectives, Results & results, Scratches &, Config const & config ){
+		ObjectivesBatchVisitor<Interaction,Objectives,Results,Config> visitor(objectives,results,config);
+		source.visit_batch(visitor);
+	}
+
 	// this EvalObjectives is for using the Visitor method instead of iteration, faster but requires support in the InteractionSource object
 	template<
 		class InteractionSource,
@@ -521,8 +619,7 @@ namespace impl {
 			#endif
 			typedef typename f::result_of::value_at_key<ObjectiveMap,Interaction>::type Objectives;
 			Objectives const & objectives = objective_map_.template get<Interaction>();
-			ObjectivesVisitor<Interaction,Objectives,Results,Scratches,Config> visitor(objectives,results_,scratches_,config_);
-			interaction_source_.visit(visitor);
+			visit_objectives<Interaction>( interaction_source_, objectives, results_, scratches_, config_ );
 		}
 
 	};
@@ -78,6 +78,50 @@ TEST( XformMap, stores_correctly ){
 
 }
 
+TEST( XformMap, occupancy_filter ){
+	int NSAMP = 100000;
+
+	std::mt19937 rng((unsigned int)time(0) + 98123467);
+	std::uniform_real_distribution<> runif;
+
+	XformMap< Xform, double> xmap( 0.5, 10.0 );
+	std::vector< std::pair<Xform,double> > dat;
+	for(int i = 0; i < NSAMP; ++i){
+		Xform x;
+		numeric::rand_xform( rng, x, 256.0 );
+		double val = runif(rng) + 1.0;
+		xmap.insert(x,val);
+		dat.push_back( std::make_pair(x,val) );
+	}
+	ASSERT_FALSE( xmap.has_occupancy_filter() );
+	xmap.build_occupancy_filter();
+	ASSERT_TRUE( xmap.has_occupancy_filter() );
+
+	// inserts after the build must still be found
+	Xform xlate;
+	numeric::rand_xform( rng, xlate, 256.0 );
+	xmap.insert( xlate, 7.0 );
+	dat.push_back( std::make_pair(xlate,7.0) );
+
+	XformMap< Xform, double > const & xmap_test( xmap );
+	for(int i = 0; i < dat.size(); ++i){
+		ASSERT_EQ( xmap_test[dat[i].first], dat[i].second );
+	}
+
+	int nmiss = 0, nfalse = 0;
+	for(int i = 0; i < NSAMP; ++i){
+		Xform x;
+		numeric::rand_xform( rng, x, 256.0 );
+		uint64_t k = xmap.get_key(x);
+		if( xmap.map_.find(k) != xmap.map_.end() ) continue;
+		++nmiss;
+		ASSERT_EQ( xmap_test[k], 0.0 );
+		nfalse += xmap.occupancy_.maybe_contains(k);
+	}
+	cout << "XformMap occupancy filter false positive rate: " << (double)nfalse/nmiss << endl;
+	ASSERT_LT( (double)nfalse/nmiss, 0.05 );
+}
+
 double get_ident_lever_dis( Xform x, double lever_dis ){
 	util::SimpleArray<7,double> x_lever_coord;
 	x_lever_coord[0] = x.translation()[0];
@@ -3,6 +3,7 @@
 
 // #include "scheme/util/SimpleArray.hh"
 #include "scheme/util/dilated_int.hh"
+#include "scheme/util/BlockedBloomFilter.hh"
 #include "scheme/numeric/FixedPoint.hh"
 #include "scheme/nest/pmap/TetracontoctachoronMap.hh"
 #include "scheme/numeric/bcc_lattice.hh"
@@ -64,6 +65,7 @@ struct XformMap {
     typedef google::dense_hash_map<Key,Value> Map;
     Hasher hasher_;
     Map map_;
+	util::BlockedBloomFilter occupancy_; // optional, lets operator[] skip most map probes that would miss
 	ElementSerializer element_serializer_;
     Float cart_resl_, ang_resl_, cart_bound_;
 	// #ifdef USE_OPENMP
@@ -94,9 +96,20 @@ struct XformMap {
 		// #endif
 	}
 
-	void clear() { map_.clear(); }
+	void clear() { map_.clear(); occupancy_.clear(); }
+
+	// build after the map is filled (or loaded); later inserts keep it valid
+	void build_occupancy_filter( float bits_per_key=16.0 ){
+		occupancy_.init( map_.size(), bits_per_key );
+		for(typename Map::const_iterator i = map_.begin(); i != map_.end(); ++i){
+			occupancy_.insert( i->first );
+		}
+	}
+	void clear_occupancy_filter() { occupancy_.clear(); }
+	bool has_occupancy_filter() const { return !occupancy_.empty(); }
 
 	bool insert( Key k, Value val ){
+		if( !occupancy_.empty() ) occupancy_.insert( k );
 		map_.insert( std::make_pair(k,val) );
 		return true;
 		// Key k0 = k >> ArrayBits;
@@ -118,6 +131,7 @@ struct XformMap {
 		Key k = hasher_.get_key( x );
 		typename Map::iterator i = map_.find( k );
 		if( i == map_.end() ){
+			if( !occupancy_.empty() ) occupancy_.insert( k );
 			map_.insert( std::make_pair(k,val) );
 		} else {
 			i->second = std::min( i->second, val );
@@ -130,6 +144,7 @@ struct XformMap {
 		// typename Map::const_iterator iter = map_.find(k0);
 		// if( iter == map_.end() ){ return Value(); }
 		// return iter->second[k1];
+		if( !occupancy_.empty() && !occupancy_.maybe_contains(k) ){ return Value(); }
 		typename Map::const_iterator iter = map_.find(k);
 		if( iter == map_.end() ){ return Value(); }
 		return iter->second;
@@ -199,7 +214,7 @@ struct XformMap {
 	size_t size() const { return map_.size(); }//*(1<<ArrayBits); }
 	// size_t total_size() const { return map_.size(); }//*(1<<ArrayBits); }
 
-	size_t mem_use() const { return map_.bucket_count()*(sizeof(Key)+sizeof(Value)); } //*sizeof(ValArray); }
+	size_t mem_use() const { return map_.bucket_count()*(sizeof(Key)+sizeof(Value)) + occupancy_.mem_use(); } //*sizeof(ValArray); }
 
 	size_t count( Value val ) const {
 		// int count = 0;
@@ -311,6 +326,7 @@ struct XformMap {
 		cart_bound_ = cart_bound;
 		hasher_.init( cart_resl_, ang_resl_, cart_bound_ );
 
+		occupancy_.clear();
 		if( ! map_.unserialize( element_serializer_, &in ) ){
 			std::cerr << "XfromMap::load failed to unserialize sparsehash" << std::endl;
 			return false;
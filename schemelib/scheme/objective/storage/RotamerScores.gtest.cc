@@ -32,6 +32,16 @@ TEST( RotamerScore, test_RotamerScore ){
 	}
 }
 
+TEST( RotamerScore, min_score_is_floor ){
+	ASSERT_FLOAT_EQ( RotamerScore<>::min_score(), 127.0/-13.0 );
+	for( int sd = 0; sd < 128; ++sd ){
+		RotamerScore<> rs( 0 );
+		rs.set_score_data( sd );
+		ASSERT_GE( rs.score(), RotamerScore<>::min_score() );
+		if( sd == 127 ) ASSERT_FLOAT_EQ( rs.score(), RotamerScore<>::min_score() );
+	}
+}
+
 TEST( RotamerScores, test_store_1 ){
 	ASSERT_EQ( sizeof( RotamerScores<1> ) , 2 );
 
@@ -46,6 +46,8 @@ struct RotamerScore {
 	void  set_score_data( Data sd ){ assert(sd < (one<<ScoreBits)); data_ = rotamer() | ( sd << RotamerBits ); }
 	Data  get_score_data() const { return data_ >> RotamerBits; }
 	static float divisor() { return _Divisor; }
+	///@brief lowest score this encoding can store, a floor for any lookup
+	static float min_score() { return data2float( ( one << ScoreBits ) - one ); }
 
 	static float data2float( Data data ){ return float(data)/_Divisor; }
 	static Data  float2data( float f ){ return Data( f*_Divisor ); }
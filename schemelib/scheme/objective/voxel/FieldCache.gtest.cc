@@ -108,6 +108,23 @@ TEST(BoundingFieldCache,test_bounding_ellipse_max){
 	}
 }
 
+// the voxel-parallel fill must give exactly what the old serial sweep did
+TEST(BoundingFieldCache,test_matches_serial_sweep){
+	typedef util::SimpleArray<3,double> F3;
+	Ellipse3D field(1,2,3,4,5,6);
+	FieldCache3D<double> f1(field,-11,13,0.824234);
+	BoundingFieldCache3D<double,AggMax> bf1(f1,2.873,1.234);
+	BoundingFieldCache3D<double,AggMax> serial(f1,2.873,1.234,"",true);
+	for(size_t i = 0; i < serial.num_elements(); ++i) serial.data()[i] = 0;
+	for(double h = serial.lb_[2]+serial.cs_[2]/2.0; h < serial.ub_[2]+serial.cs_[2]/2.0; h += serial.cs_[2]){
+	for(double g = serial.lb_[1]+serial.cs_[1]/2.0; g < serial.ub_[1]+serial.cs_[1]/2.0; g += serial.cs_[1]){
+	for(double f = serial.lb_[0]+serial.cs_[0]/2.0; f < serial.ub_[0]+serial.cs_[0]/2.0; f += serial.cs_[0]){
+		serial[ F3(f,g,h) ] = serial.calc_agg_val( f1, 2.873, F3(f,g,h) );
+	}}}
+	ASSERT_EQ( serial.num_elements(), bf1.num_elements() );
+	for(size_t i = 0; i < serial.num_elements(); ++i) ASSERT_EQ( serial.data()[i], bf1.data()[i] );
+}
+
 struct Delta : Field3D<double> {
 	double operator()(double f, double g, double h) const { 
 		if( fabs(f) < 0.1 && fabs(g) < 0.1 && fabs(h) < 0.1 ) return 1.0;
@@ -6,6 +6,7 @@
 #include "scheme/io/cache.hh"
 // #include <boost/exception/all.hpp>
 #include <exception>
+#include <vector>
 
 namespace scheme { namespace objective { namespace voxel {
 
@@ -177,13 +178,24 @@ struct BoundingFieldCache3D : public VoxelArray<3,Float,Float> {
 			}
 		#endif
 		if( !no_init ){
-			// size_t ncalls = 0;
-			for(Float h = this->lb_[2]+this->cs_[2]/2.0; h < this->ub_[2]+this->cs_[2]/2.0; h += this->cs_[2]){
-			for(Float g = this->lb_[1]+this->cs_[1]/2.0; g < this->ub_[1]+this->cs_[1]/2.0; g += this->cs_[1]){
-			for(Float f = this->lb_[0]+this->cs_[0]/2.0; f < this->ub_[0]+this->cs_[0]/2.0; f += this->cs_[0]){
-				// ++ncalls;
-				this->operator[]( Float3(f,g,h) ) = calc_agg_val( ref, spread, Float3(f,g,h) );
-			}}}
+			// centers are stepped out per axis exactly as the old serial f/g/h sweep did,
+			// so the grid is identical regardless of thread count. voxels are independent,
+			// calc_agg_val only reads ref. nested parallelism is off, so this only spreads
+			// over threads when constructed outside a parallel region
+			std::vector<Float> cen[BASE::DIM];
+			for(size_t d = 0; d < BASE::DIM; ++d){
+				for(Float x = this->lb_[d]+this->cs_[d]/2.0; x < this->ub_[d]+this->cs_[d]/2.0; x += this->cs_[d]){
+					cen[d].push_back(x);
+				}
+			}
+			int64_t const nf = cen[0].size(), ng = cen[1].size(), nh = cen[2].size();
+			#ifdef USE_OPENMP
+			#pragma omp parallel for schedule(dynamic,256)
+			#endif
+			for(int64_t i = 0; i < nf*ng*nh; ++i){
+				Float3 const f3( cen[0][i%nf], cen[1][i/nf%ng], cen[2][i/nf/ng] );
+				this->operator[]( f3 ) = calc_agg_val( ref, spread, f3 );
+			}
 		}
 		#ifdef CEREAL
 			io::write_cache(cache_loc,*this);
@@ -63,6 +63,28 @@ TEST(VoxelArray,bounds3d){
 
 }
 
+TEST(VoxelArray,sum_at_matches_at){
+	typedef util::SimpleArray<3,float> F3;
+	VoxelArray<3,float,float> a3( F3(-1,-2,-3), F3(1,2,3), 0.49 );
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float> val(-1,1), coord(-4,4);
+	for( size_t i = 0; i < a3.num_elements(); ++i ) a3.data()[i] = val(rng);
+	std::vector<float> x, y, z;
+	float sum = 0, possum = 0;
+	for( int i = 0; i < 1000; ++i ){
+		x.push_back( coord(rng) ); y.push_back( coord(rng) ); z.push_back( coord(rng) );
+		sum += a3.at( x.back(), y.back(), z.back() );
+		possum += std::max( 0.0f, a3.at( x.back(), y.back(), z.back() ) );
+	}
+	// just under the lower bound still lands in the first cell, like at()
+	x.push_back( -1.1 ); y.push_back( -2.1 ); z.push_back( -3.1 );
+	sum += a3.at( -1.1, -2.1, -3.1 );
+	possum += std::max( 0.0f, a3.at( -1.1, -2.1, -3.1 ) );
+	ASSERT_NE( a3.at( -1.1, -2.1, -3.1 ), 0 );
+	ASSERT_NEAR( a3.sum_at( x.data(), y.data(), z.data(), x.size() ), sum, 1e-3 );
+	ASSERT_NEAR( a3.sum_at( x.data(), y.data(), z.data(), x.size(), true ), possum, 1e-3 );
+}
+
 TEST(VoxelArray,io){
 	std::mt19937 rng((unsigned int)time(0));
 	std::uniform_real_distribution<> uniform;
@@ -91,5 +113,29 @@ TEST(VoxelArray,io){
 
 }
 
+TEST(VoxelArray,bulk_io){
+	std::mt19937 rng((unsigned int)time(0));
+	std::uniform_real_distribution<> uniform;
+
+	VoxelArray<3,float,float> a(-6,7,0.6345);
+	for(size_t i = 0; i < a.num_elements(); ++i) a.data()[i] = uniform(rng);
+
+	std::string const fname = "/tmp/scheme_VoxelArray_bulk_io_test.bin";
+	ASSERT_TRUE( a.save_bulk( fname, 7 ) );
+
+	VoxelArray<3,float,float> b;
+	ASSERT_TRUE( b.load_bulk( fname, 7 ) );
+	ASSERT_TRUE( a == b );
+
+	VoxelArray<3,float,float> c(0,1,0.5);
+	ASSERT_FALSE( c.load_bulk( fname, 8 ) ); // wrong tag
+	VoxelArray<3,double,double> d(0,1,0.5);
+	ASSERT_FALSE( d.load_bulk( fname, 7 ) ); // wrong value type
+	ASSERT_FALSE( c.load_bulk( fname + ".missing", 7 ) );
+	ASSERT_EQ( c.num_elements(), 27u );
+
+	std::remove( fname.c_str() );
+}
+
 
 }}}}
@@ -6,8 +6,11 @@
 #include <boost/type_traits.hpp>
 #include <boost/assert.hpp>
 #include <scheme/util/assert.hh>
+#include <scheme/io/BulkArrayFile.hh>
 
 #include <boost/format.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
 #include <random>
@@ -86,6 +89,28 @@ struct VoxelArray : boost::multi_array<_Value,_DIM> {
 		else return Value(0);
 	}
 
+	///@brief sum of at() over n points given as separate x, y and z arrays, out of bounds
+	///       points count 0 exactly like at(). branch free so the loop can vectorize.
+	///       if positive_only, negative values are counted as 0
+	Value sum_at( Float const * x, Float const * y, Float const * z, size_t n, bool positive_only = false ) const {
+		BOOST_STATIC_ASSERT(( DIM == 3 ));
+		Float const lb0 = lb_[0], lb1 = lb_[1], lb2 = lb_[2];
+		Float const cs0 = cs_[0], cs1 = cs_[1], cs2 = cs_[2];
+		// at() truncates toward zero, so (-1,0) lands in cell 0 too
+		Float const n0 = this->shape()[0], n1 = this->shape()[1], n2 = this->shape()[2];
+		int64_t const s0 = this->strides()[0], s1 = this->strides()[1], s2 = this->strides()[2];
+		Value const * data = this->data();
+		Value sum = 0;
+		for( size_t i = 0; i < n; ++i ){
+			Float const f = (x[i]-lb0)/cs0, g = (y[i]-lb1)/cs1, h = (z[i]-lb2)/cs2;
+			bool const in = f > -1 && f < n0 && g > -1 && g < n1 && h > -1 && h < n2;
+			int64_t const idx = in ? (int64_t)f*s0 + (int64_t)g*s1 + (int64_t)h*s2 : 0;
+			Value const v = in ? data[idx] : Value(0);
+			sum += positive_only ? std::max( Value(0), v ) : v;
+		}
+		return sum;
+	}
+
 	// void write(std::ostream & out) const {
 	// 	out.write( (char const*)&lb_, sizeof(Bounds) );
 	// 	out.write( (char const*)&ub_, sizeof(Bounds) );
@@ -157,7 +182,73 @@ struct VoxelArray : boost::multi_array<_Value,_DIM> {
     }
     // BOOST_SERIALIZATION_SPLIT_MEMBER()
 
+    /// @brief uncompressed save in io::BulkArrayFile format, geometry block then raw values
+    /// @detail the file is written to a temp name and renamed, so processes sharing a cache
+    ///         directory never see a partial file. load_bulk maps it and copies out in
+    ///         parallel, so many processes loading the same grid mostly hit the page cache
+    bool save_bulk( std::string const & fname, uint64_t tag = 0 ) const {
+    	BOOST_VERIFY( boost::is_pod<Value>::type::value );
+        size_t const nbytes = this->num_elements()*sizeof(Value);
+        std::vector<unsigned char> buf( bulk_prefix_bytes() + nbytes, 0 );
+        BulkGeometry geom = bulk_geometry();
+        std::memcpy( buf.data(), &geom, sizeof(BulkGeometry) );
+        if( nbytes ) std::memcpy( buf.data() + bulk_prefix_bytes(), this->data(), nbytes );
+        return io::write_bulk_array( fname, buf.data(), buf.size(), tag );
+    }
+    /// @brief false (and *this unchanged) if fname is missing, stale, truncated or
+    ///        holds a different kind of VoxelArray
+    bool load_bulk( std::string const & fname, uint64_t tag = 0, bool verify = true ){
+    	BOOST_VERIFY( boost::is_pod<Value>::type::value );
+        io::MappedBulkArray<unsigned char> mapped;
+        if( !mapped.open( fname, tag, verify ) ) return false;
+        if( mapped.size() < bulk_prefix_bytes() ) return false;
+        BulkGeometry geom;
+        std::memcpy( &geom, mapped.data(), sizeof(BulkGeometry) );
+        if( geom.dim != DIM || geom.float_size != sizeof(Float) || geom.value_size != sizeof(Value) ) return false;
+        Indices extents;
+        size_t nelem = 1;
+        for( size_t i = 0; i < DIM; ++i ){
+            extents[i] = geom.shape[i];
+            nelem *= geom.shape[i];
+        }
+        if( mapped.size() != bulk_prefix_bytes() + nelem*sizeof(Value) ) return false;
+        for( size_t i = 0; i < DIM; ++i ){
+            lb_[i] = geom.lb[i];
+            ub_[i] = geom.ub[i];
+            cs_[i] = geom.cs[i];
+        }
+        this->resize( extents );
+        io::bulk_array_impl::copy_and_checksum( this->data(), mapped.data() + bulk_prefix_bytes(), nelem*sizeof(Value), false );
+        return true;
+    }
+
+
+
+private:
+
+    struct BulkGeometry {
+        uint32_t dim, float_size, value_size, pad;
+        Float lb[DIM], ub[DIM], cs[DIM];
+        uint64_t shape[DIM];
+    };
+    // values start on a 64 byte boundary of the payload
+    static size_t bulk_prefix_bytes() { return ( sizeof(BulkGeometry) + 63 ) / 64 * 64; }
+    BulkGeometry bulk_geometry() const {
+        BulkGeometry geom;
+        std::memset( &geom, 0, sizeof(BulkGeometry) );
+        geom.dim = DIM;
+        geom.float_size = sizeof(Float);
+        geom.value_size = sizeof(Value);
+        for( size_t i = 0; i < DIM; ++i ){
+            geom.lb[i] = lb_[i];
+            geom.ub[i] = ub_[i];
+            geom.cs[i] = cs_[i];
+            geom.shape[i] = this->shape()[i];
+        }
+        return geom;
+    }
 
+public:
 
     void dump_pdb( std::string const & fname, Value threshold_value, bool higher_than_threshold, float fraction=1.0 ) {
         std::ofstream f( fname );
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "scheme/objective/voxel/VoxelLists.hh"
+
+#include <random>
+#include <set>
+
+namespace scheme { namespace objective { namespace voxel { namespace test_lists {
+
+typedef VoxelLists<uint16_t> Lists;
+typedef Lists::Bounds F3;
+
+std::vector<uint16_t> read_list( uint16_t const * it ){
+	std::vector<uint16_t> out;
+	while( *it != Lists::END ) out.push_back( *(it++) );
+	return out;
+}
+
+TEST( VoxelLists, shape_and_oob ){
+	Lists lists( F3(0,0,0), F3(2,3,4), F3(0.5,0.5,0.5) );
+	ASSERT_EQ( lists.shape()[0], 5 );
+	ASSERT_EQ( lists.shape()[1], 7 );
+	ASSERT_EQ( lists.shape()[2], 9 );
+	ASSERT_EQ( lists.cell_of( F3(2,3,4) ), lists.ncells()-1 );
+	ASSERT_EQ( lists.cell_of( F3(-1.1,0,0) ), lists.ncells() );
+	ASSERT_EQ( lists.cell_of( F3(0,0,4.6) ), lists.ncells() );
+
+	// before build everything is empty
+	ASSERT_EQ( *lists.at( F3(1,1,1) ), Lists::END );
+
+	lists.add_at( F3(1.1,1.1,1.1), 7 );
+	lists.build();
+	ASSERT_EQ( read_list( lists.at( 1.2f, 1.4f, 1.0f ) ), std::vector<uint16_t>{7} );
+	ASSERT_EQ( *lists.at( F3(100,0,0) ), Lists::END );
+	ASSERT_EQ( *lists.at( F3(-100,0,0) ), Lists::END );
+	ASSERT_EQ( lists.nvalues(), 1 );
+	ASSERT_EQ( lists.max_list_size(), 1 );
+}
+
+TEST( VoxelLists, matches_vector_of_vectors ){
+	Lists lists( F3(-5,-5,-5), F3(5,5,5), F3(0.5,0.5,0.5) );
+	std::vector< std::vector<uint16_t> > ref( lists.ncells() );
+	std::vector< std::set<uint16_t> > ref_set( lists.ncells() );
+	Lists uniq = lists;
+
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float> coord( -5, 5 );
+	for( int i = 0; i < 20000; ++i ){
+		F3 p( coord(rng), coord(rng), coord(rng) );
+		uint16_t v = i % 37;
+		size_t cell = lists.cell_of( p );
+		ASSERT_LT( cell, lists.ncells() );
+		lists.add( cell, v );
+		uniq.add( cell, v );
+		ref[cell].push_back( v );
+		ref_set[cell].insert( v );
+	}
+	lists.build();
+	uniq.build( true );
+
+	size_t maxsize = 0, total = 0;
+	for( size_t cell = 0; cell < lists.ncells(); ++cell ){
+		ASSERT_EQ( read_list( lists.list( cell ) ), ref[cell] );
+		ASSERT_EQ( lists.list_size( cell ), ref[cell].size() );
+		ASSERT_EQ( read_list( uniq.list( cell ) ), std::vector<uint16_t>( ref_set[cell].begin(), ref_set[cell].end() ) );
+		maxsize = std::max( maxsize, ref[cell].size() );
+		total += ref[cell].size();
+	}
+	ASSERT_EQ( lists.max_list_size(), maxsize );
+	ASSERT_EQ( lists.nvalues(), total );
+}
+
+}}}}
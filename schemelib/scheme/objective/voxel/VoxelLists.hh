@@ -0,0 +1,145 @@
+#ifndef INCLUDED_objective_voxel_VoxelLists_HH
+#define INCLUDED_objective_voxel_VoxelLists_HH
+
+#include "scheme/util/SimpleArray.hh"
+#include <scheme/util/assert.hh>
+
+#include <stdint.h>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace scheme { namespace objective { namespace voxel {
+
+
+// A 3D grid where every cell holds a short list of values (ids of nearby target atoms etc.)
+// stored compressed-sparse-row style: one offset per cell into a single flat value array.
+//
+// Every list is followed by END so callers can walk it without knowing its size:
+//   Value const * it = lists.at( xyz );
+//   while( *it != VoxelLists<Value>::END ) use( *(it++) );
+// Points outside the grid get an empty list.
+//
+// Fill with add() and then build() once. Values in a cell keep the order they were
+// added in (duplicates included) unless build( true ) is asked to sort and uniquify them.
+
+template< class _Value, class _Float=float >
+struct VoxelLists {
+	typedef _Value Value;
+	typedef _Float Float;
+	typedef util::SimpleArray<3,size_t> Indices;
+	typedef util::SimpleArray<3,Float> Bounds;
+
+	static Value const END = std::numeric_limits<Value>::max();
+
+	VoxelLists() : shape_(0), max_list_size_(0) { oob_[0] = END; }
+
+	template<class F1,class F2, class F3>
+	VoxelLists( F1 const & lb, F2 const & ub, F3 const & cs ) : max_list_size_(0) {
+		oob_[0] = END;
+		for( int i = 0; i < 3; ++i ){
+			lb_[i] = lb[i];
+			ub_[i] = ub[i];
+			cs_[i] = cs[i];
+		}
+		for( int i = 0; i < 3; ++i ) shape_[i] = size_t( (ub_[i]-lb_[i])/cs_[i] ) + 1; // pad by one
+	}
+
+	size_t ncells() const { return shape_[0] * shape_[1] * shape_[2]; }
+	Indices const & shape() const { return shape_; }
+	Bounds const & lb() const { return lb_; }
+	Bounds const & cs() const { return cs_; }
+
+	size_t index_to_cell( Indices const & ind ) const {
+		return ( ind[0] * shape_[1] + ind[1] ) * shape_[2] + ind[2];
+	}
+
+	// ncells() if outside the grid
+	template<class V>
+	size_t cell_of( V const & v ) const {
+		size_t cell = 0;
+		for( int i = 0; i < 3; ++i ){
+			int64_t idx = (Float)( v[i] - lb_[i] ) / cs_[i];
+			if( idx < 0 || idx >= (int64_t)shape_[i] ) return ncells();
+			cell = cell * shape_[i] + idx;
+		}
+		return cell;
+	}
+
+	Bounds cell_center( Indices const & idx ) const {
+		Bounds c;
+		for( int i = 0; i < 3; ++i ) c[i] = ( idx[i] + 0.5 )*cs_[i] + lb_[i];
+		return c;
+	}
+
+	void add( size_t cell, Value v ){
+		ALWAYS_ASSERT( cell < ncells() );
+		ALWAYS_ASSERT( v != END );
+		pending_.push_back( std::make_pair( (uint32_t)cell, v ) );
+	}
+
+	template<class V>
+	void add_at( V const & pos, Value v ){ add( cell_of( pos ), v ); }
+
+	// turn everything add()ed into the flat layout, counting sort on cell
+	void build( bool sort_unique = false ){
+		ALWAYS_ASSERT_MSG( offsets_.empty(), "VoxelLists::build called twice" );
+		if( sort_unique ){
+			std::sort( pending_.begin(), pending_.end() );
+			pending_.erase( std::unique( pending_.begin(), pending_.end() ), pending_.end() );
+		}
+		size_t const n = ncells();
+		ALWAYS_ASSERT( pending_.size() + n < std::numeric_limits<uint32_t>::max() );
+		std::vector<uint32_t> offsets( n+1, 0 );
+		for( auto const & p : pending_ ) ++offsets[ p.first + 1 ];
+		max_list_size_ = 0;
+		for( size_t i = 0; i < n; ++i ){
+			max_list_size_ = std::max<size_t>( max_list_size_, offsets[i+1] );
+			offsets[i+1] += offsets[i] + 1; // + 1 for END
+		}
+		std::vector<Value> values( pending_.size() + n, END );
+		std::vector<uint32_t> fill( offsets.begin(), offsets.end()-1 );
+		for( auto const & p : pending_ ) values[ fill[p.first]++ ] = p.second;
+
+		offsets_.swap( offsets );
+		values_.swap( values );
+		std::vector< std::pair<uint32_t,Value> >().swap( pending_ );
+	}
+
+	Value const * list( size_t cell ) const {
+		if( cell >= ncells() || offsets_.empty() ) return oob_;
+		return values_.data() + offsets_[cell];
+	}
+
+	size_t list_size( size_t cell ) const {
+		if( cell >= ncells() || offsets_.empty() ) return 0;
+		return offsets_[cell+1] - offsets_[cell] - 1;
+	}
+
+	template<class V>
+	Value const * at( V const & v ) const { return list( cell_of( v ) ); }
+
+	Value const * at( Float f, Float g, Float h ) const { return at( Bounds( f, g, h ) ); }
+
+	size_t max_list_size() const { return max_list_size_; }
+	size_t nvalues() const { return offsets_.empty() ? 0 : values_.size() - ncells(); }
+	size_t mem_use() const { return offsets_.size()*sizeof(uint32_t) + values_.size()*sizeof(Value); }
+
+	Bounds lb_, ub_, cs_;
+	Indices shape_;
+
+private:
+	std::vector<uint32_t> offsets_;
+	std::vector<Value> values_;
+	std::vector< std::pair<uint32_t,Value> > pending_;
+	size_t max_list_size_;
+	Value oob_[1];
+};
+
+template< class V, class F > V const VoxelLists<V,F>::END;
+
+
+}}}
+
+#endif
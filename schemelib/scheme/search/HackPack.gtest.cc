@@ -2,6 +2,8 @@
 
 #include <scheme/search/HackPack.hh>
 
+#include <random>
+
 
 namespace scheme { namespace search { namespace hptest {
 
@@ -20,4 +22,55 @@ TEST( HackPack, create_empty_packer ){
 
 }
 
+TEST( HackPack, pair_energies_delta_matches_full ){
+	typedef ::scheme::objective::storage::TwoBodyTable<float> TBT;
+	int const NRES = 4, NROT = 5;
+	shared_ptr<TBT> twob = make_shared<TBT>( NRES, NROT );
+	twob->init_onebody_filter( 1.0 );
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float> runif( -1, 1 );
+	for( int i = 0; i < NRES; ++i ){
+		for( int j = 0; j < i; ++j ){
+			twob->init_twobody( i, j );
+			for( int k = 0; k < twob->twobody_[i][j].num_elements(); ++k ) twob->twobody_[i][j].data()[k] = runif(rng);
+		}
+	}
+
+	HackPackOpts opts;
+	HackPack packer( opts, 0 );
+	packer.reinitialize( twob );
+	std::vector<int32_t> added;
+	for( int ires = 0; ires < NRES; ++ires ){
+		for( int irot = 1; irot < NROT; ++irot ){
+			int32_t k = packer.add_tmp_rot( ires, irot, runif(rng) );
+			ASSERT_GE( k, 0 );
+			ASSERT_EQ( packer.rot_list_[k].first, ires );
+			added.push_back( k );
+		}
+	}
+	ASSERT_EQ( packer.add_tmp_rot( 0, 1, 11.0f ), -1 );
+	for( int i = 0; i < 30; ++i ){
+		packer.add_pair_energy( added[ rng() % added.size() ], added[ rng() % added.size() ], 2*runif(rng) );
+	}
+	packer.index_pair_energies();
+
+	packer.assign_random_rots();
+	for( int trial = 0; trial < 200; ++trial ){
+		int32_t ires, irot;
+		packer.randrot_not_current_uniform_rot( ires, irot );
+		float const before = packer.compute_energy_full( packer.current_rots_ );
+		float const delta = packer.compute_energy_delta( packer.current_rots_, ires, irot );
+		packer.current_rots_[ires] = irot;
+		float const after = packer.compute_energy_full( packer.current_rots_ );
+		ASSERT_NEAR( after - before, delta, 0.0001 );
+	}
+
+	std::vector<std::pair<int32_t,int32_t> > result;
+	float score = packer.pack( result );
+	ASSERT_NEAR( score, packer.compute_energy_full( packer.global_best_rots_ ), 0.0001 );
+
+	packer.reinitialize( twob );
+	ASSERT_EQ( packer.pair_energies_.size(), 0 );
+}
+
 }}}
@@ -79,9 +79,19 @@ struct HackPack
 {
 	typedef std::pair<int32_t,float> RotInfo;
 	typedef std::pair< int32_t, std::vector< RotInfo > > RotInfos;
+	struct PairEnergy {
+		int32_t jlres, jlrot;
+		float e;
+		PairEnergy( int32_t r, int32_t o, float _e ) : jlres(r), jlrot(o), e(_e) {}
+	};
 	int nres_; // total res currently stored
 	std::vector< RotInfos > res_rots_; // iresapp + list of irottwob/onebody pairs
 	std::vector< std::pair<int32_t,int32_t> > rot_list_; // list of ireslocal / irotlocal pairs
+	std::vector< int32_t > res_first_rot_; // rot_list_ index of each local res's first rotamer
+	// pairwise energies on top of twob_ for this pack only (buried unsats etc), by rot_list_ index
+	std::vector< std::pair< std::pair<int32_t,int32_t>, float > > pair_energies_;
+	std::vector< int32_t > pair_offsets_; // per rot_list_ entry into pair_entries_, built in pack()
+	std::vector< PairEnergy > pair_entries_;
 	std::vector< int32_t > current_rots_, trial_best_rots_, global_best_rots_; // current rotamer in local numbering
 	std::mt19937 rng;
 	shared_ptr<::scheme::objective::storage::TwoBodyTable<float>> twob_; 
@@ -123,6 +133,9 @@ struct HackPack
 			rotinfos.second.clear();
 		}
 		nres_ = 0;
+		pair_energies_.clear();
+		pair_offsets_.clear();
+		pair_entries_.clear();
 	}
 	template< class Int >
 	bool using_rotamer( Int const & ires, Int const & irotglobal )
@@ -131,8 +144,9 @@ struct HackPack
 		ALWAYS_ASSERT( 0 <= irotglobal && irotglobal < twob_->all2sel_.shape()[1] );
 		return twob_->all2sel_[ires][irotglobal] >= 0;
 	}
+	// returns the rot_list_ index of the new rotamer, -1 if it wasn't added
 	template< class Int >
-	void add_tmp_rot( int const & ires, Int const & irotglobal, float const & onebody_e, bool allow_high_energy=false )
+	int32_t add_tmp_rot( int const & ires, Int const & irotglobal, float const & onebody_e, bool allow_high_energy=false )
 	{
 		// #pragma omp critical
 		// {
@@ -140,7 +154,7 @@ struct HackPack
 		// 	print_rot_info();
 		// }
 		if( onebody_e > 10.0 && ! allow_high_energy ){
-			return;
+			return -1;
 		}
 		ALWAYS_ASSERT( 0 <= ires && ires < twob_->all2sel_.shape()[0] );
 		ALWAYS_ASSERT( 0 <= irotglobal && irotglobal < twob_->all2sel_.shape()[1] );
@@ -150,7 +164,9 @@ struct HackPack
 			if( nres_==0 || res_rots_.at(nres_-1).first != ires ){
 				++nres_;
 				if( res_rots_.size() < nres_ ) res_rots_.resize( nres_ );
+				if( res_first_rot_.size() < nres_ ) res_first_rot_.resize( nres_ );
 				res_rots_.at(nres_-1).first = ires;
+				res_first_rot_.at(nres_-1) = rot_list_.size();
 				// always allow ALA as an option:
 				int alarot = twob_->all2sel_[ires][ default_rot_num_ ];
 				if( alarot >= 0 ) {
@@ -160,6 +176,7 @@ struct HackPack
 			}
 			rot_list_.push_back( std::make_pair( nres_-1, res_rots_.at(nres_-1).second.size() ) );
 			res_rots_.at(nres_-1).second.push_back( RotInfo( irotlocal, onebody_e ) );
+			return rot_list_.size()-1;
 		} else {
 			// std::cout << "Error!!!: Rotamer not in twobody energies " << irotglobal << " " << ires << std::endl;
 			// static bool missingrotwarn = true;
@@ -175,6 +192,49 @@ struct HackPack
 			// 	}
 			// }
 		}
+		return -1;
+	}
+
+	// Extra energy when the two rotamers (rot_list_ indices from add_tmp_rot) are both chosen.
+	//  Only lives until the next reinitialize(), the twobody table is never touched.
+	void add_pair_energy( int32_t irot_list, int32_t jrot_list, float e )
+	{
+		ALWAYS_ASSERT( 0 <= irot_list && irot_list < rot_list_.size() );
+		ALWAYS_ASSERT( 0 <= jrot_list && jrot_list < rot_list_.size() );
+		if( rot_list_[irot_list].first == rot_list_[jrot_list].first ) return; // same res, never both chosen
+		pair_energies_.push_back( std::make_pair( std::make_pair( irot_list, jrot_list ), e ) );
+	}
+
+	// so compute_energy_delta only visits the pair energies of the rotamers being swapped
+	void index_pair_energies()
+	{
+		pair_offsets_.clear();
+		pair_entries_.clear();
+		if( pair_energies_.empty() ) return;
+		pair_offsets_.resize( rot_list_.size()+1, 0 );
+		for( auto const & pe : pair_energies_ ){
+			++pair_offsets_[ pe.first.first +1 ];
+			++pair_offsets_[ pe.first.second+1 ];
+		}
+		for( int k = 0; k < rot_list_.size(); ++k ) pair_offsets_[k+1] += pair_offsets_[k];
+		pair_entries_.resize( pair_offsets_.back(), PairEnergy( 0, 0, 0 ) );
+		std::vector< int32_t > fill( pair_offsets_.begin(), pair_offsets_.end()-1 );
+		for( auto const & pe : pair_energies_ ){
+			int32_t const k1 = pe.first.first, k2 = pe.first.second;
+			pair_entries_[ fill[k1]++ ] = PairEnergy( rot_list_[k2].first, rot_list_[k2].second, pe.second );
+			pair_entries_[ fill[k2]++ ] = PairEnergy( rot_list_[k1].first, rot_list_[k1].second, pe.second );
+		}
+	}
+
+	float
+	pair_energy_of( std::vector< int32_t > const & rots, int32_t ilres, int32_t ilrot ) const {
+		float e = 0;
+		int32_t const k = res_first_rot_[ilres] + ilrot;
+		for( int32_t p = pair_offsets_[k]; p < pair_offsets_[k+1]; ++p ){
+			PairEnergy const & pe = pair_entries_[p];
+			if( rots[pe.jlres] == pe.jlrot ) e += pe.e;
+		}
+		return e;
 	}
 
 
@@ -221,6 +281,11 @@ struct HackPack
 					//           << F(7,3,twobodye) << std::endl;
 			}
 		}
+		for( auto const & pe : pair_energies_ ){
+			std::pair<int32_t,int32_t> const & irot = rot_list_[ pe.first.first  ];
+			std::pair<int32_t,int32_t> const & jrot = rot_list_[ pe.first.second ];
+			if( rots.at(irot.first) == irot.second && rots.at(jrot.first) == jrot.second ) score += pe.second;
+		}
 		return score;
 	}
 	float
@@ -257,6 +322,10 @@ struct HackPack
 			//           << " e " << F(7,3,twobodyeold)  << " " << F(7,3,twobodyenew)
 			//           << std::endl;
 		}
+		if( pair_offsets_.size() ){
+			delta -= pair_energy_of( rots, ilres, ilrotold );
+			delta += pair_energy_of( rots, ilres, ilrotnew );
+		}
 		if( -123460.0 > delta || delta > 123460.0 ){ // 10x energy cap per-rottable entry
 			bool throwerr = false;
 			#ifdef USE_OPENMP
@@ -410,6 +479,7 @@ struct HackPack
 		}
 
 		assign_initial_rots();
+		index_pair_energies();
 
 		uint64_t nchoices = 1;
 		for( int ires = 0; ires < nres_; ++ires ){
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "scheme/util/BlockedBloomFilter.hh"
+
+#include <random>
+#include <set>
+
+namespace scheme {
+namespace util {
+namespace bbf_test {
+
+using std::cout;
+using std::endl;
+
+TEST( BlockedBloomFilter, no_false_negatives ){
+	std::mt19937_64 rng(0);
+	BlockedBloomFilter filter( 100000, 16.0 );
+	std::vector<uint64_t> keys;
+	for( int i = 0; i < 100000; ++i ){
+		keys.push_back( rng() );
+		filter.insert( keys.back() );
+	}
+	for( size_t i = 0; i < keys.size(); ++i ){
+		ASSERT_TRUE( filter.maybe_contains( keys[i] ) );
+	}
+}
+
+TEST( BlockedBloomFilter, false_positive_rate ){
+	std::mt19937_64 rng(0);
+	int const NKEY = 100000, NTEST = 1000000;
+	BlockedBloomFilter filter( NKEY, 16.0 );
+	std::set<uint64_t> keys;
+	// sequential keys, similar to dense regions of XformHash keys
+	for( uint64_t i = 0; i < NKEY; ++i ){
+		keys.insert( i*3 );
+		filter.insert( i*3 );
+	}
+	int nfalse = 0, ntest = 0;
+	for( int i = 0; i < NTEST; ++i ){
+		uint64_t k = rng() % ( NKEY*6 );
+		if( keys.count(k) ) continue;
+		++ntest;
+		nfalse += filter.maybe_contains(k);
+	}
+	double fpr = (double)nfalse / ntest;
+	cout << "BlockedBloomFilter 16 bits/key false positive rate: " << fpr << " fill: " << filter.fill_fraction() << endl;
+	ASSERT_LT( fpr, 0.02 );
+}
+
+TEST( BlockedBloomFilter, empty_and_clear ){
+	BlockedBloomFilter filter;
+	ASSERT_TRUE( filter.empty() );
+	filter.init( 10 );
+	ASSERT_FALSE( filter.empty() );
+	ASSERT_FALSE( filter.maybe_contains( 12345 ) );
+	filter.insert( 12345 );
+	ASSERT_TRUE( filter.maybe_contains( 12345 ) );
+	filter.clear();
+	ASSERT_TRUE( filter.empty() );
+	ASSERT_EQ( filter.mem_use(), 0 );
+}
+
+}
+}
+}
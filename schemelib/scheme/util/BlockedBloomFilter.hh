@@ -0,0 +1,104 @@
+#ifndef INCLUDED_scheme_util_BlockedBloomFilter_HH
+#define INCLUDED_scheme_util_BlockedBloomFilter_HH
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace scheme {
+namespace util {
+
+/// @brief split-block bloom filter over 64bit keys
+/// @detail every key maps to one 256-bit block and sets one bit in each of the
+///         block's eight 32-bit words, so a query touches a single block of
+///         memory. meant to answer "definitely not present" for lookups into
+///         big hash tables (like XformMap) without probing the table itself.
+///         no false negatives; false positive rate ~0.1-0.2% at 16 bits per key
+class BlockedBloomFilter {
+public:
+	static int const WORDS_PER_BLOCK = 8;
+
+	BlockedBloomFilter() : nblocks_(0) {}
+
+	BlockedBloomFilter( size_t nkeys, float bits_per_key=16.0 ) : nblocks_(0) {
+		init( nkeys, bits_per_key );
+	}
+
+	void init( size_t nkeys, float bits_per_key=16.0 ){
+		size_t nbits = (size_t)std::ceil( std::max<float>( 1.0, nkeys ) * std::max<float>( 1.0, bits_per_key ) );
+		nblocks_ = std::max<size_t>( 1, ( nbits + 32*WORDS_PER_BLOCK - 1 ) / ( 32*WORDS_PER_BLOCK ) );
+		words_.assign( nblocks_ * WORDS_PER_BLOCK, 0 );
+	}
+
+	void clear() {
+		nblocks_ = 0;
+		words_.clear();
+		words_.shrink_to_fit();
+	}
+
+	bool empty() const { return nblocks_ == 0; }
+
+	void insert( uint64_t key ){
+		uint64_t const h = mix( key );
+		uint32_t * block = &words_[ block_index(h) * WORDS_PER_BLOCK ];
+		uint32_t const lo = (uint32_t)h;
+		for( int i = 0; i < WORDS_PER_BLOCK; ++i ){
+			block[i] |= mask_bit( lo, i );
+		}
+	}
+
+	/// @brief false means key was never inserted, true means it may have been
+	bool maybe_contains( uint64_t key ) const {
+		uint64_t const h = mix( key );
+		uint32_t const * block = &words_[ block_index(h) * WORDS_PER_BLOCK ];
+		uint32_t const lo = (uint32_t)h;
+		for( int i = 0; i < WORDS_PER_BLOCK; ++i ){
+			if( !( block[i] & mask_bit( lo, i ) ) ) return false;
+		}
+		return true;
+	}
+
+	size_t num_blocks() const { return nblocks_; }
+	size_t mem_use() const { return words_.size() * sizeof(uint32_t); }
+
+	/// @brief fraction of bits set, for diagnostics
+	double fill_fraction() const {
+		if( words_.empty() ) return 0.0;
+		size_t nset = 0;
+		for( size_t i = 0; i < words_.size(); ++i ) nset += __builtin_popcount( words_[i] );
+		return (double)nset / ( 32.0 * words_.size() );
+	}
+
+private:
+
+	// murmur3 fmix64, keys from XformHash are highly structured so must be scrambled
+	static uint64_t mix( uint64_t k ){
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdllu;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53llu;
+		k ^= k >> 33;
+		return k;
+	}
+
+	// multiply-shift range reduction on the high 32 bits
+	size_t block_index( uint64_t h ) const {
+		return (size_t)( ( ( h >> 32 ) * (uint64_t)nblocks_ ) >> 32 );
+	}
+
+	static uint32_t mask_bit( uint32_t lo, int i ){
+		static uint32_t const SALT[WORDS_PER_BLOCK] = {
+			0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+			0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U };
+		return (uint32_t)1 << ( ( lo * SALT[i] ) >> 27 );
+	}
+
+	size_t nblocks_;
+	std::vector<uint32_t> words_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "scheme/util/FlatIndexSet.hh"
+
+#include <random>
+#include <unordered_map>
+
+namespace scheme {
+namespace util {
+namespace flat_index_set_test {
+
+TEST( FlatIndexSet, matches_unordered_map ){
+	std::mt19937_64 rng(0);
+	FlatIndexSet<uint64_t> set;
+	std::unordered_map<uint64_t,size_t> ref;
+	for( int i = 0; i < 200000; ++i ){
+		uint64_t key = rng() % 50000;
+		std::pair<size_t,bool> r = set.insert( key );
+		auto it = ref.find( key );
+		if( it == ref.end() ){
+			ASSERT_TRUE( r.second );
+			ASSERT_EQ( r.first, ref.size() );
+			ref[key] = r.first;
+		} else {
+			ASSERT_FALSE( r.second );
+			ASSERT_EQ( r.first, it->second );
+		}
+	}
+	ASSERT_EQ( set.size(), ref.size() );
+	for( auto const & p : ref ){
+		ASSERT_EQ( set.find( p.first ), p.second );
+		ASSERT_EQ( set[p.second], p.first );
+	}
+	ASSERT_EQ( set.find( 50000 ), FlatIndexSet<uint64_t>::npos );
+	set.clear();
+	ASSERT_TRUE( set.empty() );
+	ASSERT_FALSE( set.contains( ref.begin()->first ) );
+	ASSERT_TRUE( set.insert( 7 ).second );
+}
+
+// keys differing only in the high bits must not pile into one probe chain
+TEST( FlatIndexSet, high_bit_keys ){
+	FlatIndexSet<uint64_t> set( 1000 );
+	for( uint64_t i = 0; i < 4096; ++i ) ASSERT_TRUE( set.insert( i << 40 ).second );
+	for( uint64_t i = 0; i < 4096; ++i ) ASSERT_EQ( set.find( i << 40 ), i );
+	ASSERT_NE( fmix64( 1ull << 40 ) & 0xffffffff, fmix64( 2ull << 40 ) & 0xffffffff );
+	ASSERT_NE( hash_combine64( 1, 2 ), hash_combine64( 2, 1 ) );
+}
+
+}
+}
+}
@@ -0,0 +1,135 @@
+#ifndef INCLUDED_scheme_util_FlatIndexSet_HH
+#define INCLUDED_scheme_util_FlatIndexSet_HH
+
+#include <scheme/util/assert.hh>
+
+#include <stdint.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace scheme {
+namespace util {
+
+/// @brief murmur3 fmix64, every input bit affects every output bit
+inline uint64_t fmix64( uint64_t k ){
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdllu;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53llu;
+	k ^= k >> 33;
+	return k;
+}
+
+/// @brief fold a full 64bit value into a running hash, order dependent
+inline uint64_t hash_combine64( uint64_t seed, uint64_t value ){
+	return fmix64( seed * 0x9e3779b97f4a7c15llu + value );
+}
+
+/// @brief open addressing set that gives every distinct key a dense index
+/// @detail keys live in insertion order in keys(), so the i'th new key gets
+///         index i and callers can keep parallel arrays instead of a map.
+///         the table is linear probed and holds 32bit indices plus a 32bit
+///         hash tag, so most probes never touch the keys. no erase.
+template< class Key, class Hash=std::hash<Key>, class Equal=std::equal_to<Key> >
+class FlatIndexSet {
+public:
+	static size_t const npos = std::numeric_limits<size_t>::max();
+
+	FlatIndexSet( size_t expected=0, Hash const & hash=Hash(), Equal const & equal=Equal() )
+	  : hash_(hash), equal_(equal), mask_(0) {
+		reserve( expected );
+	}
+
+	/// @brief index of key and whether it was new
+	std::pair<size_t,bool> insert( Key const & key ){
+		if( ( keys_.size() + 1 ) * 10 > slots_.size() * 7 ) grow();
+		uint64_t const h = fmix64( hash_( key ) );
+		uint32_t const tag = h >> 32;
+		for( size_t i = h & mask_; ; i = ( i + 1 ) & mask_ ){
+			Slot & s = slots_[i];
+			if( s.index == EMPTY ){
+				ALWAYS_ASSERT_MSG( keys_.size() < EMPTY, "FlatIndexSet: too many keys" );
+				s.index = keys_.size();
+				s.tag = tag;
+				keys_.push_back( key );
+				return std::make_pair( (size_t)s.index, true );
+			}
+			if( s.tag == tag && equal_( keys_[s.index], key ) ){
+				return std::make_pair( (size_t)s.index, false );
+			}
+		}
+	}
+
+	/// @brief index of key or npos
+	size_t find( Key const & key ) const {
+		if( keys_.empty() ) return npos;
+		uint64_t const h = fmix64( hash_( key ) );
+		uint32_t const tag = h >> 32;
+		for( size_t i = h & mask_; ; i = ( i + 1 ) & mask_ ){
+			Slot const & s = slots_[i];
+			if( s.index == EMPTY ) return npos;
+			if( s.tag == tag && equal_( keys_[s.index], key ) ) return s.index;
+		}
+	}
+
+	bool contains( Key const & key ) const { return find( key ) != npos; }
+
+	void reserve( size_t n ){
+		size_t cap = 16;
+		while( cap * 7 < n * 10 ) cap *= 2;
+		if( cap > slots_.size() ) rehash( cap );
+		keys_.reserve( n );
+	}
+
+	void clear(){
+		keys_.clear();
+		for( Slot & s : slots_ ) s.index = EMPTY;
+	}
+
+	size_t size() const { return keys_.size(); }
+	bool empty() const { return keys_.empty(); }
+	Key const & operator[]( size_t i ) const { return keys_[i]; }
+	std::vector<Key> const & keys() const { return keys_; }
+	size_t mem_use() const { return slots_.size()*sizeof(Slot) + keys_.capacity()*sizeof(Key); }
+
+private:
+	static uint32_t const EMPTY = std::numeric_limits<uint32_t>::max();
+
+	struct Slot {
+		uint32_t index, tag;
+		Slot() : index(EMPTY), tag(0) {}
+	};
+
+	void grow(){ rehash( std::max<size_t>( 16, slots_.size() * 2 ) ); }
+
+	void rehash( size_t cap ){
+		std::vector<Slot> slots( cap );
+		size_t const mask = cap - 1;
+		for( size_t k = 0; k < keys_.size(); ++k ){
+			uint64_t const h = fmix64( hash_( keys_[k] ) );
+			size_t i = h & mask;
+			while( slots[i].index != EMPTY ) i = ( i + 1 ) & mask;
+			slots[i].index = k;
+			slots[i].tag = h >> 32;
+		}
+		slots_.swap( slots );
+		mask_ = mask;
+	}
+
+	Hash hash_;
+	Equal equal_;
+	std::vector<Slot> slots_;
+	std::vector<Key> keys_;
+	size_t mask_;
+};
+
+template< class K, class H, class E > size_t const FlatIndexSet<K,H,E>::npos;
+template< class K, class H, class E > uint32_t const FlatIndexSet<K,H,E>::EMPTY;
+
+}
+}
+
+#endif
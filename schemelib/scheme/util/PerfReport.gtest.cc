@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "scheme/util/PerfReport.hh"
+
+#include <sstream>
+
+namespace scheme {
+namespace util {
+namespace perf_report_test {
+
+using std::cout;
+using std::endl;
+
+TEST( PerfReport, stages_accumulate ){
+	PerfReport report;
+	report.add_time( "score", 2, 1.0, 3.0, 4 );
+	report.add_time( "score", 2, 1.0, 3.0, 4 );
+	report.add_time( "score", 3, 0.5, 0.5, 4 );
+	report.add_count( "score", 2, "samples", 100 );
+	report.add_count( "score", 2, "samples", 50 );
+	ASSERT_EQ( report.stages().size(), 2 );
+	PerfReport::Stage const & s = report.stages()[0];
+	ASSERT_EQ( s.ncalls, 2 );
+	ASSERT_DOUBLE_EQ( s.wall_sec, 2.0 );
+	ASSERT_DOUBLE_EQ( s.thread_utilization(), 0.75 );
+	ASSERT_DOUBLE_EQ( s.counter("samples"), 150.0 );
+	ASSERT_DOUBLE_EQ( s.counter("nothere"), 0.0 );
+}
+
+TEST( PerfReport, scoped_timer_and_output ){
+	PerfReport report;
+	report.set_meta( "app", "test" );
+	{
+		PerfReport::ScopedTimer t( &report, "busy" );
+		volatile double x = 0;
+		for( int i = 0; i < 1000000; ++i ) x += i;
+	}
+	report.add_count( "busy", -1, "iters", 1000000 );
+	ASSERT_EQ( report.stages().size(), 1 );
+	ASSERT_GT( report.stages()[0].wall_sec, 0.0 );
+	ASSERT_GT( PerfReport::peak_rss_bytes(), 0 );
+
+	std::ostringstream json, csv;
+	report.write_json( json );
+	report.write_csv( csv );
+	ASSERT_NE( json.str().find( "\"busy\"" ), std::string::npos );
+	ASSERT_NE( json.str().find( "\"iters_per_sec\"" ), std::string::npos );
+	ASSERT_NE( csv.str().find( "busy,-1,1,1," ), std::string::npos );
+	ASSERT_NE( csv.str().find( "peak_rss_bytes" ), std::string::npos );
+}
+
+TEST( ThreadCounters, total ){
+	ThreadCounters counters( 4 );
+	for( int i = 0; i < 4; ++i ){
+		counters.add( i, 0, i );
+		counters.add( i, 1 );
+	}
+	ASSERT_EQ( counters.total(0), 6 );
+	ASSERT_EQ( counters.total(1), 4 );
+	counters.reset();
+	ASSERT_EQ( counters.total(0), 0 );
+}
+
+}
+}
+}
@@ -0,0 +1,222 @@
+#ifndef INCLUDED_scheme_util_PerfReport_HH
+#define INCLUDED_scheme_util_PerfReport_HH
+
+#include <stdint.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace scheme {
+namespace util {
+
+/// @brief per-thread event counters, one cache line per thread
+/// @detail cheap enough to bump from inner loops of parallel regions,
+///         each thread only ever writes its own slot
+class ThreadCounters {
+public:
+	static int const NSLOT = 8;
+
+	ThreadCounters( int nthread = 1 ) : slots_( nthread < 1 ? 1 : nthread ) {}
+
+	void resize( int nthread ){ slots_.assign( nthread < 1 ? 1 : nthread, Slot() ); }
+	void reset() { slots_.assign( slots_.size(), Slot() ); }
+	int nthread() const { return slots_.size(); }
+
+	void add( int ithread, int islot, int64_t n = 1 ){ slots_[ithread].count[islot] += n; }
+
+	int64_t total( int islot ) const {
+		int64_t tot = 0;
+		for( size_t i = 0; i < slots_.size(); ++i ) tot += slots_[i].count[islot];
+		return tot;
+	}
+
+private:
+	struct Slot {
+		Slot() { for( int i = 0; i < NSLOT; ++i ) count[i] = 0; }
+		int64_t count[NSLOT];
+	} __attribute__((aligned(64)));
+	std::vector<Slot> slots_;
+};
+
+/// @brief timings and counters for each stage of a run, dumped as json or csv
+/// @detail a stage is identified by name and (optionally) resolution. repeated
+///         records of the same stage (e.g. one per scaffold) are accumulated
+class PerfReport {
+public:
+
+	struct Stage {
+		Stage() : resl(-1), ncalls(0), nthreads(1), wall_sec(0), cpu_sec(0) {}
+		std::string name;
+		int resl;
+		int64_t ncalls;
+		int nthreads;
+		double wall_sec;
+		double cpu_sec;
+		std::vector< std::pair<std::string,double> > counters;
+
+		/// @brief fraction of available thread time actually spent on cpu
+		double thread_utilization() const {
+			return wall_sec > 0 ? cpu_sec / ( wall_sec * nthreads ) : 0.0;
+		}
+		double counter( std::string const & key ) const {
+			for( size_t i = 0; i < counters.size(); ++i ) if( counters[i].first == key ) return counters[i].second;
+			return 0.0;
+		}
+	};
+
+	static double wall_seconds(){
+		return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	}
+
+	/// @brief user+sys cpu time of the whole process
+	static double process_cpu_seconds(){
+		rusage ru;
+		getrusage( RUSAGE_SELF, &ru );
+		return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + 1e-6 * ( ru.ru_utime.tv_usec + ru.ru_stime.tv_usec );
+	}
+
+	static int64_t peak_rss_bytes(){
+		rusage ru;
+		getrusage( RUSAGE_SELF, &ru );
+		return (int64_t)ru.ru_maxrss * 1024; // linux reports kilobytes
+	}
+
+	/// @brief times a scope, adds to stage on destruction
+	class ScopedTimer {
+	public:
+		ScopedTimer( PerfReport * report, std::string const & name, int resl = -1, int nthreads = 1 )
+		  : report_(report), name_(name), resl_(resl), nthreads_(nthreads),
+		    wall0_( wall_seconds() ), cpu0_( process_cpu_seconds() ) {}
+		~ScopedTimer() {
+			if( report_ ) report_->add_time( name_, resl_, wall_seconds()-wall0_, process_cpu_seconds()-cpu0_, nthreads_ );
+		}
+	private:
+		PerfReport * report_;
+		std::string name_;
+		int resl_, nthreads_;
+		double wall0_, cpu0_;
+	};
+
+	PerfReport() : start_wall_( wall_seconds() ), start_cpu_( process_cpu_seconds() ) {}
+
+	Stage & stage( std::string const & name, int resl = -1 ){
+		for( size_t i = 0; i < stages_.size(); ++i ){
+			if( stages_[i].name == name && stages_[i].resl == resl ) return stages_[i];
+		}
+		stages_.push_back( Stage() );
+		stages_.back().name = name;
+		stages_.back().resl = resl;
+		return stages_.back();
+	}
+	std::vector<Stage> const & stages() const { return stages_; }
+
+	void add_time( std::string const & name, int resl, double wall, double cpu, int nthreads = 1 ){
+		Stage & s = stage( name, resl );
+		s.ncalls += 1;
+		s.wall_sec += wall;
+		s.cpu_sec += cpu;
+		s.nthreads = std::max( s.nthreads, nthreads );
+	}
+
+	void add_count( std::string const & name, int resl, std::string const & key, double n ){
+		Stage & s = stage( name, resl );
+		for( size_t i = 0; i < s.counters.size(); ++i ){
+			if( s.counters[i].first == key ){ s.counters[i].second += n; return; }
+		}
+		s.counters.push_back( std::make_pair( key, n ) );
+	}
+
+	template< class T >
+	void set_meta( std::string const & key, T const & val ){
+		std::ostringstream oss;
+		oss << val;
+		meta_[key] = oss.str();
+	}
+
+	void write_json( std::ostream & out ) const {
+		out << "{\n  \"meta\": {";
+		bool first = true;
+		for( auto const & kv : meta_ ){
+			out << ( first ? "\n" : ",\n" ) << "    " << quote(kv.first) << ": " << quote(kv.second);
+			first = false;
+		}
+		out << "\n  },\n";
+		out << "  \"total_wall_sec\": " << wall_seconds() - start_wall_ << ",\n";
+		out << "  \"total_cpu_sec\": " << process_cpu_seconds() - start_cpu_ << ",\n";
+		out << "  \"peak_rss_bytes\": " << peak_rss_bytes() << ",\n";
+		out << "  \"stages\": [";
+		for( size_t i = 0; i < stages_.size(); ++i ){
+			Stage const & s = stages_[i];
+			out << ( i ? ",\n" : "\n" ) << "    { \"name\": " << quote(s.name) << ", \"resl\": " << s.resl
+			    << ", \"ncalls\": " << s.ncalls << ", \"nthreads\": " << s.nthreads
+			    << ", \"wall_sec\": " << s.wall_sec << ", \"cpu_sec\": " << s.cpu_sec
+			    << ", \"thread_utilization\": " << s.thread_utilization() << ", \"counters\": {";
+			for( size_t j = 0; j < s.counters.size(); ++j ){
+				out << ( j ? ", " : " " ) << quote(s.counters[j].first) << ": " << s.counters[j].second;
+				if( s.wall_sec > 0 ) out << ", " << quote(s.counters[j].first+"_per_sec") << ": " << s.counters[j].second / s.wall_sec;
+			}
+			out << " } }";
+		}
+		out << "\n  ]\n}\n";
+	}
+
+	/// @brief one row per stage counter (or one row per stage if it has none)
+	void write_csv( std::ostream & out ) const {
+		out << "stage,resl,ncalls,nthreads,wall_sec,cpu_sec,thread_utilization,counter,value,per_sec\n";
+		for( size_t i = 0; i < stages_.size(); ++i ){
+			Stage const & s = stages_[i];
+			std::ostringstream prefix;
+			prefix << s.name << "," << s.resl << "," << s.ncalls << "," << s.nthreads << ","
+			       << s.wall_sec << "," << s.cpu_sec << "," << s.thread_utilization();
+			if( s.counters.empty() ) out << prefix.str() << ",,,\n";
+			for( size_t j = 0; j < s.counters.size(); ++j ){
+				out << prefix.str() << "," << s.counters[j].first << "," << s.counters[j].second << ","
+				    << ( s.wall_sec > 0 ? s.counters[j].second / s.wall_sec : 0.0 ) << "\n";
+			}
+		}
+		out << "total,-1,1,1," << wall_seconds() - start_wall_ << "," << process_cpu_seconds() - start_cpu_
+		    << ",,peak_rss_bytes," << peak_rss_bytes() << ",\n";
+	}
+
+	/// @brief csv if fname ends with .csv, otherwise json
+	bool write( std::string const & fname ) const {
+		std::ofstream out( fname.c_str() );
+		if( !out.good() ) return false;
+		out << std::setprecision(9);
+		if( fname.size() >= 4 && fname.substr( fname.size()-4 ) == ".csv" ) write_csv( out );
+		else write_json( out );
+		return out.good();
+	}
+
+private:
+
+	static std::string quote( std::string const & s ){
+		std::string r = "\"";
+		for( size_t i = 0; i < s.size(); ++i ){
+			char c = s[i];
+			if( c == '"' || c == '\\' ) { r += '\\'; r += c; }
+			else if( c == '\n' ) r += "\\n";
+			else if( c == '\t' ) r += "\\t";
+			else r += c;
+		}
+		return r + "\"";
+	}
+
+	std::vector<Stage> stages_;
+	std::map<std::string,std::string> meta_;
+	double start_wall_, start_cpu_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "scheme/util/SortedRuns.hh"
+
+#include <fstream>
+#include <map>
+#include <random>
+
+namespace scheme {
+namespace util {
+namespace sorted_runs_test {
+
+struct MinVal {
+	float score;
+	int32_t order;
+};
+
+// spilling a map in pieces then merging must give what one in memory map would
+TEST( SortedRuns, merge_matches_in_memory ){
+	std::mt19937_64 rng(0);
+	std::map<uint64_t,MinVal> ref;
+	SortedRuns<uint64_t,MinVal> runs( "/tmp/scheme_sorted_runs_test_", 7 );
+	int order = 0;
+	for( int irun = 0; irun < 6; ++irun ){
+		std::map<uint64_t,MinVal> batch;
+		for( int i = 0; i < 3000; ++i ){
+			uint64_t key = rng() % 5000;
+			MinVal v = { (float)( rng() % 1000 ), order++ };
+			if( !batch.count(key) || v.score < batch[key].score ) batch[key] = v;
+		}
+		std::vector< std::pair<uint64_t,MinVal> > records( batch.begin(), batch.end() );
+		std::shuffle( records.begin(), records.end(), rng );
+		for( auto const & r : records ){
+			if( !ref.count(r.first) || r.second.score < ref[r.first].score ) ref[r.first] = r.second;
+		}
+		runs.spill( records );
+		ASSERT_TRUE( records.empty() );
+	}
+	ASSERT_EQ( runs.num_runs(), 6u );
+	ASSERT_EQ( runs.count_unique_keys(), ref.size() );
+
+	std::vector< std::pair<uint64_t,MinVal> > merged;
+	int last_order = -1;
+	uint64_t last_key = 0;
+	runs.merge( [&]( uint64_t k, MinVal const & v ){
+		// equal keys arrive in the order they were spilled
+		if( k == last_key ){ ASSERT_GT( v.order, last_order ); }
+		last_key = k;
+		last_order = v.order;
+	});
+	runs.merge_reduce(
+		[]( MinVal & acc, MinVal const & v ){ if( v.score < acc.score ) acc = v; },
+		[&]( uint64_t k, MinVal const & v ){ merged.push_back( std::make_pair( k, v ) ); }
+	);
+	ASSERT_EQ( merged.size(), ref.size() );
+	auto it = ref.begin();
+	for( auto const & m : merged ){
+		ASSERT_EQ( m.first, it->first );
+		ASSERT_EQ( m.second.score, it->second.score );
+		++it;
+	}
+
+	std::vector<std::string> fnames = runs.fnames();
+	runs.clear();
+	ASSERT_EQ( runs.num_runs(), 0u );
+	for( std::string const & f : fnames ) ASSERT_FALSE( std::ifstream( f ).good() );
+}
+
+// rewriting values in place keeps the runs and their order, only values change
+TEST( SortedRuns, rewrite_values ){
+	SortedRuns<uint64_t,MinVal> runs( "/tmp/scheme_sorted_runs_test_rewrite_", 5 );
+	int order = 0;
+	for( int irun = 0; irun < 3; ++irun ){
+		std::vector< std::pair<uint64_t,MinVal> > records;
+		for( uint64_t k = irun; k < 40; k += 3 ){
+			MinVal v = { (float)k, order++ };
+			records.push_back( std::make_pair( k, v ) );
+		}
+		runs.spill( records );
+	}
+	uint64_t const nrecords = runs.num_records();
+	std::vector< std::pair<uint64_t,MinVal> > before, after;
+	runs.merge( [&]( uint64_t k, MinVal const & v ){ before.push_back( std::make_pair( k, v ) ); } );
+	runs.rewrite( []( MinVal & v ){ v.score = -v.score; } );
+	ASSERT_EQ( runs.num_runs(), 3u );
+	ASSERT_EQ( runs.num_records(), nrecords );
+	runs.merge( [&]( uint64_t k, MinVal const & v ){ after.push_back( std::make_pair( k, v ) ); } );
+	ASSERT_EQ( before.size(), after.size() );
+	for( size_t i = 0; i < before.size(); ++i ){
+		ASSERT_EQ( before[i].first, after[i].first );
+		ASSERT_EQ( before[i].second.order, after[i].second.order );
+		ASSERT_EQ( -before[i].second.score, after[i].second.score );
+	}
+}
+
+TEST( SortedRuns, empty ){
+	SortedRuns<uint64_t,float> runs( "/tmp/scheme_sorted_runs_test_empty_" );
+	std::vector< std::pair<uint64_t,float> > none;
+	runs.spill( none );
+	int n = 0;
+	runs.merge( [&n]( uint64_t, float ){ ++n; } );
+	ASSERT_EQ( n, 0 );
+	ASSERT_EQ( runs.count_unique_keys(), 0u );
+}
+
+}
+}
+}
@@ -0,0 +1,189 @@
+#ifndef INCLUDED_scheme_util_SortedRuns_HH
+#define INCLUDED_scheme_util_SortedRuns_HH
+
+#include <scheme/util/assert.hh>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace scheme {
+namespace util {
+
+/// @brief key sorted runs of (Key,Value) records in scratch files, for
+///        building maps bigger than memory
+/// @detail spill() sorts a batch by key and writes it as one run. merge()
+///         streams all runs back in key order, records with equal keys come
+///         in the order their runs were spilled so order dependent
+///         reductions replay the same way they would have in memory.
+///         Key and Value must be trivially copyable, they are written raw.
+///         files are removed by clear() and the destructor.
+template< class Key, class Value >
+class SortedRuns {
+public:
+	typedef std::pair<Key,Value> Record;
+
+	/// @brief run files are named prefix + run number
+	SortedRuns( std::string const & prefix, size_t read_buffer_records=1<<16 )
+	  : prefix_(prefix), read_buffer_records_(std::max<size_t>(1,read_buffer_records)), nrecords_(0) {}
+
+	~SortedRuns(){ clear(); }
+
+	SortedRuns( SortedRuns const & ) = delete;
+	SortedRuns & operator=( SortedRuns const & ) = delete;
+
+	/// @brief write records as a new run and empty the vector. keys should be
+	///        unique within one call, duplicates are kept in input order
+	void spill( std::vector<Record> & records ){
+		std::stable_sort( records.begin(), records.end(), key_less );
+		std::string const fname = prefix_ + std::to_string( fnames_.size() );
+		{
+			std::ofstream out( fname, std::ios::binary | std::ios::trunc );
+			ALWAYS_ASSERT_MSG( out, "SortedRuns: can't open " + fname );
+			uint64_t const n = records.size();
+			out.write( (char const*)&n, sizeof(n) );
+			for( Record const & r : records ){
+				out.write( (char const*)&r.first, sizeof(Key) );
+				out.write( (char const*)&r.second, sizeof(Value) );
+			}
+			ALWAYS_ASSERT_MSG( out, "SortedRuns: error writing " + fname );
+		}
+		fnames_.push_back( fname );
+		nrecords_ += records.size();
+		std::vector<Record>().swap( records );
+	}
+
+	size_t num_runs() const { return fnames_.size(); }
+	uint64_t num_records() const { return nrecords_; }
+	std::vector<std::string> const & fnames() const { return fnames_; }
+
+	/// @brief k-way merge, calls f( key, value ) for every record in (key,run) order
+	template< class F >
+	void merge( F f ) const {
+		std::vector< std::unique_ptr<Reader> > readers;
+		typedef std::pair<Key,size_t> Head;
+		std::priority_queue< Head, std::vector<Head>, std::greater<Head> > heap;
+		for( size_t i = 0; i < fnames_.size(); ++i ){
+			readers.emplace_back( new Reader( fnames_[i], read_buffer_records_ ) );
+			if( readers.back()->valid() ) heap.push( Head( readers.back()->current().first, i ) );
+		}
+		while( !heap.empty() ){
+			size_t const i = heap.top().second;
+			heap.pop();
+			Reader & r = *readers[i];
+			f( r.current().first, r.current().second );
+			if( r.next() ) heap.push( Head( r.current().first, i ) );
+		}
+	}
+
+	/// @brief k-way merge that folds records with equal keys, reduce( acc, value )
+	///        is applied in run order and emit( key, acc ) is called once per key
+	template< class Reduce, class Emit >
+	void merge_reduce( Reduce reduce, Emit emit ) const {
+		bool have = false;
+		Key key = Key();
+		Value acc = Value();
+		merge( [&]( Key const & k, Value const & v ){
+			if( have && k == key ){
+				reduce( acc, v );
+			} else {
+				if( have ) emit( key, acc );
+				key = k;
+				acc = v;
+				have = true;
+			}
+		});
+		if( have ) emit( key, acc );
+	}
+
+	/// @brief apply f( value ) to every record of every run in place, streaming
+	///        one run at a time. f must not change keys, so runs stay sorted
+	template< class F >
+	void rewrite( F f ){
+		for( std::string const & fname : fnames_ ){
+			std::string const tmpname = fname + ".rewrite";
+			{
+				Reader r( fname, read_buffer_records_ );
+				std::ofstream out( tmpname, std::ios::binary | std::ios::trunc );
+				ALWAYS_ASSERT_MSG( out, "SortedRuns: can't open " + tmpname );
+				uint64_t const n = r.left_ + r.buf_.size();
+				out.write( (char const*)&n, sizeof(n) );
+				for( bool more = r.valid(); more; more = r.next() ){
+					Record rec = r.current();
+					f( rec.second );
+					out.write( (char const*)&rec.first, sizeof(Key) );
+					out.write( (char const*)&rec.second, sizeof(Value) );
+				}
+				ALWAYS_ASSERT_MSG( out, "SortedRuns: error writing " + tmpname );
+			}
+			ALWAYS_ASSERT_MSG( std::rename( tmpname.c_str(), fname.c_str() ) == 0, "SortedRuns: can't replace " + fname );
+		}
+	}
+
+	/// @brief distinct keys over all runs, one streaming pass
+	uint64_t count_unique_keys() const {
+		uint64_t n = 0;
+		merge_reduce( []( Value &, Value const & ){}, [&n]( Key const &, Value const & ){ ++n; } );
+		return n;
+	}
+
+	void clear(){
+		for( std::string const & fname : fnames_ ) std::remove( fname.c_str() );
+		fnames_.clear();
+		nrecords_ = 0;
+	}
+
+private:
+
+	static bool key_less( Record const & a, Record const & b ){ return a.first < b.first; }
+
+	// buffered sequential reader for one run
+	struct Reader {
+		std::ifstream in_;
+		uint64_t left_;
+		std::vector<Record> buf_;
+		size_t pos_, bufsize_;
+		Reader( std::string const & fname, size_t bufsize ) : in_( fname, std::ios::binary ), left_(0), pos_(0), bufsize_(bufsize) {
+			ALWAYS_ASSERT_MSG( in_, "SortedRuns: can't open " + fname );
+			in_.read( (char*)&left_, sizeof(left_) );
+			ALWAYS_ASSERT_MSG( in_, "SortedRuns: truncated run " + fname );
+			fill();
+		}
+		bool valid() const { return pos_ < buf_.size(); }
+		Record const & current() const { return buf_[pos_]; }
+		bool next(){
+			if( ++pos_ < buf_.size() ) return true;
+			fill();
+			return valid();
+		}
+		void fill(){
+			buf_.clear();
+			pos_ = 0;
+			while( left_ > 0 && buf_.size() < bufsize_ ){
+				Record r;
+				in_.read( (char*)&r.first, sizeof(Key) );
+				in_.read( (char*)&r.second, sizeof(Value) );
+				ALWAYS_ASSERT_MSG( in_, "SortedRuns: truncated run" );
+				buf_.push_back( r );
+				--left_;
+			}
+		}
+	};
+
+	std::string prefix_;
+	size_t read_buffer_records_;
+	std::vector<std::string> fnames_;
+	uint64_t nrecords_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "scheme/util/WorkStealingQueues.hh"
+
+#include <thread>
+
+namespace scheme {
+namespace util {
+namespace work_stealing_test {
+
+TEST( WorkStealingQueues, each_item_once ){
+	int const N = 10000, NTHREAD = 4;
+	std::vector<int64_t> order;
+	for( int i = 0; i < N; ++i ) order.push_back( N-1-i );
+	WorkStealingQueues queues( order, NTHREAD );
+	std::vector< std::atomic<int> > count( N );
+	for( auto & c : count ) c = 0;
+	std::vector<std::thread> threads;
+	for( int t = 0; t < NTHREAD; ++t ){
+		threads.emplace_back( [&,t]{
+			int64_t item;
+			while( queues.pop( t, item ) ) ++count[item];
+		});
+	}
+	for( auto & t : threads ) t.join();
+	for( int i = 0; i < N; ++i ) ASSERT_EQ( count[i], 1 );
+}
+
+TEST( WorkStealingQueues, owner_order_and_stealing ){
+	std::vector<int64_t> order = { 0, 1, 2, 3, 4, 5 };
+	WorkStealingQueues queues( order, 2 ); // t0: 0 2 4, t1: 1 3 5
+	int64_t item;
+	ASSERT_TRUE( queues.pop( 0, item ) ); ASSERT_EQ( item, 0 );
+	ASSERT_TRUE( queues.pop( 0, item ) ); ASSERT_EQ( item, 2 );
+	ASSERT_TRUE( queues.pop( 0, item ) ); ASSERT_EQ( item, 4 );
+	// own queue empty, steal from the back of t1
+	ASSERT_TRUE( queues.pop( 0, item ) ); ASSERT_EQ( item, 5 );
+	ASSERT_EQ( queues.nstolen(), 1 );
+	ASSERT_TRUE( queues.pop( 1, item ) ); ASSERT_EQ( item, 1 );
+	ASSERT_TRUE( queues.pop( 1, item ) ); ASSERT_EQ( item, 3 );
+	ASSERT_FALSE( queues.pop( 1, item ) );
+	ASSERT_FALSE( queues.pop( 0, item ) );
+}
+
+TEST( WorkStealingQueues, stop ){
+	std::vector<int64_t> order = { 0, 1, 2, 3 };
+	WorkStealingQueues queues( order, 1 );
+	int64_t item;
+	ASSERT_TRUE( queues.pop( 0, item ) );
+	queues.stop();
+	ASSERT_TRUE( queues.stopped() );
+	ASSERT_FALSE( queues.pop( 0, item ) );
+}
+
+}
+}
+}
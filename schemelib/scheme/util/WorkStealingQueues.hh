@@ -0,0 +1,76 @@
+#ifndef INCLUDED_scheme_util_WorkStealingQueues_HH
+#define INCLUDED_scheme_util_WorkStealingQueues_HH
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace scheme {
+namespace util {
+
+/// @brief per-thread work queues with stealing, for loops whose items differ a lot in cost
+/// @detail items are dealt round robin in the given order, so if order is sorted by
+///         decreasing expected cost every thread starts on its most expensive work.
+///         a thread takes from the front of its own queue; once that is empty it
+///         steals from the back (the cheapest end) of the next non-empty queue.
+///         stop() makes every later pop fail, for early termination
+class WorkStealingQueues {
+public:
+
+	WorkStealingQueues( std::vector<int64_t> const & order, int nthreads )
+	  : queues_( nthreads < 1 ? 1 : nthreads ), stop_(false), nstolen_(0)
+	{
+		for( size_t i = 0; i < order.size(); ++i ){
+			queues_[ i % queues_.size() ].items.push_back( order[i] );
+		}
+	}
+
+	/// @brief next item for ithread, false when everything is done or stopped
+	bool pop( int ithread, int64_t & item ){
+		if( stop_ ) return false;
+		int const n = queues_.size();
+		ithread = ithread % n;
+		{
+			Queue & q( queues_[ithread] );
+			std::lock_guard<std::mutex> lock( q.mutex );
+			if( !q.items.empty() ){
+				item = q.items.front();
+				q.items.pop_front();
+				return true;
+			}
+		}
+		for( int i = 1; i < n; ++i ){
+			Queue & q( queues_[ (ithread+i) % n ] );
+			std::lock_guard<std::mutex> lock( q.mutex );
+			if( !q.items.empty() ){
+				item = q.items.back();
+				q.items.pop_back();
+				++nstolen_;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void stop() { stop_ = true; }
+	bool stopped() const { return stop_; }
+	int64_t nstolen() const { return nstolen_; }
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<int64_t> items;
+	} __attribute__((aligned(64)));
+
+	std::vector<Queue> queues_;
+	std::atomic<bool> stop_;
+	std::atomic<int64_t> nstolen_;
+};
+
+}
+}
+
+#endif